@@ -0,0 +1,73 @@
+#ifndef CDS_BENCH_H
+#define CDS_BENCH_H
+
+#define _GNU_SOURCE
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/*
+ *********************************************************************************************************
+ *
+ *                                              BENCH NOW
+ *
+ * Description: Returns a monotonic timestamp in seconds.
+ *
+ * Arguments: none
+ *
+ * Returns: The current value of CLOCK_MONOTONIC in seconds.
+ *
+ * Notes: none
+ *********************************************************************************************************
+ */
+static inline double bench_now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double) ts.tv_sec + (double) ts.tv_nsec * 1e-9;
+}
+
+/*
+ *********************************************************************************************************
+ *
+ *                                              BENCH RAND
+ *
+ * Description: Advances a xorshift64 generator and returns its next value.
+ *
+ * Arguments: state   A pointer to the non-zero generator state.
+ *
+ * Returns: A pseudo-random 64-bit value.
+ *
+ * Notes: Deterministic across runs so that results are comparable.
+ *********************************************************************************************************
+ */
+static inline uint64_t bench_rand(uint64_t *state) {
+  uint64_t x = *state;
+  x ^= x << 13;
+  x ^= x >> 7;
+  x ^= x << 17;
+  return *state = x;
+}
+
+/*
+ *********************************************************************************************************
+ *
+ *                                            BENCH ARG SIZE
+ *
+ * Description: Parses a positional size argument.
+ *
+ * Arguments: argc, argv   The arguments of main.
+ *            index        The position of the argument.
+ *            fallback     The value used when the argument is absent.
+ *
+ * Returns: The parsed value, or fallback.
+ *
+ * Notes: none
+ *********************************************************************************************************
+ */
+static inline size_t bench_arg_size(int argc, char **argv, int index, size_t fallback) {
+  return argc > index ? (size_t) strtoull(argv[index], NULL, 10) : fallback;
+}
+
+#endif
@@ -0,0 +1,85 @@
+#include "bench.h"
+
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#include <cds/allocator.h>
+#include <cds/array.h>
+
+// Usage: bench_array_tlb.exe [elements] [lookups]
+//
+// Fills a cds_array of uint64_t and sums random cds_array_get lookups, once with the default
+// allocator and once with 64-byte aligned huge-page backing. dTLB load misses are read from
+// perf_event_open when the kernel allows it.
+
+static int open_dtlb_counter(void) {
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HW_CACHE;
+  attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+  attr.disabled = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  return (int) syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+static void run(const char *label, const struct cds_allocator *allocator, size_t elements,
+                size_t lookups) {
+  struct cds_array array = cds_array_new_with_allocator(sizeof(uint64_t), allocator);
+  if (cds_array_reserve(&array, elements) != 0) {
+    fprintf(stderr, "%s: allocation of %zu elements failed\n", label, elements);
+    return;
+  }
+  for (uint64_t i = 0; i < elements; ++i) {
+    cds_array_push_back(&array, &i);
+  }
+
+  const int counter = open_dtlb_counter();
+  uint64_t state = 88172645463325252ULL, sum = 0;
+  if (counter >= 0) {
+    ioctl(counter, PERF_EVENT_IOC_RESET, 0);
+    ioctl(counter, PERF_EVENT_IOC_ENABLE, 0);
+  }
+  const double start = bench_now();
+  for (size_t i = 0; i < lookups; ++i) {
+    sum += *(uint64_t*) cds_array_get(&array, bench_rand(&state) % elements);
+  }
+  const double elapsed = bench_now() - start;
+  long long misses = -1;
+  if (counter >= 0) {
+    ioctl(counter, PERF_EVENT_IOC_DISABLE, 0);
+    if (read(counter, &misses, sizeof(misses)) != sizeof(misses)) {
+      misses = -1;
+    }
+    close(counter);
+  }
+
+  printf("%-22s %8.2f ns/lookup", label, elapsed * 1e9 / (double) lookups);
+  if (misses >= 0) {
+    printf("  %8.3f dTLB misses/lookup", (double) misses / (double) lookups);
+  } else {
+    printf("  dTLB counter unavailable");
+  }
+  printf("  (checksum %llu)\n", (unsigned long long) sum);
+  cds_array_delete(&array);
+}
+
+int main(int argc, char **argv) {
+  const size_t elements = bench_arg_size(argc, argv, 1, (size_t) 1 << 27);  // 1 GiB of uint64_t
+  const size_t lookups = bench_arg_size(argc, argv, 2, (size_t) 1 << 24);
+  printf("random cds_array_get: %zu elements (%zu MiB), %zu lookups\n", elements,
+         elements * sizeof(uint64_t) >> 20, lookups);
+
+  struct cds_aligned_allocator aligned, huge;
+  cds_aligned_allocator_init(&aligned, 64, 0);
+  cds_aligned_allocator_init(&huge, 64, CDS_ALLOCATOR_HUGE_PAGES | CDS_ALLOCATOR_HUGETLB);
+  run("malloc", &cds_default_allocator, elements, lookups);
+  run("aligned 64", &aligned.allocator, elements, lookups);
+  run("aligned 64 + 2M pages", &huge.allocator, elements, lookups);
+  return 0;
+}
@@ -0,0 +1,81 @@
+#include "bench.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <cds/sort.h>
+
+// Usage: bench_external_sort.exe [megabytes] [budget_megabytes] [tmp_dir]
+//
+// Writes a file of random 16-byte records (a 64-bit key and a payload) to tmp_dir, sorts it with
+// cds_external_sort under the given memory budget and checks the output in one streaming pass.
+// Pass a file several times larger than RAM, e.g. 8192 megabytes, to exercise the merge on disk.
+
+struct record {
+  uint64_t key;
+  uint64_t payload;
+};
+
+static int cmp_record(const void *a, const void *b) {
+  uint64_t x = ((const struct record*) a)->key, y = ((const struct record*) b)->key;
+  return (x > y) - (x < y);
+}
+
+int main(int argc, char **argv) {
+  const size_t megabytes = bench_arg_size(argc, argv, 1, (size_t) 256);
+  const size_t budget = bench_arg_size(argc, argv, 2, (size_t) 32) << 20;
+  const char *tmp_dir = argc > 3 ? argv[3] : "/tmp";
+  const size_t records = (megabytes << 20) / sizeof(struct record);
+  const size_t block = 1 << 16;
+
+  char in_path[4096], out_path[4096];
+  snprintf(in_path, sizeof(in_path), "%s/bench_external_sort.in", tmp_dir);
+  snprintf(out_path, sizeof(out_path), "%s/bench_external_sort.out", tmp_dir);
+  struct record *buf = malloc(block * sizeof(struct record));
+  if (!buf) return 1;
+
+  FILE *file = fopen(in_path, "wb");
+  if (!file) return 1;
+  uint64_t state = 0x9E3779B97F4A7C15ULL;
+  for (size_t done = 0; done < records; done += block) {
+    const size_t n = records - done < block ? records - done : block;
+    for (size_t i = 0; i < n; ++i) {
+      buf[i].key = bench_rand(&state);
+      buf[i].payload = done + i;
+    }
+    fwrite(buf, sizeof(struct record), n, file);
+  }
+  fclose(file);
+
+  printf("sorting %zu MiB (%zu records) with a %zu MiB budget in %s\n", megabytes, records,
+         budget >> 20, tmp_dir);
+  const double start = bench_now();
+  const int result = cds_external_sort_with_tmp_dir(in_path, out_path, sizeof(struct record), cmp_record,
+                                                    budget, tmp_dir);
+  const double elapsed = bench_now() - start;
+  if (result != 0) {
+    fprintf(stderr, "cds_external_sort failed\n");
+    return 1;
+  }
+
+  file = fopen(out_path, "rb");
+  if (!file) return 1;
+  size_t total = 0, n;
+  uint64_t previous = 0;
+  bool sorted = true;
+  while ((n = fread(buf, sizeof(struct record), block, file)) > 0) {
+    for (size_t i = 0; i < n; ++i) {
+      sorted &= buf[i].key >= previous;
+      previous = buf[i].key;
+    }
+    total += n;
+  }
+  fclose(file);
+  remove(in_path);
+  remove(out_path);
+  free(buf);
+
+  printf("%-20s %8.3f s %8.1f MiB/s %s\n", "cds_external_sort", elapsed, megabytes / elapsed,
+         sorted && total == records ? "ok" : "NOT SORTED");
+  return sorted && total == records ? 0 : 1;
+}
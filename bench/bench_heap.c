@@ -0,0 +1,118 @@
+#include "bench.h"
+
+#include <string.h>
+
+#include <cds/heap.h>
+
+// Usage: bench_heap.exe [elements] [operations]
+//
+// Times cds_heap with 2, 4 and 8 children per node on 8-byte keys and 32-byte records keyed by their
+// first 8 bytes: pushing `elements` random keys, the hold model (pop the top, push a later key) for
+// `operations` steps at that size, then popping everything. Then compares building the same heap from
+// an array with cds_heap_from_array against pushing the elements one by one, and draining it with
+// cds_heap_pop_n against copying the top and popping each element.
+
+struct record {
+  uint64_t key;
+  uint64_t payload[3];
+};
+
+static int cmp_key(const void *a, const void *b) {
+  const uint64_t x = *(const uint64_t*) a, y = *(const uint64_t*) b;
+  return (x > y) - (x < y);
+}
+
+static void run(size_t element_size, size_t arity, size_t n, size_t operations) {
+  struct cds_heap heap = cds_heap_new_dary(element_size, cmp_key, arity);
+  struct record element = {0};
+  uint64_t state = 0x9E3779B97F4A7C15ULL, checksum = 0;
+
+  double start = bench_now();
+  for (size_t i = 0; i < n; ++i) {
+    element.key = bench_rand(&state) >> 20;
+    cds_heap_push(&heap, &element);
+  }
+  const double push = bench_now() - start;
+
+  start = bench_now();
+  for (size_t i = 0; i < operations; ++i) {
+    memcpy(&element, cds_heap_top(&heap), element_size);
+    checksum += element.key;
+    cds_heap_pop(&heap);
+    element.key += bench_rand(&state) >> 24;
+    cds_heap_push(&heap, &element);
+  }
+  const double hold = bench_now() - start;
+
+  start = bench_now();
+  while (!cds_heap_empty(&heap)) {
+    checksum += *(const uint64_t*) cds_heap_top(&heap);
+    cds_heap_pop(&heap);
+  }
+  const double pop = bench_now() - start;
+
+  printf("  %2zu-byte elements, arity %zu   push %6.1f   hold %6.1f   pop %6.1f ns/op  (checksum %llu)\n",
+         element_size, arity, push * 1e9 / n, hold * 1e9 / operations, pop * 1e9 / n,
+         (unsigned long long) checksum);
+  cds_heap_delete(&heap);
+}
+
+static void run_bulk(size_t element_size, size_t arity, size_t n) {
+  struct cds_array array = cds_array_new(element_size);
+  struct record element = {0};
+  uint64_t state = 0x9E3779B97F4A7C15ULL, checksum = 0;
+  for (size_t i = 0; i < n; ++i) {
+    element.key = bench_rand(&state) >> 20;
+    cds_array_push_back(&array, &element);
+  }
+  char *out = malloc(n * element_size);
+
+  struct cds_heap heap = cds_heap_new_dary(element_size, cmp_key, arity);
+  double start = bench_now();
+  for (size_t i = 0; i < n; ++i) {
+    cds_heap_push(&heap, array.data + i * element_size);
+  }
+  const double push = bench_now() - start;
+  start = bench_now();
+  for (size_t i = 0; i < n; ++i) {
+    memcpy(out + i * element_size, cds_heap_top(&heap), element_size);
+    cds_heap_pop(&heap);
+  }
+  const double pop = bench_now() - start;
+  checksum += *(const uint64_t*) (out + (n / 2) * element_size);
+  cds_heap_delete(&heap);
+
+  start = bench_now();
+  heap = cds_heap_from_array(&array, cmp_key, arity);
+  const double build = bench_now() - start;
+  start = bench_now();
+  cds_heap_pop_n(&heap, out, n);
+  const double pop_n = bench_now() - start;
+  checksum += *(const uint64_t*) (out + (n / 2) * element_size);
+  cds_heap_delete(&heap);
+
+  printf("  %2zu-byte elements, arity %zu   push %6.1f   from_array %6.1f   pop %6.1f   pop_n %6.1f"
+         " ns/element  (checksum %llu)\n", element_size, arity, push * 1e9 / n, build * 1e9 / n, pop * 1e9 / n,
+         pop_n * 1e9 / n, (unsigned long long) checksum);
+  free(out);
+}
+
+int main(int argc, char **argv) {
+  const size_t n = bench_arg_size(argc, argv, 1, (size_t) 1000000);
+  const size_t operations = bench_arg_size(argc, argv, 2, (size_t) 1000000);
+  printf("%zu elements, %zu hold operations\n", n, operations);
+  const size_t sizes[] = {sizeof(uint64_t), sizeof(struct record)};
+  const size_t arities[] = {2, 4, 8};
+  for (size_t s = 0; s < 2; ++s) {
+    for (size_t a = 0; a < 3; ++a) {
+      run(sizes[s], arities[a], n, operations);
+    }
+  }
+  printf("bulk construction and removal of %zu elements\n", n);
+  for (size_t s = 0; s < 2; ++s) {
+    for (size_t a = 0; a < 3; ++a) {
+      run_bulk(sizes[s], arities[a], n);
+    }
+  }
+  return 0;
+}
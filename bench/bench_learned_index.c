@@ -0,0 +1,128 @@
+#include "bench.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <cds/array.h>
+#include <cds/learned_index.h>
+#include <cds/search_layout.h>
+#include <cds/sort.h>
+
+// Usage: bench_learned_index.exe [elements] [lookups]
+//
+// Looks up keys of a sorted array of uint64_t with cds_array_search_binary, the B-tree search layout
+// and cds_learned_index at several error bounds, on key sets shaped like real data: uniform ids,
+// lognormal sizes, timestamps arriving in bursts and coordinates clustered around a few thousand
+// places. The memory column is the size of each structure besides the sorted array.
+
+enum distribution { UNIFORM, LOGNORMAL, TIMESTAMPS, CLUSTERED };
+
+static const char *distribution_names[] = {"uniform", "lognormal", "timestamps", "clustered"};
+
+static double uniform01(uint64_t *state) {
+  return ((double) (bench_rand(state) >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+static double normal(uint64_t *state) {
+  return sqrt(-2.0 * log(uniform01(state))) * cos(6.283185307179586 * uniform01(state));
+}
+
+// Keys stay below 2^63 so that cds_cmp_i64 orders them like uint64_t.
+static void generate(uint64_t *keys, size_t n, enum distribution distribution, uint64_t *state) {
+  const size_t clusters = 4096;
+  uint64_t time = 1600000000000000ULL;
+  for (size_t i = 0; i < n; ++i) {
+    switch (distribution) {
+      case UNIFORM:
+        keys[i] = bench_rand(state) >> 1;
+        break;
+      case LOGNORMAL:
+        keys[i] = (uint64_t) (exp(2.0 * normal(state)) * 1e9);
+        break;
+      case TIMESTAMPS:
+        // Microsecond timestamps: mostly a few events per millisecond, with quiet periods and bursts.
+        time += bench_rand(state) % 64 == 0 ? bench_rand(state) % 10000000 : bench_rand(state) % 500;
+        keys[i] = time;
+        break;
+      case CLUSTERED: {
+        uint64_t center = (bench_rand(state) % clusters) * 0x9E3779B97F4A7C15ULL;
+        center = (center ^ (center >> 29)) >> 2;
+        keys[i] = center + (uint64_t) fabs(normal(state) * 1e6);
+        break;
+      }
+    }
+  }
+}
+
+static void report(const char *name, double elapsed, size_t lookups, size_t memory, size_t checksum) {
+  printf("  %-28s %8.1f ns/lookup %12zu bytes  (checksum %zu)\n", name, elapsed * 1e9 / lookups, memory,
+         checksum);
+}
+
+int main(int argc, char **argv) {
+  const size_t n = bench_arg_size(argc, argv, 1, (size_t) 10000000);
+  const size_t lookups = bench_arg_size(argc, argv, 2, (size_t) 2000000);
+  printf("%zu lookups of present keys in %zu sorted uint64_t\n", lookups, n);
+
+  struct cds_array sorted = cds_array_new(sizeof(uint64_t));
+  uint64_t *queries = malloc(lookups * sizeof(uint64_t));
+  if (!queries || cds_array_resize(&sorted, n) != 0) return 1;
+  uint64_t *keys = (uint64_t*) sorted.data;
+  uint64_t state = 0x9E3779B97F4A7C15ULL;
+
+  for (int d = UNIFORM; d <= CLUSTERED; ++d) {
+    generate(keys, n, d, &state);
+    cds_array_sort_radix(&sorted, 0, sizeof(uint64_t), CDS_SORT_RADIX_UNSIGNED);
+    for (size_t i = 0; i < lookups; ++i) {
+      queries[i] = keys[bench_rand(&state) % n];
+    }
+    printf("%s\n", distribution_names[d]);
+
+    size_t checksum = 0;
+    double start = bench_now();
+    for (size_t i = 0; i < lookups; ++i) {
+      checksum += (size_t) ((const uint64_t*) cds_array_search_binary(&sorted, &queries[i], cds_cmp_i64)
+                            - keys);
+    }
+    report("cds_array_search_binary", bench_now() - start, lookups, 0, checksum);
+
+    struct cds_search_layout layout = cds_search_layout_new(&sorted, CDS_SEARCH_LAYOUT_BTREE, cds_cmp_i64);
+    if (layout.data) {
+      checksum = 0;
+      start = bench_now();
+      for (size_t i = 0; i < lookups; ++i) {
+        checksum += cds_search_layout_lower_bound(&layout, &queries[i]);
+      }
+      report("btree layout", bench_now() - start, lookups, layout.block_size, checksum);
+      cds_search_layout_delete(&layout);
+    }
+
+    const size_t epsilons[] = {16, 64, 256};
+    for (size_t e = 0; e < sizeof(epsilons) / sizeof(epsilons[0]); ++e) {
+      const double build_start = bench_now();
+      struct cds_learned_index index = cds_learned_index_new(&sorted, epsilons[e]);
+      const double build = bench_now() - build_start;
+      if (!index.segments) {
+        fprintf(stderr, "cds_learned_index_new failed\n");
+        return 1;
+      }
+      checksum = 0;
+      start = bench_now();
+      for (size_t i = 0; i < lookups; ++i) {
+        checksum += (size_t) (cds_learned_index_lookup(&index, queries[i]) - keys);
+      }
+      char name[64];
+      snprintf(name, sizeof(name), "learned index, eps %zu", epsilons[e]);
+      report(name, bench_now() - start, lookups, index.segment_count * sizeof(struct cds_learned_segment),
+             checksum);
+      printf("  %-28s %zu segments in %zu levels, built in %.3f s\n", "", index.segment_count, index.levels,
+             build);
+      cds_learned_index_delete(&index);
+    }
+  }
+
+  cds_array_delete(&sorted);
+  free(queries);
+  return 0;
+}
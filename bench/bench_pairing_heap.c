@@ -0,0 +1,101 @@
+#include "bench.h"
+
+#include <cds/heap.h>
+#include <cds/pairing_heap.h>
+
+// Usage: bench_pairing_heap.exe [elements] [shards]
+//
+// Fills `shards` heaps with `elements` random 8-byte keys in total, merges them into the first one and
+// drains it, with cds_pairing_heap (cds_pairing_heap_meld) and with a 4-ary cds_heap (popping each
+// shard and pushing its elements into the first).
+
+static int cmp_key(const void *a, const void *b) {
+  const uint64_t x = *(const uint64_t*) a, y = *(const uint64_t*) b;
+  return (x > y) - (x < y);
+}
+
+static void run_heap(size_t n, size_t shard_count) {
+  struct cds_heap *shards = malloc(shard_count * sizeof(struct cds_heap));
+  uint64_t state = 0x9E3779B97F4A7C15ULL, checksum = 0;
+
+  double start = bench_now();
+  for (size_t s = 0; s < shard_count; ++s) {
+    shards[s] = cds_heap_new_dary(sizeof(uint64_t), cmp_key, 4);
+    for (size_t i = s; i < n; i += shard_count) {
+      const uint64_t key = bench_rand(&state);
+      cds_heap_push(&shards[s], &key);
+    }
+  }
+  const double fill = bench_now() - start;
+
+  start = bench_now();
+  for (size_t s = 1; s < shard_count; ++s) {
+    while (!cds_heap_empty(&shards[s])) {
+      cds_heap_push(&shards[0], cds_heap_top(&shards[s]));
+      cds_heap_pop(&shards[s]);
+    }
+  }
+  const double merge = bench_now() - start;
+
+  start = bench_now();
+  while (!cds_heap_empty(&shards[0])) {
+    checksum += *(const uint64_t*) cds_heap_top(&shards[0]) >> 32;
+    cds_heap_pop(&shards[0]);
+  }
+  const double drain = bench_now() - start;
+
+  printf("  cds_heap (4-ary)   push %6.1f ns   merge %9.3f ms   pop %6.1f ns  (checksum %llu)\n",
+         fill * 1e9 / n, merge * 1e3, drain * 1e9 / n, (unsigned long long) checksum);
+  for (size_t s = 0; s < shard_count; ++s) {
+    cds_heap_delete(&shards[s]);
+  }
+  free(shards);
+}
+
+static void run_pairing_heap(size_t n, size_t shard_count) {
+  struct cds_pairing_heap *shards = malloc(shard_count * sizeof(struct cds_pairing_heap));
+  uint64_t state = 0x9E3779B97F4A7C15ULL, checksum = 0;
+
+  double start = bench_now();
+  for (size_t s = 0; s < shard_count; ++s) {
+    shards[s] = cds_pairing_heap_new(sizeof(uint64_t), cmp_key);
+    for (size_t i = s; i < n; i += shard_count) {
+      const uint64_t key = bench_rand(&state);
+      cds_pairing_heap_push(&shards[s], &key);
+    }
+  }
+  const double fill = bench_now() - start;
+
+  start = bench_now();
+  for (size_t s = 1; s < shard_count; ++s) {
+    cds_pairing_heap_meld(&shards[0], &shards[s]);
+  }
+  const double merge = bench_now() - start;
+
+  start = bench_now();
+  while (!cds_pairing_heap_empty(&shards[0])) {
+    checksum += *(const uint64_t*) cds_pairing_heap_top(&shards[0]) >> 32;
+    cds_pairing_heap_pop(&shards[0]);
+  }
+  const double drain = bench_now() - start;
+
+  printf("  cds_pairing_heap   push %6.1f ns   merge %9.3f ms   pop %6.1f ns  (checksum %llu)\n",
+         fill * 1e9 / n, merge * 1e3, drain * 1e9 / n, (unsigned long long) checksum);
+  for (size_t s = 0; s < shard_count; ++s) {
+    cds_pairing_heap_delete(&shards[s]);
+  }
+  free(shards);
+}
+
+int main(int argc, char **argv) {
+  const size_t n = bench_arg_size(argc, argv, 1, (size_t) 1000000);
+  const size_t shard_count = bench_arg_size(argc, argv, 2, (size_t) 16);
+  if (shard_count == 0) {
+    fprintf(stderr, "shards must be positive\n");
+    return 1;
+  }
+  printf("%zu elements in %zu shards\n", n, shard_count);
+  run_heap(n, shard_count);
+  run_pairing_heap(n, shard_count);
+  return 0;
+}
@@ -0,0 +1,92 @@
+#include "bench.h"
+
+#include <string.h>
+
+#include <cds/heap.h>
+#include <cds/radix_heap.h>
+
+// Usage: bench_radix_heap.exe [elements] [operations]
+//
+// Times cds_radix_heap against a 4-ary cds_heap on the monotone hold model: `elements` events with
+// random times are pushed, then for `operations` steps the earliest is popped and rescheduled a random
+// delay later, and finally all are popped. Events are 8-byte times and 32-byte records.
+
+struct event {
+  uint64_t time;
+  uint64_t payload[3];
+};
+
+static uint64_t event_key(const void *element) {
+  return *(const uint64_t*) element;
+}
+
+static int event_cmp(const void *a, const void *b) {
+  const uint64_t x = *(const uint64_t*) a, y = *(const uint64_t*) b;
+  return (x > y) - (x < y);
+}
+
+static void run_heap(size_t element_size, size_t n, size_t operations) {
+  struct cds_heap heap = cds_heap_new_dary(element_size, event_cmp, 4);
+  struct event event = {0};
+  uint64_t state = 0x9E3779B97F4A7C15ULL, checksum = 0;
+
+  double start = bench_now();
+  for (size_t i = 0; i < n; ++i) {
+    event.time = bench_rand(&state) >> 40;
+    cds_heap_push(&heap, &event);
+  }
+  for (size_t i = 0; i < operations; ++i) {
+    memcpy(&event, cds_heap_top(&heap), element_size);
+    checksum += event.time;
+    cds_heap_pop(&heap);
+    event.time += bench_rand(&state) >> 40;
+    cds_heap_push(&heap, &event);
+  }
+  while (!cds_heap_empty(&heap)) {
+    checksum += *(const uint64_t*) cds_heap_top(&heap);
+    cds_heap_pop(&heap);
+  }
+  const double elapsed = bench_now() - start;
+  printf("  %2zu-byte events   cds_heap (4-ary)  %6.1f ns/op  (checksum %llu)\n", element_size,
+         elapsed * 1e9 / (2 * n + 2 * operations), (unsigned long long) checksum);
+  cds_heap_delete(&heap);
+}
+
+static void run_radix_heap(size_t element_size, size_t n, size_t operations) {
+  struct cds_radix_heap heap = cds_radix_heap_new(element_size, event_key);
+  struct event event = {0};
+  uint64_t state = 0x9E3779B97F4A7C15ULL, checksum = 0;
+
+  double start = bench_now();
+  for (size_t i = 0; i < n; ++i) {
+    event.time = bench_rand(&state) >> 40;
+    cds_radix_heap_push(&heap, &event);
+  }
+  for (size_t i = 0; i < operations; ++i) {
+    memcpy(&event, cds_radix_heap_top(&heap), element_size);
+    checksum += event.time;
+    cds_radix_heap_pop(&heap);
+    event.time += bench_rand(&state) >> 40;
+    cds_radix_heap_push(&heap, &event);
+  }
+  while (!cds_radix_heap_empty(&heap)) {
+    checksum += *(const uint64_t*) cds_radix_heap_top(&heap);
+    cds_radix_heap_pop(&heap);
+  }
+  const double elapsed = bench_now() - start;
+  printf("  %2zu-byte events   cds_radix_heap    %6.1f ns/op  (checksum %llu)\n", element_size,
+         elapsed * 1e9 / (2 * n + 2 * operations), (unsigned long long) checksum);
+  cds_radix_heap_delete(&heap);
+}
+
+int main(int argc, char **argv) {
+  const size_t n = bench_arg_size(argc, argv, 1, (size_t) 1000000);
+  const size_t operations = bench_arg_size(argc, argv, 2, (size_t) 1000000);
+  printf("%zu events, %zu hold operations, time per push or pop\n", n, operations);
+  const size_t sizes[] = {sizeof(uint64_t), sizeof(struct event)};
+  for (size_t s = 0; s < 2; ++s) {
+    run_heap(sizes[s], n, operations);
+    run_radix_heap(sizes[s], n, operations);
+  }
+  return 0;
+}
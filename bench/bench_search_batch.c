@@ -0,0 +1,64 @@
+#include "bench.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <cds/array.h>
+#include <cds/sort.h>
+
+// Usage: bench_search_batch.exe [elements] [lookups]
+//
+// Looks up random keys in a sorted array of int32_t one at a time with cds_array_search_binary and
+// all at once with cds_array_search_binary_batch, through a user comparator and through cds_cmp_i32.
+
+static int cmp_i32(const void *a, const void *b) {
+  int32_t x = *(const int32_t*) a, y = *(const int32_t*) b;
+  return (x > y) - (x < y);
+}
+
+static void report(const char *name, double elapsed, size_t lookups, size_t found) {
+  printf("%-36s %8.3f s %8.1f ns/lookup  (found %zu)\n", name, elapsed, elapsed * 1e9 / lookups, found);
+}
+
+int main(int argc, char **argv) {
+  const size_t n = bench_arg_size(argc, argv, 1, (size_t) 10000000);
+  const size_t lookups = bench_arg_size(argc, argv, 2, (size_t) 2000000);
+  printf("%zu lookups in %zu sorted int32_t\n", lookups, n);
+
+  struct cds_array sorted = cds_array_new(sizeof(int32_t));
+  int32_t *keys = malloc(lookups * sizeof(int32_t));
+  void **results = malloc(lookups * sizeof(void*));
+  if (!keys || !results || cds_array_resize(&sorted, n) != 0) return 1;
+  uint64_t state = 0x9E3779B97F4A7C15ULL;
+  for (size_t i = 0; i < n; ++i) {
+    ((int32_t*) sorted.data)[i] = (int32_t) (i * 3);
+  }
+  for (size_t i = 0; i < lookups; ++i) {
+    keys[i] = (int32_t) (bench_rand(&state) % (n * 3));
+  }
+
+  cds_cmp_func cmps[] = {cmp_i32, cds_cmp_i32};
+  const char *names[][2] = {{"cds_array_search_binary (user cmp)", "batch (user cmp)"},
+                            {"cds_array_search_binary (cds_cmp_i32)", "batch (cds_cmp_i32)"}};
+  for (size_t c = 0; c < 2; ++c) {
+    size_t found = 0;
+    double start = bench_now();
+    for (size_t i = 0; i < lookups; ++i) {
+      found += cds_array_search_binary(&sorted, &keys[i], cmps[c]) != NULL;
+    }
+    report(names[c][0], bench_now() - start, lookups, found);
+
+    found = 0;
+    start = bench_now();
+    cds_array_search_binary_batch(&sorted, keys, lookups, results, cmps[c]);
+    for (size_t i = 0; i < lookups; ++i) {
+      found += results[i] != NULL;
+    }
+    report(names[c][1], bench_now() - start, lookups, found);
+  }
+
+  cds_array_delete(&sorted);
+  free(results);
+  free(keys);
+  return 0;
+}
@@ -0,0 +1,89 @@
+#include "bench.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <cds/array.h>
+#include <cds/sort.h>
+
+// Usage: bench_search_bounds.exe [elements] [lookups]
+//
+// Searches uniformly distributed uint64_t keys with cds_array_lower_bound and
+// cds_array_search_interpolation, then walks the array with ascending keys using
+// cds_array_lower_bound and cds_array_search_exponential from the previous result.
+
+static int cmp_u64(const void *a, const void *b) {
+  uint64_t x = *(const uint64_t*) a, y = *(const uint64_t*) b;
+  return (x > y) - (x < y);
+}
+
+static size_t compares;
+
+static int cmp_u64_counted(const void *a, const void *b) {
+  compares++;
+  return cmp_u64(a, b);
+}
+
+static void report(const char *name, double elapsed, size_t lookups, size_t checksum) {
+  printf("%-34s %8.3f s %8.1f ns/lookup  (checksum %zu)\n", name, elapsed, elapsed * 1e9 / lookups, checksum);
+}
+
+int main(int argc, char **argv) {
+  const size_t n = bench_arg_size(argc, argv, 1, (size_t) 10000000);
+  const size_t lookups = bench_arg_size(argc, argv, 2, (size_t) 2000000);
+  printf("%zu lookups in %zu sorted uniform uint64_t\n", lookups, n);
+
+  struct cds_array sorted = cds_array_new(sizeof(uint64_t));
+  uint64_t *keys = malloc(lookups * sizeof(uint64_t));
+  if (!keys || cds_array_resize(&sorted, n) != 0) return 1;
+  uint64_t state = 0x9E3779B97F4A7C15ULL;
+  for (size_t i = 0; i < n; ++i) {
+    ((uint64_t*) sorted.data)[i] = bench_rand(&state);
+  }
+  cds_array_sort(&sorted, cmp_u64);
+  for (size_t i = 0; i < lookups; ++i) {
+    keys[i] = bench_rand(&state);
+  }
+
+  size_t checksum = 0;
+  double start = bench_now();
+  for (size_t i = 0; i < lookups; ++i) {
+    checksum += cds_array_lower_bound(&sorted, &keys[i], cmp_u64);
+  }
+  report("cds_array_lower_bound", bench_now() - start, lookups, checksum);
+
+  checksum = 0;
+  start = bench_now();
+  for (size_t i = 0; i < lookups; ++i) {
+    checksum += cds_array_search_interpolation(&sorted, 0, sizeof(uint64_t), CDS_SORT_RADIX_UNSIGNED, &keys[i]);
+  }
+  report("cds_array_search_interpolation", bench_now() - start, lookups, checksum);
+
+  // Ascending keys, as in a merge join or a range scan driven by another sorted input.
+  struct cds_array ascending = {(char*) keys, lookups, lookups, sizeof(uint64_t), NULL};
+  cds_array_sort(&ascending, cmp_u64);
+
+  checksum = 0;
+  compares = 0;
+  start = bench_now();
+  for (size_t i = 0; i < lookups; ++i) {
+    checksum += cds_array_lower_bound(&sorted, &keys[i], cmp_u64_counted);
+  }
+  report("cds_array_lower_bound (ascending)", bench_now() - start, lookups, checksum);
+  printf("%-34s %8.1f compares/lookup\n", "", (double) compares / lookups);
+
+  checksum = 0;
+  compares = 0;
+  size_t cursor = 0;
+  start = bench_now();
+  for (size_t i = 0; i < lookups; ++i) {
+    cursor = cds_array_search_exponential(&sorted, cursor, &keys[i], cmp_u64_counted);
+    checksum += cursor;
+  }
+  report("cds_array_search_exponential", bench_now() - start, lookups, checksum);
+  printf("%-34s %8.1f compares/lookup\n", "", (double) compares / lookups);
+
+  cds_array_delete(&sorted);
+  free(keys);
+  return 0;
+}
@@ -0,0 +1,79 @@
+#include "bench.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <cds/array.h>
+#include <cds/search_layout.h>
+#include <cds/sort.h>
+
+// Usage: bench_search_layout.exe [elements] [lookups]
+//
+// Looks up random keys in a sorted array of int32_t with cds_array_search_binary and in the Eytzinger
+// and B-tree layouts, with the comparison inlined (cds_cmp_i32) and through a user comparator.
+
+static int cmp_i32(const void *a, const void *b) {
+  int32_t x = *(const int32_t*) a, y = *(const int32_t*) b;
+  return (x > y) - (x < y);
+}
+
+static void run_layout(const char *name, const struct cds_array *sorted, enum cds_search_layout_type type,
+                       cds_cmp_func cmp, const struct cds_allocator *allocator, const int32_t *keys,
+                       size_t lookups) {
+  struct cds_search_layout layout = cds_search_layout_new_with_allocator(sorted, type, cmp, allocator);
+  if (!layout.data) {
+    fprintf(stderr, "%s: allocation failed\n", name);
+    return;
+  }
+  size_t checksum = 0;
+  const double start = bench_now();
+  for (size_t i = 0; i < lookups; ++i) {
+    checksum += cds_search_layout_lower_bound(&layout, &keys[i]);
+  }
+  const double elapsed = bench_now() - start;
+  printf("%-34s %8.3f s %8.1f ns/lookup  (checksum %zu)\n", name, elapsed, elapsed * 1e9 / lookups,
+         checksum);
+  cds_search_layout_delete(&layout);
+}
+
+int main(int argc, char **argv) {
+  const size_t n = bench_arg_size(argc, argv, 1, (size_t) 10000000);
+  const size_t lookups = bench_arg_size(argc, argv, 2, (size_t) 2000000);
+  printf("%zu lookups in %zu sorted int32_t\n", lookups, n);
+
+  struct cds_array sorted = cds_array_new(sizeof(int32_t));
+  int32_t *keys = malloc(lookups * sizeof(int32_t));
+  if (!keys || cds_array_resize(&sorted, n) != 0) return 1;
+  uint64_t state = 0x9E3779B97F4A7C15ULL;
+  for (size_t i = 0; i < n; ++i) {
+    ((int32_t*) sorted.data)[i] = (int32_t) (i * 3);
+  }
+  for (size_t i = 0; i < lookups; ++i) {
+    keys[i] = (int32_t) (bench_rand(&state) % (n * 3));
+  }
+
+  size_t found = 0;
+  double start = bench_now();
+  for (size_t i = 0; i < lookups; ++i) {
+    found += cds_array_search_binary(&sorted, &keys[i], cds_cmp_i32) != NULL;
+  }
+  double elapsed = bench_now() - start;
+  printf("%-34s %8.3f s %8.1f ns/lookup  (found %zu)\n", "cds_array_search_binary", elapsed,
+         elapsed * 1e9 / lookups, found);
+
+  struct cds_aligned_allocator huge;
+  cds_aligned_allocator_init(&huge, 64, CDS_ALLOCATOR_HUGE_PAGES);
+  run_layout("eytzinger (user cmp)", &sorted, CDS_SEARCH_LAYOUT_EYTZINGER, cmp_i32, NULL, keys, lookups);
+  run_layout("btree (user cmp)", &sorted, CDS_SEARCH_LAYOUT_BTREE, cmp_i32, NULL, keys, lookups);
+  run_layout("eytzinger (cds_cmp_i32)", &sorted, CDS_SEARCH_LAYOUT_EYTZINGER, cds_cmp_i32, NULL, keys,
+             lookups);
+  run_layout("btree (cds_cmp_i32)", &sorted, CDS_SEARCH_LAYOUT_BTREE, cds_cmp_i32, NULL, keys, lookups);
+  run_layout("eytzinger (cds_cmp_i32, huge pages)", &sorted, CDS_SEARCH_LAYOUT_EYTZINGER, cds_cmp_i32,
+             &huge.allocator, keys, lookups);
+  run_layout("btree (cds_cmp_i32, huge pages)", &sorted, CDS_SEARCH_LAYOUT_BTREE, cds_cmp_i32,
+             &huge.allocator, keys, lookups);
+
+  cds_array_delete(&sorted);
+  free(keys);
+  return 0;
+}
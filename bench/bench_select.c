@@ -0,0 +1,57 @@
+#include "bench.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <cds/array.h>
+#include <cds/sort.h>
+
+// Usage: bench_select.exe [elements] [k]
+//
+// Finds the median and the k largest of random int32_t keys with a full cds_array_sort and with the
+// selection functions.
+
+static int cmp_i32(const void *a, const void *b) {
+  int32_t x = *(const int32_t*) a, y = *(const int32_t*) b;
+  return (x > y) - (x < y);
+}
+
+int main(int argc, char **argv) {
+  const size_t n = bench_arg_size(argc, argv, 1, (size_t) 10000000);
+  const size_t k = bench_arg_size(argc, argv, 2, (size_t) 100);
+  printf("selecting from %zu int32_t, k = %zu\n", n, k);
+
+  int32_t *input = malloc(n * sizeof(int32_t));
+  struct cds_array work = cds_array_new(sizeof(int32_t));
+  struct cds_array top = cds_array_new(sizeof(int32_t));
+  if (!input || cds_array_resize(&work, n) != 0) return 1;
+  uint64_t state = 0x9E3779B97F4A7C15ULL;
+  for (size_t i = 0; i < n; ++i) {
+    input[i] = (int32_t) bench_rand(&state);
+  }
+
+  memcpy(work.data, input, n * sizeof(int32_t));
+  double start = bench_now();
+  cds_array_sort(&work, cmp_i32);
+  printf("%-28s %8.3f s\n", "cds_array_sort", bench_now() - start);
+
+  memcpy(work.data, input, n * sizeof(int32_t));
+  start = bench_now();
+  cds_array_nth_element(&work, n / 2, cmp_i32);
+  printf("%-28s %8.3f s\n", "cds_array_nth_element (n/2)", bench_now() - start);
+
+  memcpy(work.data, input, n * sizeof(int32_t));
+  start = bench_now();
+  cds_array_partial_sort(&work, k, cmp_i32);
+  printf("%-28s %8.3f s\n", "cds_array_partial_sort (k)", bench_now() - start);
+
+  memcpy(work.data, input, n * sizeof(int32_t));
+  start = bench_now();
+  cds_array_top_k(&work, k, cmp_i32, &top);
+  printf("%-28s %8.3f s\n", "cds_array_top_k (k)", bench_now() - start);
+
+  cds_array_delete(&top);
+  cds_array_delete(&work);
+  free(input);
+  return 0;
+}
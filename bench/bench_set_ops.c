@@ -0,0 +1,122 @@
+#include "bench.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <cds/array.h>
+#include <cds/sort.h>
+
+// Usage: bench_set_ops.exe [elements] [rounds]
+//
+// Intersects, unites, merges and subtracts sorted lists of uint32_t and uint64_t ids: two lists of
+// about `elements` ids each drawn from twice as many, and a list of elements / 1000 ids against one of
+// 10 * elements ids. Compares a hand-written scalar loop with the cds_array_set_*
+// functions through a user comparator (generic path) and through cds_cmp_u32 / cds_cmp_u64.
+
+typedef int (*set_op_func)(const struct cds_array *, const struct cds_array *, cds_cmp_func, struct cds_array *);
+
+static int cmp_u32(const void *a, const void *b) {
+  uint32_t x = *(const uint32_t*) a, y = *(const uint32_t*) b;
+  return (x > y) - (x < y);
+}
+
+static int cmp_u64(const void *a, const void *b) {
+  uint64_t x = *(const uint64_t*) a, y = *(const uint64_t*) b;
+  return (x > y) - (x < y);
+}
+
+// Each id below `universe` is taken with probability about n / universe, so the list is sorted.
+static void fill_ids(struct cds_array *ids, size_t n, size_t universe, uint64_t *state) {
+  cds_array_resize(ids, 0);
+  const uint64_t threshold = (uint64_t) ((double) n / (double) universe * (double) UINT64_MAX);
+  for (uint64_t id = 0; id < universe; ++id) {
+    if (bench_rand(state) <= threshold) {
+      if (ids->element_size == sizeof(uint32_t)) {
+        const uint32_t value = (uint32_t) id;
+        cds_array_push_back(ids, &value);
+      } else {
+        const uint64_t value = id * 0x100000001ULL;
+        cds_array_push_back(ids, &value);
+      }
+    }
+  }
+}
+
+static size_t scalar_intersect_u32(const struct cds_array *a, const struct cds_array *b, struct cds_array *out) {
+  const uint32_t *x = (const uint32_t*) a->data, *y = (const uint32_t*) b->data;
+  cds_array_resize(out, a->size);
+  uint32_t *o = (uint32_t*) out->data;
+  size_t i = 0, j = 0, k = 0;
+  while (i < a->size && j < b->size) {
+    if (x[i] < y[j]) {
+      i++;
+    } else if (y[j] < x[i]) {
+      j++;
+    } else {
+      o[k++] = x[i++];
+      j++;
+    }
+  }
+  out->size = k;
+  return k;
+}
+
+static void run(const char *name, set_op_func op, const struct cds_array *a, const struct cds_array *b,
+                cds_cmp_func cmp, struct cds_array *out, size_t rounds) {
+  const double start = bench_now();
+  for (size_t r = 0; r < rounds; ++r) {
+    op(a, b, cmp, out);
+  }
+  const double elapsed = (bench_now() - start) / rounds;
+  printf("  %-34s %9.3f ms %7.2f ns/input element  (%zu results)\n", name, elapsed * 1e3,
+         elapsed * 1e9 / (a->size + b->size), out->size);
+}
+
+static void run_all(const char *title, const struct cds_array *a, const struct cds_array *b,
+                    cds_cmp_func generic, cds_cmp_func typed, struct cds_array *out, size_t rounds) {
+  static const char *names[] = {"merge", "union", "intersect", "difference"};
+  const set_op_func ops[] = {cds_array_set_merge, cds_array_set_union, cds_array_set_intersect,
+                             cds_array_set_difference};
+  printf("%s: %zu and %zu ids\n", title, a->size, b->size);
+  if (a->element_size == sizeof(uint32_t)) {
+    const double start = bench_now();
+    for (size_t r = 0; r < rounds; ++r) {
+      scalar_intersect_u32(a, b, out);
+    }
+    const double elapsed = (bench_now() - start) / rounds;
+    printf("  %-34s %9.3f ms %7.2f ns/input element  (%zu results)\n", "hand-written intersect loop",
+           elapsed * 1e3, elapsed * 1e9 / (a->size + b->size), out->size);
+  }
+  for (int i = 0; i < 4; ++i) {
+    char name[64];
+    snprintf(name, sizeof(name), "%s (user cmp)", names[i]);
+    run(name, ops[i], a, b, generic, out, rounds);
+    snprintf(name, sizeof(name), "%s (%s)", names[i], typed == cds_cmp_u32 ? "cds_cmp_u32" : "cds_cmp_u64");
+    run(name, ops[i], a, b, typed, out, rounds);
+  }
+}
+
+int main(int argc, char **argv) {
+  const size_t n = bench_arg_size(argc, argv, 1, (size_t) 1000000);
+  const size_t rounds = bench_arg_size(argc, argv, 2, (size_t) 10);
+  uint64_t state = 0x9E3779B97F4A7C15ULL;
+
+  for (int wide = 0; wide <= 1; ++wide) {
+    const size_t es = wide ? sizeof(uint64_t) : sizeof(uint32_t);
+    struct cds_array a = cds_array_new(es), b = cds_array_new(es), out = cds_array_new(es);
+    cds_cmp_func generic = wide ? cmp_u64 : cmp_u32, typed = wide ? cds_cmp_u64 : cds_cmp_u32;
+
+    fill_ids(&a, n, 2 * n, &state);
+    fill_ids(&b, n, 2 * n, &state);
+    run_all(wide ? "uint64_t, similar sizes" : "uint32_t, similar sizes", &a, &b, generic, typed, &out, rounds);
+
+    fill_ids(&a, n / 1000, 20 * n, &state);
+    fill_ids(&b, 10 * n, 20 * n, &state);
+    run_all(wide ? "uint64_t, skewed sizes" : "uint32_t, skewed sizes", &a, &b, generic, typed, &out, rounds);
+
+    cds_array_delete(&a);
+    cds_array_delete(&b);
+    cds_array_delete(&out);
+  }
+  return 0;
+}
@@ -0,0 +1,94 @@
+#include "bench.h"
+
+#include <string.h>
+#include <unistd.h>
+
+#include <cds/array.h>
+#include <cds/sort.h>
+
+// Usage: bench_sort.exe [elements] [max_threads]
+//
+// Times the cds_array sorting engines on uint32_t keys. cds_array_sort_parallel is run with
+// 1, 2, 4, ... threads up to max_threads (default: online processors).
+
+static int cmp_u32(const void *a, const void *b) {
+  uint32_t x = *(const uint32_t*) a, y = *(const uint32_t*) b;
+  return (x > y) - (x < y);
+}
+
+enum distribution { RANDOM, SORTED, REVERSED, ORGAN_PIPE, FEW_UNIQUE, NEARLY_SORTED };
+
+static const char *distribution_names[] = {
+  "random", "sorted", "reversed", "organ-pipe", "few-unique", "nearly-sorted"};
+
+// NEARLY_SORTED is append-mostly data: a sorted prefix followed by 1% random keys.
+static struct cds_array make_distribution(size_t n, enum distribution kind) {
+  struct cds_array array = cds_array_new(sizeof(uint32_t));
+  cds_array_reserve(&array, n);
+  uint64_t state = 0x9E3779B97F4A7C15ULL;
+  for (size_t i = 0; i < n; ++i) {
+    uint32_t value;
+    switch (kind) {
+      case SORTED: value = (uint32_t) i; break;
+      case REVERSED: value = (uint32_t) (n - i); break;
+      case ORGAN_PIPE: value = (uint32_t) (i < n / 2 ? i : n - i); break;
+      case FEW_UNIQUE: value = (uint32_t) (bench_rand(&state) % 16); break;
+      case NEARLY_SORTED: value = i < n - n / 100 ? (uint32_t) (i * 4) : (uint32_t) bench_rand(&state); break;
+      default: value = (uint32_t) bench_rand(&state); break;
+    }
+    cds_array_push_back(&array, &value);
+  }
+  return array;
+}
+
+int main(int argc, char **argv) {
+  const size_t n = bench_arg_size(argc, argv, 1, (size_t) 10000000);
+  const long online = sysconf(_SC_NPROCESSORS_ONLN);
+  const size_t max_threads = bench_arg_size(argc, argv, 2, online > 0 ? (size_t) online : 1);
+  printf("sorting %zu random uint32_t\n", n);
+
+  struct cds_array array = make_distribution(n, RANDOM);
+  double start = bench_now();
+  cds_array_sort(&array, cmp_u32);
+  printf("%-24s %8.3f s\n", "cds_array_sort", bench_now() - start);
+  cds_array_delete(&array);
+
+  array = make_distribution(n, RANDOM);
+  start = bench_now();
+  cds_array_sort_radix(&array, 0, sizeof(uint32_t), CDS_SORT_RADIX_UNSIGNED);
+  printf("%-24s %8.3f s\n", "cds_array_sort_radix", bench_now() - start);
+  cds_array_delete(&array);
+
+  array = make_distribution(n, RANDOM);
+  start = bench_now();
+  cds_array_sort_stable(&array, cmp_u32);
+  printf("%-24s %8.3f s\n", "cds_array_sort_stable", bench_now() - start);
+  cds_array_delete(&array);
+
+  for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+    array = make_distribution(n, RANDOM);
+    start = bench_now();
+    cds_array_sort_parallel(&array, cmp_u32, threads);
+    char label[32];
+    snprintf(label, sizeof(label), "sort_parallel x%zu", threads);
+    printf("%-24s %8.3f s\n", label, bench_now() - start);
+    cds_array_delete(&array);
+  }
+
+  printf("\n%-16s %16s %24s\n", "distribution", "cds_array_sort", "cds_array_sort_stable");
+  for (enum distribution kind = RANDOM; kind <= NEARLY_SORTED; kind++) {
+    array = make_distribution(n, kind);
+    start = bench_now();
+    cds_array_sort(&array, cmp_u32);
+    double unstable = bench_now() - start;
+    cds_array_delete(&array);
+
+    array = make_distribution(n, kind);
+    start = bench_now();
+    cds_array_sort_stable(&array, cmp_u32);
+    double stable = bench_now() - start;
+    cds_array_delete(&array);
+    printf("%-16s %14.3f s %22.3f s\n", distribution_names[kind], unstable, stable);
+  }
+  return 0;
+}
@@ -0,0 +1,95 @@
+#include "bench.h"
+
+#include <string.h>
+
+#include <cds/array.h>
+#include <cds/sort.h>
+
+// Usage: bench_sort_by_key.exe [elements]
+//
+// Sorts 200-byte records by a uint64_t field with cds_array_sort and cds_array_sort_stable through a
+// comparator, with cds_array_sort_radix on the field in place, and with cds_array_sort_by_key, which
+// sorts (key, index) pairs and moves each record once. cds_array_argsort only computes the order.
+
+struct record {
+  uint64_t id;
+  char payload[192];
+};
+
+static int cmp_record(const void *a, const void *b) {
+  const uint64_t x = ((const struct record*) a)->id, y = ((const struct record*) b)->id;
+  return (x > y) - (x < y);
+}
+
+static uint64_t key_record(const void *element) {
+  return ((const struct record*) element)->id;
+}
+
+static void fill(struct cds_array *records, size_t n, uint64_t mask) {
+  uint64_t state = 0x9E3779B97F4A7C15ULL;
+  cds_array_resize(records, n);
+  for (size_t i = 0; i < n; ++i) {
+    struct record *r = (struct record*) records->data + i;
+    r->id = bench_rand(&state) & mask;
+    memset(r->payload, (int) i, sizeof(r->payload));
+  }
+}
+
+static void check(const struct cds_array *records, const char *name) {
+  const struct record *r = (const struct record*) records->data;
+  for (size_t i = 1; i < records->size; ++i) {
+    if (r[i - 1].id > r[i].id) {
+      fprintf(stderr, "%s: not sorted at %zu\n", name, i);
+      exit(1);
+    }
+  }
+}
+
+static void report(const char *name, double elapsed, size_t n) {
+  printf("  %-30s %9.1f ms %8.1f ns/element\n", name, elapsed * 1e3, elapsed * 1e9 / n);
+}
+
+int main(int argc, char **argv) {
+  const size_t n = bench_arg_size(argc, argv, 1, (size_t) 1000000);
+  struct cds_array records = cds_array_new(sizeof(struct record));
+  struct cds_array permutation = cds_array_new(sizeof(size_t));
+  const uint64_t masks[] = {UINT64_MAX, 0xFFFFFFFF};
+  const char *mask_names[] = {"64-bit random ids", "32-bit random ids"};
+
+  for (size_t m = 0; m < 2; ++m) {
+    printf("%zu records of %zu bytes, %s\n", n, sizeof(struct record), mask_names[m]);
+
+    fill(&records, n, masks[m]);
+    double start = bench_now();
+    cds_array_sort(&records, cmp_record);
+    report("cds_array_sort", bench_now() - start, n);
+    check(&records, "cds_array_sort");
+
+    fill(&records, n, masks[m]);
+    start = bench_now();
+    cds_array_sort_stable(&records, cmp_record);
+    report("cds_array_sort_stable", bench_now() - start, n);
+    check(&records, "cds_array_sort_stable");
+
+    fill(&records, n, masks[m]);
+    start = bench_now();
+    cds_array_sort_radix(&records, offsetof(struct record, id), sizeof(uint64_t), CDS_SORT_RADIX_UNSIGNED);
+    report("cds_array_sort_radix", bench_now() - start, n);
+    check(&records, "cds_array_sort_radix");
+
+    fill(&records, n, masks[m]);
+    start = bench_now();
+    cds_array_sort_by_key(&records, key_record);
+    report("cds_array_sort_by_key", bench_now() - start, n);
+    check(&records, "cds_array_sort_by_key");
+
+    fill(&records, n, masks[m]);
+    start = bench_now();
+    cds_array_argsort(&records, key_record, &permutation);
+    report("cds_array_argsort", bench_now() - start, n);
+  }
+
+  cds_array_delete(&records);
+  cds_array_delete(&permutation);
+  return 0;
+}
@@ -0,0 +1,74 @@
+#include "bench.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <cds/array.h>
+#include <cds/sort.h>
+
+// Usage: bench_sort_small.exe [batches] [batch_size]
+//
+// Sorts many tiny int32_t batches, as produced by bucketing or per-request work, with the sorting
+// networks, with cds_array_sort (whose base case is the network for cds_cmp_i32 and insertion sort
+// for any other comparator) and with qsort.
+
+static int cmp_i32(const void *a, const void *b) {
+  int32_t x = *(const int32_t*) a, y = *(const int32_t*) b;
+  return (x > y) - (x < y);
+}
+
+int main(int argc, char **argv) {
+  const size_t batches = bench_arg_size(argc, argv, 1, (size_t) 2000000);
+  const size_t batch_size = bench_arg_size(argc, argv, 2, (size_t) CDS_SORT_SMALL_MAX);
+  if (batch_size > CDS_SORT_SMALL_MAX) {
+    fprintf(stderr, "batch_size must be at most %d\n", CDS_SORT_SMALL_MAX);
+    return 1;
+  }
+  printf("sorting %zu batches of %zu int32_t\n", batches, batch_size);
+
+  int32_t *input = malloc(batches * batch_size * sizeof(int32_t));
+  int32_t *work = malloc(batches * batch_size * sizeof(int32_t));
+  if (!input || !work) return 1;
+  uint64_t state = 0x9E3779B97F4A7C15ULL;
+  for (size_t i = 0; i < batches * batch_size; ++i) {
+    input[i] = (int32_t) bench_rand(&state);
+  }
+
+  memcpy(work, input, batches * batch_size * sizeof(int32_t));
+  double start = bench_now();
+  for (size_t b = 0; b < batches; ++b) {
+    cds_sort_small_i32(work + b * batch_size, batch_size);
+  }
+  double elapsed = bench_now() - start;
+  printf("%-26s %8.3f s %8.1f ns/batch\n", "cds_sort_small_i32", elapsed, elapsed * 1e9 / batches);
+
+  memcpy(work, input, batches * batch_size * sizeof(int32_t));
+  start = bench_now();
+  for (size_t b = 0; b < batches; ++b) {
+    struct cds_array view = {(char*) (work + b * batch_size), batch_size, batch_size, sizeof(int32_t), NULL};
+    cds_array_sort(&view, cds_cmp_i32);
+  }
+  elapsed = bench_now() - start;
+  printf("%-26s %8.3f s %8.1f ns/batch\n", "cds_array_sort", elapsed, elapsed * 1e9 / batches);
+
+  memcpy(work, input, batches * batch_size * sizeof(int32_t));
+  start = bench_now();
+  for (size_t b = 0; b < batches; ++b) {
+    struct cds_array view = {(char*) (work + b * batch_size), batch_size, batch_size, sizeof(int32_t), NULL};
+    cds_array_sort(&view, cmp_i32);
+  }
+  elapsed = bench_now() - start;
+  printf("%-26s %8.3f s %8.1f ns/batch\n", "cds_array_sort (user cmp)", elapsed, elapsed * 1e9 / batches);
+
+  memcpy(work, input, batches * batch_size * sizeof(int32_t));
+  start = bench_now();
+  for (size_t b = 0; b < batches; ++b) {
+    qsort(work + b * batch_size, batch_size, sizeof(int32_t), cds_cmp_i32);
+  }
+  elapsed = bench_now() - start;
+  printf("%-26s %8.3f s %8.1f ns/batch\n", "qsort", elapsed, elapsed * 1e9 / batches);
+
+  free(input);
+  free(work);
+  return 0;
+}
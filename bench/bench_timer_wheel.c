@@ -0,0 +1,123 @@
+#include "bench.h"
+
+#include <cds/heap.h>
+#include <cds/timer_wheel.h>
+
+// Usage: bench_timer_wheel.exe [timers] [milliseconds]
+//
+// Simulates connection timeouts: `timers` timers due 1 to 10 s ahead are armed, then time advances in
+// 1 ms steps for `milliseconds` steps. In each step 0.1% of the connections see traffic, which cancels
+// and re-arms their timer, and expired timers are re-armed. Times are in nanoseconds. The wheel is
+// compared with a 4-ary cds_heap of deadlines, which cannot remove an entry, so a canceled timer is
+// marked stale in a side table and skipped when it reaches the top.
+
+#define MS 1000000ULL
+
+struct heap_timer {
+  uint64_t deadline;
+  uint32_t connection, generation;
+};
+
+struct expiry_context {
+  struct cds_timer_wheel *wheel;
+  cds_timer_id *ids;
+  uint64_t now, state;
+};
+
+static int cmp_deadline(const void *a, const void *b) {
+  const uint64_t x = *(const uint64_t*) a, y = *(const uint64_t*) b;
+  return (x > y) - (x < y);
+}
+
+static uint64_t timeout(uint64_t *state) {
+  return 1000 * MS + bench_rand(state) % (9000 * MS);
+}
+
+static void rearm_expired(const struct cds_timer *timer, void *context) {
+  struct expiry_context *expiry = context;
+  const size_t connection = (size_t) (uintptr_t) timer->data;
+  expiry->ids[connection] = cds_timer_wheel_arm(expiry->wheel, expiry->now + timeout(&expiry->state),
+                                                timer->data);
+}
+
+static void run_wheel(size_t n, size_t steps) {
+  cds_timer_id *ids = malloc(n * sizeof(cds_timer_id));
+  struct cds_timer_wheel wheel = cds_timer_wheel_new(MS, 0);
+  struct expiry_context expiry = {&wheel, ids, 0, 0x9E3779B97F4A7C15ULL};
+  size_t fired = 0;
+
+  double start = bench_now();
+  for (size_t c = 0; c < n; ++c) {
+    ids[c] = cds_timer_wheel_arm(&wheel, timeout(&expiry.state), (void*) (uintptr_t) c);
+  }
+  const double arm = bench_now() - start;
+
+  start = bench_now();
+  for (size_t step = 1; step <= steps; ++step) {
+    expiry.now = step * MS;
+    for (size_t k = 0; k < n / 1000; ++k) {
+      const size_t c = bench_rand(&expiry.state) % n;
+      cds_timer_wheel_cancel(&wheel, ids[c]);
+      ids[c] = cds_timer_wheel_arm(&wheel, expiry.now + timeout(&expiry.state), (void*) (uintptr_t) c);
+    }
+    fired += cds_timer_wheel_advance(&wheel, expiry.now, rearm_expired, &expiry);
+  }
+  const double run = bench_now() - start;
+
+  printf("  cds_timer_wheel      arm %6.1f ns   step %8.1f us   (%zu fired, %zu armed)\n", arm * 1e9 / n,
+         run * 1e6 / steps, fired, cds_timer_wheel_size(&wheel));
+  cds_timer_wheel_delete(&wheel);
+  free(ids);
+}
+
+static void run_heap(size_t n, size_t steps) {
+  uint32_t *generations = calloc(n, sizeof(uint32_t));
+  struct cds_heap heap = cds_heap_new_dary(sizeof(struct heap_timer), cmp_deadline, 4);
+  uint64_t state = 0x9E3779B97F4A7C15ULL;
+  size_t fired = 0;
+
+  double start = bench_now();
+  for (uint32_t c = 0; c < n; ++c) {
+    const struct heap_timer timer = {timeout(&state), c, 0};
+    cds_heap_push(&heap, &timer);
+  }
+  const double arm = bench_now() - start;
+
+  start = bench_now();
+  for (size_t step = 1; step <= steps; ++step) {
+    const uint64_t now = step * MS;
+    for (size_t k = 0; k < n / 1000; ++k) {
+      const uint32_t c = (uint32_t) (bench_rand(&state) % n);
+      const struct heap_timer timer = {now + timeout(&state), c, ++generations[c]};
+      cds_heap_push(&heap, &timer);
+    }
+    while (!cds_heap_empty(&heap)) {
+      struct heap_timer timer = *(const struct heap_timer*) cds_heap_top(&heap);
+      if (timer.deadline > now) {
+        break;
+      }
+      cds_heap_pop(&heap);
+      if (timer.generation == generations[timer.connection]) {
+        fired++;
+        timer.deadline = now + timeout(&state);
+        timer.generation = ++generations[timer.connection];
+        cds_heap_push(&heap, &timer);
+      }
+    }
+  }
+  const double run = bench_now() - start;
+
+  printf("  cds_heap (4-ary)     arm %6.1f ns   step %8.1f us   (%zu fired, %zu entries)\n", arm * 1e9 / n,
+         run * 1e6 / steps, fired, cds_heap_size(&heap));
+  cds_heap_delete(&heap);
+  free(generations);
+}
+
+int main(int argc, char **argv) {
+  const size_t n = bench_arg_size(argc, argv, 1, (size_t) 1000000);
+  const size_t steps = bench_arg_size(argc, argv, 2, (size_t) 20000);
+  printf("%zu timers, %zu steps of 1 ms, %zu re-arms per step\n", n, steps, n / 1000);
+  run_heap(n, steps);
+  run_wheel(n, steps);
+  return 0;
+}
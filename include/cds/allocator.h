@@ -0,0 +1,165 @@
+#ifndef CDS_ALLOCATOR_H
+#define CDS_ALLOCATOR_H
+
+#include <stddef.h>
+
+typedef struct cds_allocator {
+  void *(*alloc)(void *context, size_t size);
+  void *(*realloc)(void *context, void *ptr, size_t old_size, size_t new_size);
+  void (*free)(void *context, void *ptr, size_t size);
+  void *context;
+} CdsAllocator;
+
+#define CDS_HUGE_PAGE_SIZE ((size_t) 2 << 20)
+
+#define CDS_ALLOCATOR_HUGE_PAGES 0x1
+#define CDS_ALLOCATOR_HUGETLB    0x2
+
+typedef struct cds_aligned_allocator {
+  struct cds_allocator allocator;
+  size_t alignment;
+  int flags;
+} CdsAlignedAllocator;
+
+/*
+ *********************************************************************************************************
+ *
+ *                                         CDS DEFAULT ALLOCATOR
+ * 
+ * Description: The allocator backed by malloc, realloc and free from the C library.
+ * 
+ * Notes: Every container constructor without an explicit allocator uses this one. Passing NULL as the
+ *        allocator to any function in this library also selects it.
+ *********************************************************************************************************
+ */
+extern const struct cds_allocator cds_default_allocator;
+
+/*
+ *********************************************************************************************************
+ *
+ *                                       CDS CACHE LINE ALLOCATOR
+ * 
+ * Description: An allocator whose blocks start on a 64-byte cache line boundary.
+ * 
+ * Notes: Behaves like a struct cds_aligned_allocator initialized with an alignment of 64 and no flags,
+ *        without needing one to be kept alive. Resizing always copies the block.
+ *********************************************************************************************************
+ */
+extern const struct cds_allocator cds_cache_line_allocator;
+
+/*
+ *********************************************************************************************************
+ *
+ *                                          CDS ALLOCATOR ALLOC
+ * 
+ * Description: Allocates size bytes from the allocator.
+ * 
+ * Arguments: allocator   A pointer to the allocator, or NULL for cds_default_allocator.
+ *            size        The number of bytes to allocate.
+ *
+ * Returns: A pointer to the allocated memory, or NULL if the allocation fails.
+ * 
+ * Notes: none
+ *********************************************************************************************************
+ */
+void* cds_allocator_alloc(const struct cds_allocator *allocator, size_t size);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                         CDS ALLOCATOR REALLOC
+ * 
+ * Description: Resizes a block previously returned by the same allocator.
+ * 
+ * Arguments: allocator   A pointer to the allocator, or NULL for cds_default_allocator.
+ *            ptr         The block to resize, or NULL to allocate a new one.
+ *            old_size    The current size of the block in bytes.
+ *            new_size    The requested size of the block in bytes.
+ *
+ * Returns: A pointer to the resized block, or NULL if the allocation fails. On failure the original
+ *          block is left untouched.
+ * 
+ * Notes: The old size is passed so that allocators without per-block headers (e.g. arenas) can copy.
+ *********************************************************************************************************
+ */
+void* cds_allocator_realloc(const struct cds_allocator *allocator, void *ptr, size_t old_size,
+                            size_t new_size);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                          CDS ALLOCATOR FREE
+ * 
+ * Description: Returns a block to the allocator.
+ * 
+ * Arguments: allocator   A pointer to the allocator, or NULL for cds_default_allocator.
+ *            ptr         The block to release. NULL is ignored.
+ *            size        The size of the block in bytes.
+ *
+ * Returns: none
+ * 
+ * Notes: none
+ *********************************************************************************************************
+ */
+void cds_allocator_free(const struct cds_allocator *allocator, void *ptr, size_t size);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                         CDS ALLOCATOR STRDUP
+ * 
+ * Description: Duplicates a NUL-terminated string into memory obtained from the allocator.
+ * 
+ * Arguments: allocator   A pointer to the allocator, or NULL for cds_default_allocator.
+ *            str         The string to duplicate.
+ *
+ * Returns: A pointer to the copy, or NULL if the allocation fails.
+ * 
+ * Notes: The copy occupies strlen(str) + 1 bytes, which is the size to pass to cds_allocator_free.
+ *********************************************************************************************************
+ */
+char* cds_allocator_strdup(const struct cds_allocator *allocator, const char *str);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                         CDS ALLOCATOR STRFREE
+ * 
+ * Description: Releases a string returned by cds_allocator_strdup.
+ * 
+ * Arguments: allocator   The allocator the string was duplicated with.
+ *            str         The string to release. NULL is ignored.
+ *
+ * Returns: none
+ * 
+ * Notes: none
+ *********************************************************************************************************
+ */
+void cds_allocator_strfree(const struct cds_allocator *allocator, char *str);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                      CDS ALIGNED ALLOCATOR INIT
+ * 
+ * Description: Initializes an allocator that returns aligned blocks and, optionally, backs large
+ *              blocks with 2 MB huge pages.
+ * 
+ * Arguments: aligned     A pointer to the struct cds_aligned_allocator to initialize.
+ *            alignment   The alignment of every block in bytes, e.g. 64 for a cache line. Must be a
+ *                        power of two no larger than CDS_HUGE_PAGE_SIZE.
+ *            flags       0, or a bitwise OR of CDS_ALLOCATOR_HUGE_PAGES (map blocks of at least
+ *                        CDS_HUGE_PAGE_SIZE bytes and request transparent huge pages with
+ *                        madvise(MADV_HUGEPAGE)) and CDS_ALLOCATOR_HUGETLB (try MAP_HUGETLB first and
+ *                        fall back to transparent huge pages when no huge pages are reserved).
+ *
+ * Returns: 0 on success, -1 if the alignment is invalid.
+ * 
+ * Notes: Pass &aligned->allocator to any *_new_with_allocator constructor. The struct must outlive
+ *        every container using it. Huge-page blocks are rounded up to a multiple of
+ *        CDS_HUGE_PAGE_SIZE and are 2 MB aligned.
+ *********************************************************************************************************
+ */
+int cds_aligned_allocator_init(struct cds_aligned_allocator *aligned, size_t alignment, int flags);
+
+#endif
@@ -4,13 +4,27 @@
 #include <stddef.h>
 #include <stdbool.h>
 
+#include "allocator.h"
+
 typedef int (*cds_cmp_func)(const void *a, const void *b);
 
 typedef struct cds_array {
   char *data;
   size_t size, capacity, element_size;
+  const struct cds_allocator *allocator;
 } CdsArray;
 
+#define CDS_ARRAY_MAP_CREATE   0x1
+#define CDS_ARRAY_MAP_TRUNCATE 0x2
+#define CDS_ARRAY_MAP_READONLY 0x4
+
+enum cds_array_map_advice {
+  CDS_ARRAY_MAP_ADVICE_NORMAL,
+  CDS_ARRAY_MAP_ADVICE_SEQUENTIAL,
+  CDS_ARRAY_MAP_ADVICE_RANDOM,
+  CDS_ARRAY_MAP_ADVICE_WILLNEED
+};
+
 /*
  *********************************************************************************************************
  *
@@ -28,6 +42,25 @@ typedef struct cds_array {
  */
 struct cds_array cds_array_new(size_t element_size);
 
+/*
+ *********************************************************************************************************
+ *
+ *                                      CDS ARRAY NEW WITH ALLOCATOR
+ * 
+ * Description: Creates a new dynamic array whose storage comes from the given allocator.
+ * 
+ * Arguments: element_size   The size of each element in the array.
+ *            allocator      A pointer to the allocator, or NULL for cds_default_allocator.
+ *
+ * Returns: A newly created struct cds_array instance. The data field can be NULL if memory allocation
+ *          fails.
+ * 
+ * Notes: The allocator is referenced, not copied, and must outlive the array.
+ *********************************************************************************************************
+ */
+struct cds_array cds_array_new_with_allocator(size_t element_size,
+                                              const struct cds_allocator *allocator);
+
 /*
  *********************************************************************************************************
  *
@@ -61,6 +94,92 @@ void cds_array_delete(struct cds_array *array);
  */
 int cds_array_push_back(struct cds_array *array, const void *new_element);
 
+/*
+ *********************************************************************************************************
+ *
+ *                                            CDS ARRAY PUSH BACK N
+ * 
+ * Description: Appends a contiguous block of elements to the end of the dynamic array.
+ * 
+ * Arguments: array          A pointer to the struct cds_array instance.
+ *            new_elements   A pointer to the first of count consecutive elements to be added.
+ *            count          The number of elements to be added.
+ *
+ * Returns: 0 on success, -1 on failure (e.g., if memory allocation fails).
+ * 
+ * Notes: The array grows at most once and the elements are copied with a single memcpy. On failure
+ *        the array is left unchanged.
+ *********************************************************************************************************
+ */
+int cds_array_push_back_n(struct cds_array *array, const void *new_elements, size_t count);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                            CDS ARRAY EMPLACE BACK
+ * 
+ * Description: Appends an uninitialized slot to the end of the dynamic array.
+ * 
+ * Arguments: array   A pointer to the struct cds_array instance.
+ *
+ * Returns: A pointer to the new slot, or NULL if memory allocation fails.
+ * 
+ * Notes: The caller constructs the element in place through the returned pointer. The pointer is
+ *        invalidated by any later call that grows the array.
+ *********************************************************************************************************
+ */
+void* cds_array_emplace_back(struct cds_array *array);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                            CDS ARRAY RESERVE
+ * 
+ * Description: Ensures the dynamic array can hold at least capacity elements without reallocating.
+ * 
+ * Arguments: array      A pointer to the struct cds_array instance.
+ *            capacity   The minimum number of elements the array should be able to hold.
+ *
+ * Returns: 0 on success, -1 on failure (e.g., if memory allocation fails).
+ * 
+ * Notes: The capacity never decreases. On failure the array is left unchanged.
+ *********************************************************************************************************
+ */
+int cds_array_reserve(struct cds_array *array, size_t capacity);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                            CDS ARRAY RESIZE
+ * 
+ * Description: Changes the number of elements in the dynamic array.
+ * 
+ * Arguments: array      A pointer to the struct cds_array instance.
+ *            new_size   The new number of elements.
+ *
+ * Returns: 0 on success, -1 on failure (e.g., if memory allocation fails).
+ * 
+ * Notes: Elements added by growing the array are zero-filled. Shrinking keeps the capacity.
+ *********************************************************************************************************
+ */
+int cds_array_resize(struct cds_array *array, size_t new_size);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                            CDS ARRAY SHRINK TO FIT
+ * 
+ * Description: Reduces the capacity of the dynamic array to its size.
+ * 
+ * Arguments: array   A pointer to the struct cds_array instance.
+ *
+ * Returns: 0 on success, -1 on failure (e.g., if memory allocation fails).
+ * 
+ * Notes: The capacity is kept at least 1 so that later pushes can keep doubling it.
+ *********************************************************************************************************
+ */
+int cds_array_shrink_to_fit(struct cds_array *array);
+
 /*
  *********************************************************************************************************
  *
@@ -143,4 +262,80 @@ size_t cds_array_size(const struct cds_array *array);
  */
 bool cds_array_empty(const struct cds_array *array);
 
+/*
+ *********************************************************************************************************
+ *
+ *                                         CDS ARRAY OPEN MAPPED
+ * 
+ * Description: Opens a dynamic array whose data is a memory-mapped file.
+ * 
+ * Arguments: path           The path of the backing file.
+ *            element_size   The size of each element in the array.
+ *            flags          A bitwise OR of CDS_ARRAY_MAP_CREATE (create the file if it does not
+ *                           exist), CDS_ARRAY_MAP_TRUNCATE (discard existing contents) and
+ *                           CDS_ARRAY_MAP_READONLY (map read-only; the array cannot grow).
+ *
+ * Returns: A struct cds_array instance whose data points into the mapping. The data field is NULL if
+ *          the file cannot be opened or mapped, or if it was written with a different element size.
+ * 
+ * Notes: The file holds a 64-byte header followed by the raw elements, so reopening it costs one mmap
+ *        and no parsing. Growth extends the file with ftruncate and remaps it, which may move data.
+ *        Every other array function, including cds_array_sort and cds_array_search_binary, works on
+ *        the mapped array unchanged. Close it with cds_array_close_mapped so its size is recorded;
+ *        cds_array_delete only unmaps it.
+ *********************************************************************************************************
+ */
+struct cds_array cds_array_open_mapped(const char *path, size_t element_size, int flags);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                        CDS ARRAY FLUSH MAPPED
+ * 
+ * Description: Records the size of a mapped array in its file and writes dirty pages back.
+ * 
+ * Arguments: array         A pointer to a struct cds_array opened by cds_array_open_mapped.
+ *            synchronous   true to wait for the write (msync MS_SYNC), false to schedule it (MS_ASYNC).
+ *
+ * Returns: 0 on success, -1 on failure or if the array is not mapped.
+ * 
+ * Notes: none
+ *********************************************************************************************************
+ */
+int cds_array_flush_mapped(struct cds_array *array, bool synchronous);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                        CDS ARRAY ADVISE MAPPED
+ * 
+ * Description: Tells the kernel how the mapped array is about to be accessed.
+ * 
+ * Arguments: array    A pointer to a struct cds_array opened by cds_array_open_mapped.
+ *            advice   The expected access pattern, passed on to madvise.
+ *
+ * Returns: 0 on success, -1 on failure or if the array is not mapped.
+ * 
+ * Notes: The advice applies to the current mapping and is lost when the array grows and is remapped.
+ *********************************************************************************************************
+ */
+int cds_array_advise_mapped(struct cds_array *array, enum cds_array_map_advice advice);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                        CDS ARRAY CLOSE MAPPED
+ * 
+ * Description: Records the size of a mapped array, trims the file to it and unmaps the array.
+ * 
+ * Arguments: array   A pointer to a struct cds_array opened by cds_array_open_mapped.
+ *
+ * Returns: 0 on success, -1 on failure or if the array is not mapped. The array is unmapped in every
+ *          case where it was mapped.
+ * 
+ * Notes: After this call the array is empty, as after cds_array_delete.
+ *********************************************************************************************************
+ */
+int cds_array_close_mapped(struct cds_array *array);
+
 #endif
\ No newline at end of file
@@ -4,6 +4,8 @@
 #include <stdbool.h>
 #include <stddef.h>
 
+#include "allocator.h"
+
 typedef struct cds_avl_node {
   void *key;
   void *value;
@@ -19,6 +21,7 @@ typedef struct cds_avl_tree {
   size_t key_size;
   int (*cmp)(const void *key1, const void *key2);
   size_t size;
+  const struct cds_allocator *allocator;
 } CdsAvlTree;
 
 /*
@@ -41,6 +44,27 @@ typedef struct cds_avl_tree {
 struct cds_avl_tree cds_avl_tree_new(size_t element_size, size_t key_size,
                                      int (*cmp)(const void *, const void *));
 
+/*
+ *********************************************************************************************************
+ *
+ *                                    CDS AVL TREE NEW WITH ALLOCATOR
+ * 
+ * Description: Initializes a new AVL tree whose nodes come from the given allocator.
+ * 
+ * Arguments: element_size   The size of the elements to be stored in the tree.
+ *            key_size       The size of the keys used for comparison.
+ *            cmp            Pointer to the comparison function for keys.
+ *            allocator      A pointer to the allocator, or NULL for cds_default_allocator.
+ *
+ * Returns: An initialized AVL tree structure (by value).
+ * 
+ * Notes: The allocator is referenced, not copied, and must outlive the tree.
+ *********************************************************************************************************
+ */
+struct cds_avl_tree cds_avl_tree_new_with_allocator(size_t element_size, size_t key_size,
+                                                    int (*cmp)(const void *, const void *),
+                                                    const struct cds_allocator *allocator);
+
 /*
  *********************************************************************************************************
  *
@@ -1,8 +1,20 @@
 #ifndef CDS_GRAPH_H
 #define CDS_GRAPH_H
 
+#include "cds/array.h"
 #include "cds/list.h"
 #include <stddef.h>
+#include <stdint.h>
+
+#define CDS_GRAPH_NO_NODE SIZE_MAX
+
+/*
+ * An edge of a graph whose nodes are numbered 0 to node_count - 1.
+ */
+struct cds_graph_edge {
+    size_t to;
+    double weight;
+};
 
 /*
  * Callback to get neighbors of a node.
@@ -16,6 +28,13 @@ typedef void (*CdsGraphGetNeighborsFunc)(const void *node, struct cds_list *neig
  */
 typedef void (*CdsGraphVisitFunc)(const void *node);
 
+/*
+ * Callback to get the outgoing edges of a numbered node.
+ * Implementations should push struct cds_graph_edge values into the provided 'edges' array, which is
+ * empty when this is called.
+ */
+typedef void (*CdsGraphGetEdgesFunc)(size_t node, struct cds_array *edges);
+
 /*
  *********************************************************************************************************
  *
@@ -66,4 +85,32 @@ void cds_graph_dfs(const void *start_node,
                    CdsGraphVisitFunc visit,
                    int (*cmp)(const void *, const void *));
 
+/*
+ *********************************************************************************************************
+ *
+ *                                          CDS GRAPH DIJKSTRA
+ *
+ * Description: Computes the shortest distances from a node to every node of a weighted graph.
+ *
+ * Arguments: node_count   Number of nodes, numbered 0 to node_count - 1.
+ *            source       The node the paths start from.
+ *            get_edges    Function to get the outgoing edges of a node. Weights must not be negative.
+ *            dist         Array of node_count distances to fill. Unreachable nodes get INFINITY.
+ *            prev         Array of node_count predecessors on the shortest paths to fill, or NULL.
+ *                         The source and unreachable nodes get CDS_GRAPH_NO_NODE.
+ *
+ * Returns: 0 on success, -1 on failure (e.g., invalid arguments, an edge to a node outside the graph
+ *          or with a negative or NaN weight, or if memory allocation fails).
+ *
+ * Notes: Uses CdsIndexedHeap keyed by node, so a shorter path to a queued node updates its entry
+ *        with decrease_key instead of queueing it again: the queue never holds more than node_count
+ *        entries, and O((V + E) log V) time.
+ *********************************************************************************************************
+ */
+int cds_graph_dijkstra(size_t node_count,
+                       size_t source,
+                       CdsGraphGetEdgesFunc get_edges,
+                       double *dist,
+                       size_t *prev);
+
 #endif
@@ -1,6 +1,8 @@
 #ifndef CDS_HASHTABLE_H
 #define CDS_HASHTABLE_H
 
+#include "allocator.h"
+
 // Common structures and function declarations for hash tables will go here.
 
 // Generic hash function pointer type for Cuckoo Hashing
@@ -14,6 +16,7 @@ extern "C" {
 typedef struct cds_hashtable_chaining_s cds_hashtable_chaining_t;
 
 cds_hashtable_chaining_t* cds_hashtable_chaining_create(size_t initial_size);
+cds_hashtable_chaining_t* cds_hashtable_chaining_create_with_allocator(size_t initial_size, const struct cds_allocator* allocator);
 void cds_hashtable_chaining_destroy(cds_hashtable_chaining_t* table);
 int cds_hashtable_chaining_insert(cds_hashtable_chaining_t* table, const char* key, void* value); // Return 0 on success, -1 on failure
 void* cds_hashtable_chaining_search(cds_hashtable_chaining_t* table, const char* key);
@@ -23,6 +26,7 @@ int cds_hashtable_chaining_delete(cds_hashtable_chaining_t* table, const char* k
 typedef struct cds_hashtable_lp_s cds_hashtable_lp_t;
 
 cds_hashtable_lp_t* cds_hashtable_lp_create(size_t initial_size);
+cds_hashtable_lp_t* cds_hashtable_lp_create_with_allocator(size_t initial_size, const struct cds_allocator* allocator);
 void cds_hashtable_lp_destroy(cds_hashtable_lp_t* table);
 int cds_hashtable_lp_insert(cds_hashtable_lp_t* table, const char* key, void* value); // Return 0 on success, -1 on error, -2 if table full
 void* cds_hashtable_lp_search(cds_hashtable_lp_t* table, const char* key);
@@ -32,6 +36,7 @@ int cds_hashtable_lp_delete(cds_hashtable_lp_t* table, const char* key); // Retu
 typedef struct cds_hashtable_qp_s cds_hashtable_qp_t;
 
 cds_hashtable_qp_t* cds_hashtable_qp_create(size_t initial_size);
+cds_hashtable_qp_t* cds_hashtable_qp_create_with_allocator(size_t initial_size, const struct cds_allocator* allocator);
 void cds_hashtable_qp_destroy(cds_hashtable_qp_t* table);
 int cds_hashtable_qp_insert(cds_hashtable_qp_t* table, const char* key, void* value); // Return 0 on success, -1 on error, -2 if table full or insert failed
 void* cds_hashtable_qp_search(cds_hashtable_qp_t* table, const char* key);
@@ -41,6 +46,7 @@ int cds_hashtable_qp_delete(cds_hashtable_qp_t* table, const char* key); // Retu
 typedef struct cds_hashtable_dh_s cds_hashtable_dh_t;
 
 cds_hashtable_dh_t* cds_hashtable_dh_create(size_t initial_size);
+cds_hashtable_dh_t* cds_hashtable_dh_create_with_allocator(size_t initial_size, const struct cds_allocator* allocator);
 void cds_hashtable_dh_destroy(cds_hashtable_dh_t* table);
 int cds_hashtable_dh_insert(cds_hashtable_dh_t* table, const char* key, void* value); // Return 0 on success, -1 on error, -2 if table full or insert failed
 void* cds_hashtable_dh_search(cds_hashtable_dh_t* table, const char* key);
@@ -50,6 +56,7 @@ int cds_hashtable_dh_delete(cds_hashtable_dh_t* table, const char* key); // Retu
 typedef struct cds_hashtable_cuckoo_s cds_hashtable_cuckoo_t;
 
 cds_hashtable_cuckoo_t* cds_hashtable_cuckoo_create(size_t initial_size_per_table, cds_hash_function_t h1, cds_hash_function_t h2);
+cds_hashtable_cuckoo_t* cds_hashtable_cuckoo_create_with_allocator(size_t initial_size_per_table, cds_hash_function_t h1, cds_hash_function_t h2, const struct cds_allocator* allocator);
 void cds_hashtable_cuckoo_destroy(cds_hashtable_cuckoo_t* table);
 int cds_hashtable_cuckoo_insert(cds_hashtable_cuckoo_t* table, const char* key, void* value); // Return 0 on success, -1 on error, -2 if max displacements reached
 void* cds_hashtable_cuckoo_search(cds_hashtable_cuckoo_t* table, const char* key);
@@ -59,6 +66,7 @@ int cds_hashtable_cuckoo_delete(cds_hashtable_cuckoo_t* table, const char* key);
 typedef struct cds_hashtable_hopscotch_s cds_hashtable_hopscotch_t;
 
 cds_hashtable_hopscotch_t* cds_hashtable_hopscotch_create(size_t initial_size, unsigned int H_neighborhood_size); // H_neighborhood_size is often fixed (e.g. 32/64)
+cds_hashtable_hopscotch_t* cds_hashtable_hopscotch_create_with_allocator(size_t initial_size, unsigned int H_neighborhood_size, const struct cds_allocator* allocator);
 void cds_hashtable_hopscotch_destroy(cds_hashtable_hopscotch_t* table);
 int cds_hashtable_hopscotch_insert(cds_hashtable_hopscotch_t* table, const char* key, void* value); // Ret 0 success, -1 err, -2 full, -3 needs swap/rehash
 void* cds_hashtable_hopscotch_search(cds_hashtable_hopscotch_t* table, const char* key);
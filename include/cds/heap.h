@@ -5,9 +5,14 @@
 
 #include "array.h"
 
+#define CDS_HEAP_MAX_ARITY 8
+
+// The root is at index arity - 1 of data; the slots before it are padding, so that the children of
+// every node start at a multiple of arity.
 struct cds_heap {
   struct cds_array data;
   int (*cmp)(const void *, const void *);
+  size_t arity;
 };
 
 /*
@@ -28,6 +33,94 @@ struct cds_heap {
  */
 struct cds_heap cds_heap_new(size_t element_size, int (*cmp)(const void *, const void *));
 
+/*
+ *********************************************************************************************************
+ *
+ *                                      CDS HEAP NEW WITH ALLOCATOR
+ * 
+ * Description: Creates a new heap whose storage comes from the given allocator.
+ * 
+ * Arguments: element_size   The size of each element in the heap.
+ *            cmp            A pointer to a comparison function that determines the order of elements.
+ *            allocator      A pointer to the allocator, or NULL for cds_default_allocator.
+ *
+ * Returns: A newly created struct cds_heap instance. The data field can be NULL if memory allocation
+ *          fails.
+ * 
+ * Notes: The allocator is referenced, not copied, and must outlive the heap.
+ *********************************************************************************************************
+ */
+struct cds_heap cds_heap_new_with_allocator(size_t element_size, int (*cmp)(const void *, const void *),
+                                            const struct cds_allocator *allocator);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                          CDS HEAP NEW DARY
+ * 
+ * Description: Creates a new heap in which every node has up to arity children.
+ * 
+ * Arguments: element_size   The size of each element in the heap.
+ *            cmp            A pointer to a comparison function that determines the order of elements.
+ *            arity          The number of children per node: 2, 4 or 8.
+ *
+ * Returns: A newly created struct cds_heap instance. The data field can be NULL if memory allocation
+ *          fails or arity is invalid.
+ * 
+ * Notes: The elements live in blocks from cds_cache_line_allocator, and the children of a node are
+ *        contiguous and start at a multiple of arity elements. When arity * element_size divides 64
+ *        or is a multiple of it, each group of siblings starts on a cache line and a pop touches one
+ *        or a few lines per level. A 4-ary heap is half as deep as a binary one, which saves cache
+ *        misses once the heap outgrows the cache, at the cost of more comparisons per level. All
+ *        other heap functions work the same on it.
+ *********************************************************************************************************
+ */
+struct cds_heap cds_heap_new_dary(size_t element_size, int (*cmp)(const void *, const void *), size_t arity);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                   CDS HEAP NEW DARY WITH ALLOCATOR
+ * 
+ * Description: Same as cds_heap_new_dary, with the storage taken from the given allocator.
+ * 
+ * Arguments: element_size, cmp, arity   See cds_heap_new_dary.
+ *            allocator                  A pointer to the allocator, or NULL for cds_default_allocator.
+ *
+ * Returns: A newly created struct cds_heap instance. The data field can be NULL if memory allocation
+ *          fails or arity is invalid.
+ * 
+ * Notes: Siblings are only cache line aligned if the allocator's blocks are, as with an aligned
+ *        allocator. The allocator is referenced, not copied, and must outlive the heap.
+ *********************************************************************************************************
+ */
+struct cds_heap cds_heap_new_dary_with_allocator(size_t element_size, int (*cmp)(const void *, const void *),
+                                                 size_t arity, const struct cds_allocator *allocator);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                          CDS HEAP FROM ARRAY
+ * 
+ * Description: Creates a heap out of the elements of an existing array, taking over its storage.
+ * 
+ * Arguments: array   A pointer to the array. On success it is left empty, with a NULL data field.
+ *            cmp     A pointer to a comparison function that determines the order of elements.
+ *            arity   The number of children per node: 2, 4 or 8.
+ *
+ * Returns: A struct cds_heap instance holding the elements. The data field is NULL if memory
+ *          allocation fails or arity is invalid, in which case the array is left unchanged.
+ * 
+ * Notes: O(n): the heap is built bottom-up, sifting down each node from the last parent to the root,
+ *        which compares about twice per element instead of pushing them one by one. The elements are
+ *        not copied to a new block; only the first arity - 1 of them move to the end of the array to
+ *        make room for the padding before the root, and the block grows in place by arity slots if
+ *        it is full. The heap keeps the array's allocator, and cds_heap_delete frees the block.
+ *********************************************************************************************************
+ */
+struct cds_heap cds_heap_from_array(struct cds_array *array, int (*cmp)(const void *, const void *),
+                                    size_t arity);
+
 /*
  *********************************************************************************************************
  *
@@ -56,11 +149,34 @@ void cds_heap_delete(struct cds_heap *heap);
  *
  * Returns: 0 on success, -1 on failure (e.g., memory allocation failure).
  * 
- * Notes: The new element is copied into the heap.
+ * Notes: The new element is copied into the heap, so it must not point into the heap itself. Elements
+ *        on its path to the root move down by one copy per level, whatever the element size, and no
+ *        shared state is used, so different heaps may be used on different threads at once.
  *********************************************************************************************************
  */
 int cds_heap_push(struct cds_heap *heap, const void *new_element);
 
+/*
+ *********************************************************************************************************
+ *
+ *                                            CDS HEAP PUSH N
+ * 
+ * Description: Inserts several elements into the heap.
+ * 
+ * Arguments: heap           A pointer to the heap.
+ *            new_elements   A pointer to the first of count contiguous elements.
+ *            count          The number of elements to insert.
+ *
+ * Returns: 0 on success, -1 on failure (e.g., memory allocation failure), in which case the heap is
+ *          unchanged.
+ * 
+ * Notes: The batch is appended with one copy. If it is at least as large as the heap, the heap is then
+ *        rebuilt bottom-up in O(n + count), as in cds_heap_from_array; otherwise each new element is
+ *        sifted up in turn. The elements must not point into the heap itself.
+ *********************************************************************************************************
+ */
+int cds_heap_push_n(struct cds_heap *heap, const void *new_elements, size_t count);
+
 /*
  *********************************************************************************************************
  *
@@ -72,11 +188,32 @@ int cds_heap_push(struct cds_heap *heap, const void *new_element);
  *
  * Returns: 0 on success, -1 on failure (e.g., if the heap is empty).
  * 
- * Notes: The top element is determined by the comparison function provided during heap creation.
+ * Notes: The top element is determined by the comparison function provided during heap creation. The
+ *        last element fills the gap: the child that comes first moves up into it, one copy per level,
+ *        until the last element fits.
  *********************************************************************************************************
  */
 int cds_heap_pop(struct cds_heap *heap);
 
+/*
+ *********************************************************************************************************
+ *
+ *                                            CDS HEAP POP N
+ * 
+ * Description: Removes up to k elements from the top of the heap and copies them out in order.
+ * 
+ * Arguments: heap   A pointer to the heap.
+ *            out    A pointer to room for k elements.
+ *            k      The maximum number of elements to remove.
+ *
+ * Returns: The number of elements removed, which is less than k only if the heap runs out.
+ * 
+ * Notes: out[0] is the element that was on top, out[1] the next one, and so on. Each element is copied
+ *        once into out; there is no separate cds_heap_top call or copy per element.
+ *********************************************************************************************************
+ */
+size_t cds_heap_pop_n(struct cds_heap *heap, void *out, size_t k);
+
 /*
  *********************************************************************************************************
  *
@@ -125,4 +262,4 @@ size_t cds_heap_size(const struct cds_heap *heap);
  */
 bool cds_heap_empty(const struct cds_heap *heap);
 
-#endif
\ No newline at end of file
+#endif
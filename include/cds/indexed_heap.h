@@ -0,0 +1,278 @@
+#ifndef CDS_INDEXED_HEAP_H
+#define CDS_INDEXED_HEAP_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "allocator.h"
+
+#define CDS_INDEXED_HEAP_ARITY 4
+#define CDS_INDEXED_HEAP_ABSENT SIZE_MAX
+
+// A 4-ary heap of (id, priority) entries. Index i of keys and ids holds one entry, whose children are
+// at 4 * i + 1 to 4 * i + 4; positions maps every id below capacity to its index, or to
+// CDS_INDEXED_HEAP_ABSENT.
+typedef struct cds_indexed_heap {
+  char *keys;                 // the priorities, in heap order
+  size_t *ids;                // the ids, in heap order
+  size_t *positions;          // the index of each id in keys and ids
+  size_t size;
+  size_t capacity;            // ids are below capacity, which is also the room in keys and ids
+  size_t element_size;
+  int (*cmp)(const void *, const void *);
+  const struct cds_allocator *allocator;
+} CdsIndexedHeap;
+
+/*
+ *********************************************************************************************************
+ *
+ *                                         CDS INDEXED HEAP NEW
+ *
+ * Description: Creates a new priority queue of entries identified by dense integer ids, whose
+ *              priorities can be changed and which can be removed while inside.
+ *
+ * Arguments: capacity       The number of ids expected, 0 to n - 1. Larger ids grow the heap.
+ *            element_size   The size of each priority.
+ *            cmp            A pointer to a comparison function for priorities. The entry whose
+ *                           priority comes first is on top.
+ *
+ * Returns: A newly created struct cds_indexed_heap instance. The keys field is NULL if memory
+ *          allocation fails.
+ *
+ * Notes: Every id is in the heap at most once. Memory is proportional to the largest id, not to the
+ *        number of entries, so ids should be dense, like the indices of graph nodes. The caller is
+ *        responsible for freeing the memory using cds_indexed_heap_delete.
+ *********************************************************************************************************
+ */
+struct cds_indexed_heap cds_indexed_heap_new(size_t capacity, size_t element_size,
+                                             int (*cmp)(const void *, const void *));
+
+/*
+ *********************************************************************************************************
+ *
+ *                                  CDS INDEXED HEAP NEW WITH ALLOCATOR
+ *
+ * Description: Same as cds_indexed_heap_new, with the storage taken from the given allocator.
+ *
+ * Arguments: capacity, element_size, cmp   See cds_indexed_heap_new.
+ *            allocator                     A pointer to the allocator, or NULL for cds_default_allocator.
+ *
+ * Returns: A newly created struct cds_indexed_heap instance. The keys field is NULL on failure.
+ *
+ * Notes: The allocator is referenced, not copied, and must outlive the heap.
+ *********************************************************************************************************
+ */
+struct cds_indexed_heap cds_indexed_heap_new_with_allocator(size_t capacity, size_t element_size,
+                                                            int (*cmp)(const void *, const void *),
+                                                            const struct cds_allocator *allocator);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                       CDS INDEXED HEAP DELETE
+ *
+ * Description: Deletes the heap and frees the memory allocated for it.
+ *
+ * Arguments: heap   A pointer to the heap to be deleted.
+ *
+ * Returns: none
+ *
+ * Notes: none
+ *********************************************************************************************************
+ */
+void cds_indexed_heap_delete(struct cds_indexed_heap *heap);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                        CDS INDEXED HEAP PUSH
+ *
+ * Description: Inserts an entry into the heap.
+ *
+ * Arguments: heap       A pointer to the heap.
+ *            id         The id of the entry.
+ *            priority   A pointer to its priority, which is copied.
+ *
+ * Returns: 0 on success, -1 on failure (e.g., if id is already in the heap or if memory allocation
+ *          fails).
+ *
+ * Notes: O(log n). An id at or above the capacity grows the heap to at least twice its capacity.
+ *********************************************************************************************************
+ */
+int cds_indexed_heap_push(struct cds_indexed_heap *heap, size_t id, const void *priority);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                         CDS INDEXED HEAP POP
+ *
+ * Description: Removes the top entry from the heap.
+ *
+ * Arguments: heap   A pointer to the heap.
+ *
+ * Returns: 0 on success, -1 if the heap is empty.
+ *
+ * Notes: O(log n).
+ *********************************************************************************************************
+ */
+int cds_indexed_heap_pop(struct cds_indexed_heap *heap);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                         CDS INDEXED HEAP TOP
+ *
+ * Description: Retrieves the priority of the top entry without removing it.
+ *
+ * Arguments: heap   A pointer to the heap.
+ *
+ * Returns: A pointer to the priority, or NULL if the heap is empty.
+ *
+ * Notes: cds_indexed_heap_top_id returns the id of the same entry.
+ *********************************************************************************************************
+ */
+void* cds_indexed_heap_top(const struct cds_indexed_heap *heap);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                        CDS INDEXED HEAP TOP ID
+ *
+ * Description: Retrieves the id of the top entry without removing it.
+ *
+ * Arguments: heap   A pointer to the heap.
+ *
+ * Returns: The id, or CDS_INDEXED_HEAP_ABSENT if the heap is empty.
+ *
+ * Notes: none
+ *********************************************************************************************************
+ */
+size_t cds_indexed_heap_top_id(const struct cds_indexed_heap *heap);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                       CDS INDEXED HEAP PRIORITY
+ *
+ * Description: Retrieves the priority of an entry.
+ *
+ * Arguments: heap   A pointer to the heap.
+ *            id     The id of the entry.
+ *
+ * Returns: A pointer to the priority, or NULL if id is not in the heap.
+ *
+ * Notes: The pointer is valid until the heap is next modified.
+ *********************************************************************************************************
+ */
+void* cds_indexed_heap_priority(const struct cds_indexed_heap *heap, size_t id);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                       CDS INDEXED HEAP CONTAINS
+ *
+ * Description: Checks if an entry is in the heap.
+ *
+ * Arguments: heap   A pointer to the heap.
+ *            id     The id of the entry.
+ *
+ * Returns: true if id is in the heap, false otherwise.
+ *
+ * Notes: O(1).
+ *********************************************************************************************************
+ */
+bool cds_indexed_heap_contains(const struct cds_indexed_heap *heap, size_t id);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                     CDS INDEXED HEAP DECREASE KEY
+ *
+ * Description: Gives an entry a priority that comes no later than its current one, moving it towards
+ *              the top.
+ *
+ * Arguments: heap       A pointer to the heap.
+ *            id         The id of the entry.
+ *            priority   A pointer to the new priority, which is copied.
+ *
+ * Returns: 0 on success, -1 on failure (e.g., if id is not in the heap or if cmp puts priority after
+ *          the current one, in which case nothing changes).
+ *
+ * Notes: O(log n), and only the entry's ancestors are compared, so it is cheaper than a pop and a
+ *        push. This is the relaxation step of Dijkstra's and Prim's algorithms. priority must not
+ *        point into the heap, e.g. at the result of cds_indexed_heap_priority.
+ *********************************************************************************************************
+ */
+int cds_indexed_heap_decrease_key(struct cds_indexed_heap *heap, size_t id, const void *priority);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                     CDS INDEXED HEAP INCREASE KEY
+ *
+ * Description: Gives an entry a priority that comes no earlier than its current one, moving it away
+ *              from the top.
+ *
+ * Arguments: heap       A pointer to the heap.
+ *            id         The id of the entry.
+ *            priority   A pointer to the new priority, which is copied.
+ *
+ * Returns: 0 on success, -1 on failure (e.g., if id is not in the heap or if cmp puts priority before
+ *          the current one, in which case nothing changes).
+ *
+ * Notes: O(log n). As for cds_indexed_heap_decrease_key, priority must not point into the heap.
+ *********************************************************************************************************
+ */
+int cds_indexed_heap_increase_key(struct cds_indexed_heap *heap, size_t id, const void *priority);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                        CDS INDEXED HEAP REMOVE
+ *
+ * Description: Removes an entry from the heap, wherever it is.
+ *
+ * Arguments: heap   A pointer to the heap.
+ *            id     The id of the entry.
+ *
+ * Returns: 0 on success, -1 if id is not in the heap.
+ *
+ * Notes: O(log n). The id can be pushed again afterwards.
+ *********************************************************************************************************
+ */
+int cds_indexed_heap_remove(struct cds_indexed_heap *heap, size_t id);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                         CDS INDEXED HEAP SIZE
+ *
+ * Description: Returns the number of entries in the heap.
+ *
+ * Arguments: heap   A pointer to the heap.
+ *
+ * Returns: The number of entries in the heap.
+ *
+ * Notes: none
+ *********************************************************************************************************
+ */
+size_t cds_indexed_heap_size(const struct cds_indexed_heap *heap);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                        CDS INDEXED HEAP EMPTY
+ *
+ * Description: Checks if the heap is empty.
+ *
+ * Arguments: heap   A pointer to the heap.
+ *
+ * Returns: true if the heap is empty, false otherwise.
+ *
+ * Notes: none
+ *********************************************************************************************************
+ */
+bool cds_indexed_heap_empty(const struct cds_indexed_heap *heap);
+
+#endif
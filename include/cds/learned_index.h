@@ -0,0 +1,166 @@
+#ifndef CDS_LEARNED_INDEX_H
+#define CDS_LEARNED_INDEX_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "allocator.h"
+#include "array.h"
+
+#ifndef CDS_LEARNED_INDEX_DEFAULT_EPSILON
+#define CDS_LEARNED_INDEX_DEFAULT_EPSILON 64
+#endif
+
+#define CDS_LEARNED_INDEX_INTERNAL_EPSILON 4
+#define CDS_LEARNED_INDEX_MAX_LEVELS 64
+
+// A line through (key, position) that predicts positions of the keys it covers within the error bound.
+struct cds_learned_segment {
+  uint64_t key;               // the first key the segment covers
+  double slope;
+  double intercept;           // the position of key
+};
+
+typedef struct cds_learned_index {
+  const uint64_t *keys;       // the elements of the indexed array, not owned
+  size_t size;
+  size_t epsilon;             // the error bound of the segments over the keys
+  struct cds_learned_segment *segments;  // all levels, the one over the keys first
+  size_t segment_count;
+  size_t levels;
+  size_t level_offset[CDS_LEARNED_INDEX_MAX_LEVELS + 1];  // first segment of each level, then the count
+  const struct cds_allocator *allocator;
+} CdsLearnedIndex;
+
+/*
+ *********************************************************************************************************
+ *
+ *                                         CDS LEARNED INDEX NEW
+ *
+ * Description: Builds a piecewise linear model of the positions of the keys in a sorted array of
+ *              uint64_t, so that a lookup only has to search a small window of the array.
+ *
+ * Arguments: sorted    A pointer to a struct cds_array of uint64_t sorted in ascending order.
+ *            epsilon   The maximum distance between a predicted and the actual position of a key, or 0
+ *                      for CDS_LEARNED_INDEX_DEFAULT_EPSILON.
+ *
+ * Returns: A newly created struct cds_learned_index instance. The segments field is NULL if memory
+ *          allocation fails or the arguments are invalid, which includes an array that is not sorted.
+ *
+ * Notes: The keys are covered by as few segments as a greedy fit within epsilon allows, and the
+ *        first keys of the segments are indexed the same way with CDS_LEARNED_INDEX_INTERNAL_EPSILON,
+ *        level by level up to a single segment (PGM-index). A lookup walks down the levels, each time
+ *        searching a window of 2 * epsilon + 2 positions around the prediction whose cache lines
+ *        are prefetched together, so each level costs about one memory access. The index takes 24
+ *        bytes per segment, from kilobytes to a few megabytes for ten million keys depending on how
+ *        regular they are; a larger epsilon gives fewer segments and longer final searches. The
+ *        index refers to the array's elements, which must not change or move while it is in use. The
+ *        caller is responsible for freeing the memory using cds_learned_index_delete.
+ *********************************************************************************************************
+ */
+struct cds_learned_index cds_learned_index_new(const struct cds_array *sorted, size_t epsilon);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                  CDS LEARNED INDEX NEW WITH ALLOCATOR
+ *
+ * Description: Same as cds_learned_index_new, with the segments taken from the given allocator.
+ *
+ * Arguments: sorted, epsilon   See cds_learned_index_new.
+ *            allocator         A pointer to the allocator, or NULL for cds_default_allocator.
+ *
+ * Returns: A newly created struct cds_learned_index instance. The segments field is NULL on failure.
+ *
+ * Notes: The allocator must outlive the index.
+ *********************************************************************************************************
+ */
+struct cds_learned_index cds_learned_index_new_with_allocator(const struct cds_array *sorted, size_t epsilon,
+                                                              const struct cds_allocator *allocator);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                        CDS LEARNED INDEX DELETE
+ *
+ * Description: Frees the memory used by the index.
+ *
+ * Arguments: index   A pointer to the index to be deleted.
+ *
+ * Returns: none
+ *
+ * Notes: The indexed array is not freed.
+ *********************************************************************************************************
+ */
+void cds_learned_index_delete(struct cds_learned_index *index);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                     CDS LEARNED INDEX LOWER BOUND
+ *
+ * Description: Finds the first key that is not less than key.
+ *
+ * Arguments: index   A pointer to the index.
+ *            key     The value to search for.
+ *
+ * Returns: The index of that key in the indexed array, or the size of the array if every key is less
+ *          than key.
+ *
+ * Notes: The result is exact for every key, including keys between or beyond the indexed ones and
+ *        runs of equal keys.
+ *********************************************************************************************************
+ */
+size_t cds_learned_index_lower_bound(const struct cds_learned_index *index, uint64_t key);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                       CDS LEARNED INDEX LOOKUP
+ *
+ * Description: Finds a key in the indexed array.
+ *
+ * Arguments: index   A pointer to the index.
+ *            key     The value to search for.
+ *
+ * Returns: A pointer to the first element equal to key, or NULL if there is none.
+ *
+ * Notes: none
+ *********************************************************************************************************
+ */
+const uint64_t *cds_learned_index_lookup(const struct cds_learned_index *index, uint64_t key);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                        CDS LEARNED INDEX SIZE
+ *
+ * Description: Returns the number of keys in the index.
+ *
+ * Arguments: index   A pointer to the index.
+ *
+ * Returns: The number of keys in the index.
+ *
+ * Notes: none
+ *********************************************************************************************************
+ */
+size_t cds_learned_index_size(const struct cds_learned_index *index);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                       CDS LEARNED INDEX EMPTY
+ *
+ * Description: Checks if the index is empty.
+ *
+ * Arguments: index   A pointer to the index.
+ *
+ * Returns: true if the index is empty, false otherwise.
+ *
+ * Notes: none
+ *********************************************************************************************************
+ */
+bool cds_learned_index_empty(const struct cds_learned_index *index);
+
+#endif
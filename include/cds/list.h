@@ -4,6 +4,8 @@
 #include <stddef.h>
 #include <stdbool.h>
 
+#include "allocator.h"
+
 typedef struct cds_list_node {
   void *data;
   struct cds_list_node *next, *prev;
@@ -27,6 +29,26 @@ typedef struct cds_list_node {
  */
 struct cds_list_node* cds_list_node_new(void *data, const size_t element_size);
 
+/*
+ *********************************************************************************************************
+ *
+ *                                    CDS LIST NODE NEW WITH ALLOCATOR
+ * 
+ * Description: Creates a new list node whose memory comes from the given allocator.
+ * 
+ * Arguments: data           A pointer to the data to be stored in the node.
+ *            element_size   The size of the data.
+ *            allocator      A pointer to the allocator, or NULL for cds_default_allocator.
+ *
+ * Returns: A newly created struct cds_list_node instance, or NULL if memory allocation fails.
+ * 
+ * Notes: The node must be released with cds_list_node_delete_with_allocator using the same allocator
+ *        and element size.
+ *********************************************************************************************************
+ */
+struct cds_list_node* cds_list_node_new_with_allocator(void *data, const size_t element_size,
+                                                       const struct cds_allocator *allocator);
+
 /*
  *********************************************************************************************************
  *
@@ -43,6 +65,25 @@ struct cds_list_node* cds_list_node_new(void *data, const size_t element_size);
  */
 void cds_list_node_delete(struct cds_list_node *node);
 
+/*
+ *********************************************************************************************************
+ *
+ *                                  CDS LIST NODE DELETE WITH ALLOCATOR
+ * 
+ * Description: Deletes a list node created by cds_list_node_new_with_allocator.
+ * 
+ * Arguments: node           A pointer to the struct cds_list_node instance to be deleted.
+ *            element_size   The size of the data stored in the node.
+ *            allocator      The allocator the node was created with.
+ *
+ * Returns: none
+ * 
+ * Notes: The caller is responsible for ensuring that the node pointer is valid.
+ *********************************************************************************************************
+ */
+void cds_list_node_delete_with_allocator(struct cds_list_node *node, const size_t element_size,
+                                         const struct cds_allocator *allocator);
+
 /*
  *********************************************************************************************************
  *
@@ -98,6 +139,7 @@ void cds_list_node_set_prev(struct cds_list_node *node, struct cds_list_node *pr
 typedef struct cds_list {
   struct cds_list_node *head, *tail;
   size_t size, element_size;
+  const struct cds_allocator *allocator;
 } CdsList;
 
 /*
@@ -116,6 +158,24 @@ typedef struct cds_list {
  */
 struct cds_list cds_list_new(const size_t element_size);
 
+/*
+ *********************************************************************************************************
+ *
+ *                                      CDS LIST NEW WITH ALLOCATOR
+ * 
+ * Description: Creates a new list whose nodes come from the given allocator.
+ * 
+ * Arguments: element_size   The size of each element in the list.
+ *            allocator      A pointer to the allocator, or NULL for cds_default_allocator.
+ *
+ * Returns: A newly created struct cds_list instance.
+ * 
+ * Notes: The allocator is referenced, not copied, and must outlive the list.
+ *********************************************************************************************************
+ */
+struct cds_list cds_list_new_with_allocator(const size_t element_size,
+                                            const struct cds_allocator *allocator);
+
 /*
  *********************************************************************************************************
  *
@@ -246,7 +306,8 @@ int cds_list_remove(struct cds_list *list, struct cds_list_node *position);
  * Returns: 0 on success, -1 on failure (e.g., invalid list pointers).
  * 
  * Notes: The caller is responsible for ensuring that the list pointers are valid. The second list will be
- *        emptied and its nodes will be appended to the first list.
+ *        emptied and its nodes will be appended to the first list. Both lists must use the same
+ *        allocator.
  *********************************************************************************************************
  */
 int cds_list_concat(struct cds_list *first, struct cds_list *second);
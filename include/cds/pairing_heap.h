@@ -0,0 +1,215 @@
+#ifndef CDS_PAIRING_HEAP_H
+#define CDS_PAIRING_HEAP_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "allocator.h"
+
+#ifndef CDS_PAIRING_HEAP_CHUNK_BYTES
+#define CDS_PAIRING_HEAP_CHUNK_BYTES 65536
+#endif
+
+// A node holds one element. Its children form a list starting at child and linked through next; prev
+// is the parent for the first child and the previous sibling otherwise. Free nodes are linked through
+// next. Handles to nodes stay valid until the node is popped, even across cds_pairing_heap_meld.
+typedef struct cds_pairing_heap_node {
+  struct cds_pairing_heap_node *child, *next, *prev;
+  char element[];
+} CdsPairingHeapNode;
+
+struct cds_pairing_heap_chunk;
+
+typedef struct cds_pairing_heap {
+  struct cds_pairing_heap_node *root;
+  size_t size, element_size, node_size;
+  int (*cmp)(const void *, const void *);
+  struct cds_pairing_heap_node *free_head, *free_tail;   // the node pool
+  struct cds_pairing_heap_chunk *chunks, *last_chunk;    // the blocks the pool is carved from
+  const struct cds_allocator *allocator;
+} CdsPairingHeap;
+
+/*
+ *********************************************************************************************************
+ *
+ *                                        CDS PAIRING HEAP NEW
+ *
+ * Description: Creates a new pairing heap, a heap of individually allocated nodes that can be melded
+ *              with another in O(1) and whose elements can be moved up in place through a handle.
+ *
+ * Arguments: element_size   The size of each element in the heap.
+ *            cmp            A pointer to a comparison function that determines the order of elements.
+ *
+ * Returns: A newly created struct cds_pairing_heap instance. No memory is allocated until the first
+ *          push.
+ *
+ * Notes: Nodes come from a pool owned by the heap: chunks of about CDS_PAIRING_HEAP_CHUNK_BYTES bytes
+ *        are carved into nodes, and popped nodes are reused, so a push usually costs no allocator
+ *        call. Chunks are only returned by cds_pairing_heap_delete. Elements are aligned to 8 bytes.
+ *        The caller is responsible for freeing the memory using cds_pairing_heap_delete.
+ *********************************************************************************************************
+ */
+struct cds_pairing_heap cds_pairing_heap_new(size_t element_size, int (*cmp)(const void *, const void *));
+
+/*
+ *********************************************************************************************************
+ *
+ *                                  CDS PAIRING HEAP NEW WITH ALLOCATOR
+ *
+ * Description: Same as cds_pairing_heap_new, with the pool's chunks taken from the given allocator.
+ *
+ * Arguments: element_size, cmp   See cds_pairing_heap_new.
+ *            allocator           A pointer to the allocator, or NULL for cds_default_allocator.
+ *
+ * Returns: A newly created struct cds_pairing_heap instance.
+ *
+ * Notes: The allocator is referenced, not copied, and must outlive the heap.
+ *********************************************************************************************************
+ */
+struct cds_pairing_heap cds_pairing_heap_new_with_allocator(size_t element_size,
+                                                            int (*cmp)(const void *, const void *),
+                                                            const struct cds_allocator *allocator);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                       CDS PAIRING HEAP DELETE
+ *
+ * Description: Deletes the heap and frees the memory allocated for it.
+ *
+ * Arguments: heap   A pointer to the heap to be deleted.
+ *
+ * Returns: None.
+ *
+ * Notes: Costs one free per chunk, not per node. Every handle into the heap becomes invalid.
+ *********************************************************************************************************
+ */
+void cds_pairing_heap_delete(struct cds_pairing_heap *heap);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                        CDS PAIRING HEAP PUSH
+ *
+ * Description: Inserts a new element into the heap.
+ *
+ * Arguments: heap          A pointer to the heap.
+ *            new_element   A pointer to the new element to be inserted.
+ *
+ * Returns: A handle to the node holding the element, or NULL if memory allocation fails.
+ *
+ * Notes: O(1): the node is taken from the pool and linked with the root using one comparison. The
+ *        element is copied, so it must not point into the heap itself. The handle is only needed for
+ *        cds_pairing_heap_decrease_key and may be ignored.
+ *********************************************************************************************************
+ */
+struct cds_pairing_heap_node* cds_pairing_heap_push(struct cds_pairing_heap *heap, const void *new_element);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                        CDS PAIRING HEAP POP
+ *
+ * Description: Removes the top element from the heap.
+ *
+ * Arguments: heap   A pointer to the heap.
+ *
+ * Returns: 0 on success, -1 if the heap is empty.
+ *
+ * Notes: Amortized O(log n). The children of the root are linked in pairs from left to right, then the
+ *        pairs from right to left. The node goes back to the pool and its handle becomes invalid.
+ *********************************************************************************************************
+ */
+int cds_pairing_heap_pop(struct cds_pairing_heap *heap);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                        CDS PAIRING HEAP TOP
+ *
+ * Description: Retrieves the top element of the heap without removing it.
+ *
+ * Arguments: heap   A pointer to the heap.
+ *
+ * Returns: A pointer to the top element, or NULL if the heap is empty.
+ *
+ * Notes: O(1). heap->root is the handle of the same node.
+ *********************************************************************************************************
+ */
+void* cds_pairing_heap_top(const struct cds_pairing_heap *heap);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                        CDS PAIRING HEAP MELD
+ *
+ * Description: Moves every element of other into heap.
+ *
+ * Arguments: heap    A pointer to the heap that receives the elements.
+ *            other   A pointer to the heap to be emptied.
+ *
+ * Returns: 0 on success, -1 on failure (e.g., if the heaps have different element sizes, comparison
+ *          functions or allocators, or are the same heap).
+ *
+ * Notes: O(1): the two roots are linked with one comparison, and other's pool, free nodes included, is
+ *        spliced into heap's, so no node is copied or reallocated. Handles into other stay valid and
+ *        now belong to heap. other is left empty and can still be used or deleted.
+ *********************************************************************************************************
+ */
+int cds_pairing_heap_meld(struct cds_pairing_heap *heap, struct cds_pairing_heap *other);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                    CDS PAIRING HEAP DECREASE KEY
+ *
+ * Description: Replaces the element of a node with one that comes no later, moving it towards the top.
+ *
+ * Arguments: heap      A pointer to the heap.
+ *            node      A handle to a node in the heap, as returned by cds_pairing_heap_push.
+ *            element   A pointer to the new element, which is copied.
+ *
+ * Returns: 0 on success, -1 if cmp puts element after the node's current element, in which case
+ *          nothing changes.
+ *
+ * Notes: The node's subtree is cut from its parent and linked with the root in O(1); counting the work
+ *        it adds to later pops, the amortized cost is below O(log n). element must not point into the
+ *        heap.
+ *********************************************************************************************************
+ */
+int cds_pairing_heap_decrease_key(struct cds_pairing_heap *heap, struct cds_pairing_heap_node *node,
+                                  const void *element);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                        CDS PAIRING HEAP SIZE
+ *
+ * Description: Returns the number of elements in the heap.
+ *
+ * Arguments: heap   A pointer to the heap.
+ *
+ * Returns: The number of elements in the heap.
+ *
+ * Notes: None.
+ *********************************************************************************************************
+ */
+size_t cds_pairing_heap_size(const struct cds_pairing_heap *heap);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                        CDS PAIRING HEAP EMPTY
+ *
+ * Description: Checks if the heap is empty.
+ *
+ * Arguments: heap   A pointer to the heap.
+ *
+ * Returns: true if the heap is empty, false otherwise.
+ *
+ * Notes: None.
+ *********************************************************************************************************
+ */
+bool cds_pairing_heap_empty(const struct cds_pairing_heap *heap);
+
+#endif
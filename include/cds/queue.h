@@ -4,6 +4,8 @@
 #include <stddef.h>
 #include <stdbool.h>
 
+#include "allocator.h"
+
 #define CDS_QUEUE_IMPL_WITH_ARRAY
 
 #ifdef CDS_QUEUE_IMPL_WITH_ARRAY
@@ -11,6 +13,7 @@
 typedef struct cds_queue {
   char *data;
   size_t size, capacity, element_size, front;
+  const struct cds_allocator *allocator;
 } CdsQueue;
 
 #else
@@ -23,6 +26,7 @@ static struct cds_queue_node {
 typedef struct cds_queue {
   struct cds_queue_node *head, *tail;
   size_t size, element_size;
+  const struct cds_allocator *allocator;
 } CdsQueue;
 
 #endif
@@ -44,6 +48,25 @@ typedef struct cds_queue {
  */
 struct cds_queue cds_queue_new(const size_t element_size);
 
+/*
+ *********************************************************************************************************
+ *
+ *                                      CDS QUEUE NEW WITH ALLOCATOR
+ * 
+ * Description: Creates a new queue whose storage comes from the given allocator.
+ * 
+ * Arguments: element_size   The size of each element in the queue.
+ *            allocator      A pointer to the allocator, or NULL for cds_default_allocator.
+ *
+ * Returns: A newly created struct cds_queue instance. The data field can be NULL if memory allocation
+ *          fails.
+ * 
+ * Notes: The allocator is referenced, not copied, and must outlive the queue.
+ *********************************************************************************************************
+ */
+struct cds_queue cds_queue_new_with_allocator(const size_t element_size,
+                                              const struct cds_allocator *allocator);
+
 /*
  *********************************************************************************************************
  *
@@ -0,0 +1,173 @@
+#ifndef CDS_RADIX_HEAP_H
+#define CDS_RADIX_HEAP_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "array.h"
+#include "sort.h"
+
+#define CDS_RADIX_HEAP_BUCKETS 65
+
+// Bucket 0 holds the entries whose key equals last; bucket b > 0 holds those whose key first differs
+// from last in bit b - 1. Each entry is its key followed by the element, padded to a
+// multiple of 8 bytes. Every key in the heap is at least last.
+typedef struct cds_radix_heap {
+  struct cds_array buckets[CDS_RADIX_HEAP_BUCKETS];
+  uint64_t last;              // the last key popped, or the top's once bucket 0 is refilled
+  uint64_t occupied;          // bit b - 1 is set when bucket b > 0 is not empty
+  size_t size;
+  size_t element_size;
+  cds_key_func key;
+} CdsRadixHeap;
+
+/*
+ *********************************************************************************************************
+ *
+ *                                          CDS RADIX HEAP NEW
+ *
+ * Description: Creates a new min-heap of elements ordered by an unsigned integer key, for use when
+ *              the keys popped never decrease, as in event simulation and shortest paths.
+ *
+ * Arguments: element_size   The size of each element in the heap.
+ *            key            A function returning the key of an element. Keys of uint32_t widen to
+ *                           uint64_t unchanged.
+ *
+ * Returns: A newly created struct cds_radix_heap instance. The data field of buckets[0] is NULL if
+ *          memory allocation fails.
+ *
+ * Notes: A push costs one key call and one append, with no comparisons. When the top is popped and no
+ *        element with the same key is left, the lowest nonempty bucket is scanned for its smallest key
+ *        and its entries spread over lower buckets. Each element moves down at most 64 times, so pop is
+ *        amortized O(log C), where C is the spread of the keys in the heap, and unlike cds_heap no
+ *        comparator is called. The caller is responsible for freeing the memory using
+ *        cds_radix_heap_delete.
+ *********************************************************************************************************
+ */
+struct cds_radix_heap cds_radix_heap_new(size_t element_size, cds_key_func key);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                   CDS RADIX HEAP NEW WITH ALLOCATOR
+ *
+ * Description: Same as cds_radix_heap_new, with the storage taken from the given allocator.
+ *
+ * Arguments: element_size, key   See cds_radix_heap_new.
+ *            allocator           A pointer to the allocator, or NULL for cds_default_allocator.
+ *
+ * Returns: A newly created struct cds_radix_heap instance. The data field of buckets[0] is NULL if
+ *          memory allocation fails.
+ *
+ * Notes: The allocator is referenced, not copied, and must outlive the heap.
+ *********************************************************************************************************
+ */
+struct cds_radix_heap cds_radix_heap_new_with_allocator(size_t element_size, cds_key_func key,
+                                                        const struct cds_allocator *allocator);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                         CDS RADIX HEAP DELETE
+ *
+ * Description: Deletes the heap and frees the memory allocated for it.
+ *
+ * Arguments: heap   A pointer to the heap to be deleted.
+ *
+ * Returns: None.
+ *
+ * Notes: The heap pointer should not be used after calling this function.
+ *********************************************************************************************************
+ */
+void cds_radix_heap_delete(struct cds_radix_heap *heap);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                          CDS RADIX HEAP PUSH
+ *
+ * Description: Inserts a new element into the heap.
+ *
+ * Arguments: heap          A pointer to the heap.
+ *            new_element   A pointer to the new element to be inserted.
+ *
+ * Returns: 0 on success, -1 on failure (e.g., if the key of new_element is smaller than heap->last,
+ *          memory allocation failure, or a heap that failed to be created).
+ *
+ * Notes: heap->last is the key of the last element popped, so a key smaller than every one in the heap
+ *        is accepted as long as it is not smaller than that, until cds_radix_heap_top or
+ *        cds_radix_heap_pop raises heap->last to the current top's. The new element is copied into
+ *        the heap, so it must not point into the heap itself.
+ *********************************************************************************************************
+ */
+int cds_radix_heap_push(struct cds_radix_heap *heap, const void *new_element);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                          CDS RADIX HEAP POP
+ *
+ * Description: Removes the top element from the heap.
+ *
+ * Arguments: heap   A pointer to the heap.
+ *
+ * Returns: 0 on success, -1 on failure (e.g., if the heap is empty, or if memory allocation fails while
+ *          redistributing a bucket, in which case the heap is unchanged).
+ *
+ * Notes: Elements with equal keys come out in no particular order.
+ *********************************************************************************************************
+ */
+int cds_radix_heap_pop(struct cds_radix_heap *heap);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                          CDS RADIX HEAP TOP
+ *
+ * Description: Retrieves the element with the smallest key without removing it.
+ *
+ * Arguments: heap   A pointer to the heap.
+ *
+ * Returns: A pointer to the top element, or NULL if the heap is empty or if memory allocation fails.
+ *
+ * Notes: Unlike cds_heap_top, this may modify the heap: if bucket 0 is empty, the lowest nonempty
+ *        bucket is redistributed first. Afterwards the key of the top element is heap->last. The
+ *        pointer is valid until the heap is next modified.
+ *********************************************************************************************************
+ */
+void* cds_radix_heap_top(struct cds_radix_heap *heap);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                          CDS RADIX HEAP SIZE
+ *
+ * Description: Returns the number of elements in the heap.
+ *
+ * Arguments: heap   A pointer to the heap.
+ *
+ * Returns: The number of elements in the heap.
+ *
+ * Notes: None.
+ *********************************************************************************************************
+ */
+size_t cds_radix_heap_size(const struct cds_radix_heap *heap);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                          CDS RADIX HEAP EMPTY
+ *
+ * Description: Checks if the heap is empty.
+ *
+ * Arguments: heap   A pointer to the heap.
+ *
+ * Returns: true if the heap is empty, false otherwise.
+ *
+ * Notes: None.
+ *********************************************************************************************************
+ */
+bool cds_radix_heap_empty(const struct cds_radix_heap *heap);
+
+#endif
@@ -0,0 +1,165 @@
+#ifndef CDS_SEARCH_LAYOUT_H
+#define CDS_SEARCH_LAYOUT_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "allocator.h"
+#include "array.h"
+
+#define CDS_SEARCH_LAYOUT_MAX_LAYERS 64
+
+enum cds_search_layout_type {
+  CDS_SEARCH_LAYOUT_EYTZINGER,
+  CDS_SEARCH_LAYOUT_BTREE
+};
+
+typedef struct cds_search_layout {
+  enum cds_search_layout_type type;
+  char *data;                 // the elements in layout order, 64-byte aligned
+  size_t size, element_size;
+  size_t node_keys;           // B-tree: elements per node
+  size_t layers;              // B-tree: number of layers, the leaves included
+  size_t layer_offset[CDS_SEARCH_LAYOUT_MAX_LAYERS];  // B-tree: first element of each layer, leaves at 0
+  cds_cmp_func cmp;
+  void *block;                // the allocation data points into
+  size_t block_size;
+  const struct cds_allocator *allocator;
+} CdsSearchLayout;
+
+/*
+ *********************************************************************************************************
+ *
+ *                                         CDS SEARCH LAYOUT NEW
+ *
+ * Description: Copies a sorted array into a read-only layout that is faster to search than the array
+ *              itself once it no longer fits in cache.
+ *
+ * Arguments: sorted   A pointer to a struct cds_array sorted in ascending order by cmp.
+ *            type     CDS_SEARCH_LAYOUT_EYTZINGER or CDS_SEARCH_LAYOUT_BTREE.
+ *            cmp      A pointer to the comparison function the array is sorted by.
+ *
+ * Returns: A newly created struct cds_search_layout instance. The data field is NULL if memory
+ *          allocation fails or the arguments are invalid.
+ *
+ * Notes: The Eytzinger layout stores the elements in breadth-first order of the implicit binary search
+ *        tree, so the first levels share a few cache lines and a search prefetches the line holding
+ *        the descendants four levels down (for elements of up to 16 bytes). The B-tree layout stores
+ *        the sorted elements in nodes of one or two cache lines, with the node separators above them
+ *        in a static B+ tree, so a search touches one node per level. Both take about the memory of
+ *        the array (the B-tree a few percent more), and both are searched without branches on the
+ *        comparison results. With cds_cmp_i32 or cds_cmp_i64 as cmp the comparisons are inlined. The
+ *        sorted array is not referenced afterwards. The caller is responsible for freeing the memory
+ *        using cds_search_layout_delete.
+ *********************************************************************************************************
+ */
+struct cds_search_layout cds_search_layout_new(const struct cds_array *sorted,
+                                               enum cds_search_layout_type type, cds_cmp_func cmp);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                  CDS SEARCH LAYOUT NEW WITH ALLOCATOR
+ *
+ * Description: Same as cds_search_layout_new, with the storage taken from the given allocator.
+ *
+ * Arguments: sorted, type, cmp   See cds_search_layout_new.
+ *            allocator           A pointer to the allocator, or NULL for cds_default_allocator.
+ *
+ * Returns: A newly created struct cds_search_layout instance. The data field is NULL on failure.
+ *
+ * Notes: An aligned allocator with CDS_ALLOCATOR_HUGE_PAGES keeps large layouts on 2 MB pages, which
+ *        removes most TLB misses from the search. The allocator must outlive the layout.
+ *********************************************************************************************************
+ */
+struct cds_search_layout cds_search_layout_new_with_allocator(const struct cds_array *sorted,
+                                                              enum cds_search_layout_type type,
+                                                              cds_cmp_func cmp,
+                                                              const struct cds_allocator *allocator);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                       CDS SEARCH LAYOUT DELETE
+ *
+ * Description: Frees the memory used by the layout.
+ *
+ * Arguments: layout   A pointer to the layout to be deleted.
+ *
+ * Returns: none
+ *
+ * Notes: none
+ *********************************************************************************************************
+ */
+void cds_search_layout_delete(struct cds_search_layout *layout);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                    CDS SEARCH LAYOUT LOWER BOUND
+ *
+ * Description: Finds the first element that is not less than key.
+ *
+ * Arguments: layout   A pointer to the layout.
+ *            key      A pointer to the value to search for.
+ *
+ * Returns: The index of that element in the sorted array the layout was built from, or the size of
+ *          the layout if every element is less than key.
+ *
+ * Notes: The index refers to the original sorted array, so it can be used to look up associated data
+ *        kept in sorted order.
+ *********************************************************************************************************
+ */
+size_t cds_search_layout_lower_bound(const struct cds_search_layout *layout, const void *key);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                    CDS SEARCH LAYOUT UPPER BOUND
+ *
+ * Description: Finds the first element that is greater than key.
+ *
+ * Arguments: layout   A pointer to the layout.
+ *            key      A pointer to the value to search for.
+ *
+ * Returns: The index of that element in the sorted array the layout was built from, or the size of
+ *          the layout if no element is greater than key.
+ *
+ * Notes: The elements equal to key are at the indices [lower bound, upper bound).
+ *********************************************************************************************************
+ */
+size_t cds_search_layout_upper_bound(const struct cds_search_layout *layout, const void *key);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                        CDS SEARCH LAYOUT SIZE
+ *
+ * Description: Returns the number of elements in the layout.
+ *
+ * Arguments: layout   A pointer to the layout.
+ *
+ * Returns: The number of elements in the layout.
+ *
+ * Notes: none
+ *********************************************************************************************************
+ */
+size_t cds_search_layout_size(const struct cds_search_layout *layout);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                       CDS SEARCH LAYOUT EMPTY
+ *
+ * Description: Checks if the layout is empty.
+ *
+ * Arguments: layout   A pointer to the layout.
+ *
+ * Returns: true if the layout is empty, false otherwise.
+ *
+ * Notes: none
+ *********************************************************************************************************
+ */
+bool cds_search_layout_empty(const struct cds_search_layout *layout);
+
+#endif
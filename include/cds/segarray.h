@@ -0,0 +1,191 @@
+#ifndef CDS_SEGARRAY_H
+#define CDS_SEGARRAY_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "allocator.h"
+
+#ifndef CDS_SEGARRAY_CHUNK_BYTES
+#define CDS_SEGARRAY_CHUNK_BYTES 65536
+#endif
+
+typedef struct cds_segarray {
+  char **chunks;
+  size_t size, chunk_count, directory_capacity, element_size;
+  size_t chunk_shift, chunk_mask;
+  const struct cds_allocator *allocator;
+} CdsSegarray;
+
+/*
+ *********************************************************************************************************
+ *
+ *                                           CDS SEGARRAY NEW
+ * 
+ * Description: Creates a new segmented array with the specified element size.
+ * 
+ * Arguments: element_size   The size of each element in the array.
+ *
+ * Returns: A newly created struct cds_segarray instance. No chunk is allocated until the first push.
+ * 
+ * Notes: Elements live in fixed-size chunks of about CDS_SEGARRAY_CHUNK_BYTES bytes, rounded down to a
+ *        power-of-two element count (at least one element). Chunks are never moved, so pointers
+ *        returned by cds_segarray_at stay valid until the element is popped. The caller is
+ *        responsible for freeing the memory using cds_segarray_delete.
+ *********************************************************************************************************
+ */
+struct cds_segarray cds_segarray_new(size_t element_size);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                    CDS SEGARRAY NEW WITH ALLOCATOR
+ * 
+ * Description: Creates a new segmented array whose chunks come from the given allocator.
+ * 
+ * Arguments: element_size   The size of each element in the array.
+ *            allocator      A pointer to the allocator, or NULL for cds_default_allocator.
+ *
+ * Returns: A newly created struct cds_segarray instance.
+ * 
+ * Notes: The allocator is referenced, not copied, and must outlive the array.
+ *********************************************************************************************************
+ */
+struct cds_segarray cds_segarray_new_with_allocator(size_t element_size,
+                                                    const struct cds_allocator *allocator);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                          CDS SEGARRAY DELETE
+ * 
+ * Description: Frees every chunk and the chunk directory of the segmented array.
+ * 
+ * Arguments: array   A pointer to the struct cds_segarray instance to be deleted.
+ *
+ * Returns: none
+ * 
+ * Notes: The caller should ensure that the array pointer is not NULL before calling this function.
+ *********************************************************************************************************
+ */
+void cds_segarray_delete(struct cds_segarray *array);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                        CDS SEGARRAY PUSH BACK
+ * 
+ * Description: Adds a new element to the end of the segmented array.
+ * 
+ * Arguments: array         A pointer to the struct cds_segarray instance.
+ *            new_element   A pointer to the element to be added to the array.
+ *
+ * Returns: 0 on success, -1 on failure (e.g., if memory allocation fails).
+ * 
+ * Notes: Growth allocates one new chunk and, rarely, grows the directory of chunk pointers. Existing
+ *        elements are never copied.
+ *********************************************************************************************************
+ */
+int cds_segarray_push_back(struct cds_segarray *array, const void *new_element);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                       CDS SEGARRAY EMPLACE BACK
+ * 
+ * Description: Appends an uninitialized slot to the end of the segmented array.
+ * 
+ * Arguments: array   A pointer to the struct cds_segarray instance.
+ *
+ * Returns: A pointer to the new slot, or NULL if memory allocation fails.
+ * 
+ * Notes: The pointer stays valid until the element is popped.
+ *********************************************************************************************************
+ */
+void* cds_segarray_emplace_back(struct cds_segarray *array);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                        CDS SEGARRAY POP BACK
+ * 
+ * Description: Removes the last element from the segmented array.
+ * 
+ * Arguments: array   A pointer to the struct cds_segarray instance.
+ *
+ * Returns: 0 on success, -1 on failure (e.g., if the array is already empty).
+ * 
+ * Notes: Whole chunks are returned to the allocator once they are empty. One empty chunk is kept as
+ *        a spare so that alternating push and pop at a chunk boundary does not thrash.
+ *********************************************************************************************************
+ */
+int cds_segarray_pop_back(struct cds_segarray *array);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                           CDS SEGARRAY AT
+ * 
+ * Description: Returns a pointer to the element at the specified index in the segmented array.
+ * 
+ * Arguments: array   A pointer to the struct cds_segarray instance.
+ *            index   The index of the element to be accessed.
+ *
+ * Returns: A pointer to the element at the specified index, or NULL if the index is out of bounds.
+ * 
+ * Notes: none
+ *********************************************************************************************************
+ */
+void* cds_segarray_at(const struct cds_segarray *array, size_t index);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                           CDS SEGARRAY GET
+ * 
+ * Description: Returns a pointer to the element at the specified index in the segmented array.
+ * 
+ * Arguments: array   A pointer to the struct cds_segarray instance.
+ *            index   The index of the element to be accessed.
+ *
+ * Returns: A pointer to the element at the specified index.
+ * 
+ * Notes: The caller should ensure that the index is within the bounds of the array. The lookup is a
+ *        shift and a mask into the chunk directory.
+ *********************************************************************************************************
+ */
+void* cds_segarray_get(const struct cds_segarray *array, size_t index);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                          CDS SEGARRAY SIZE
+ * 
+ * Description: Returns the number of elements in the segmented array.
+ * 
+ * Arguments: array   A pointer to the struct cds_segarray instance.
+ *
+ * Returns: The number of elements in the array.
+ * 
+ * Notes: none
+ *********************************************************************************************************
+ */
+size_t cds_segarray_size(const struct cds_segarray *array);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                          CDS SEGARRAY EMPTY
+ * 
+ * Description: Checks if the segmented array is empty.
+ * 
+ * Arguments: array   A pointer to the struct cds_segarray instance.
+ *
+ * Returns: true if the array is empty, false otherwise.
+ * 
+ * Notes: none
+ *********************************************************************************************************
+ */
+bool cds_segarray_empty(const struct cds_segarray *array);
+
+#endif
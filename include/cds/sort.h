@@ -1,25 +1,281 @@
 #ifndef CDS_SORT_H
 #define CDS_SORT_H
 
+#include <stdint.h>
+
 #include "cds/array.h"
 
+#define CDS_SORT_RADIX_UNSIGNED   0x0
+#define CDS_SORT_RADIX_SIGNED     0x1
+#define CDS_SORT_RADIX_FLOAT      0x2
+#define CDS_SORT_RADIX_DESCENDING 0x4
+
+#ifndef CDS_SORT_PARALLEL_THRESHOLD
+#define CDS_SORT_PARALLEL_THRESHOLD 65536
+#endif
+
+#ifndef CDS_SORT_PARALLEL_MAX_THREADS
+#define CDS_SORT_PARALLEL_MAX_THREADS 256
+#endif
+
+#ifndef CDS_EXTERNAL_SORT_DEFAULT_BUDGET
+#define CDS_EXTERNAL_SORT_DEFAULT_BUDGET (64 * 1024 * 1024)
+#endif
+
+#define CDS_SORT_SMALL_MAX 16
+
+typedef uint64_t (*cds_key_func)(const void *element);
+
 /*
  *********************************************************************************************************
  *
  *                                            CDS ARRAY SORT
  *
- * Description: Sorts the elements of the dynamic array using the Introsort algorithm.
+ * Description: Sorts the elements of the dynamic array using pattern-defeating quicksort (pdqsort).
  *
  * Arguments: array   A pointer to the struct cds_array instance to be sorted.
  *            cmp     A pointer to a comparison function.
  *
  * Returns: none
  *
- * Notes: The array is sorted in place.
+ * Notes: The array is sorted in place and the sort is not stable. Pivots are the median of 3, or
+ *        Tukey's ninther for larger ranges, and partitioning is done in branch-free blocks. Runs of
+ *        elements equal to an earlier pivot are split off without being sorted again, sorted and
+ *        reverse-sorted input finish in O(n), and repeated bad partitions fall back to heap sort so
+ *        the worst case stays O(n log n). Elements larger than 256 bytes need one heap allocation
+ *        per call; if it fails the array is left unsorted.
  *********************************************************************************************************
  */
 void cds_array_sort(struct cds_array *array, cds_cmp_func cmp);
 
+/*
+ *********************************************************************************************************
+ *
+ *                                         CDS ARRAY NTH ELEMENT
+ *
+ * Description: Moves the element that would be at index nth if the array were sorted to index nth,
+ *              with no greater element before it and no smaller element after it.
+ *
+ * Arguments: array   A pointer to the struct cds_array instance.
+ *            nth     The index to select.
+ *            cmp     A pointer to a comparison function.
+ *
+ * Returns: 0 on success, -1 on failure (e.g., if nth is out of range or if memory allocation fails).
+ *
+ * Notes: Introselect: quickselect with the pivots and block partitioning of cds_array_sort, O(n) on
+ *        average. After log2(n) unbalanced partitions it falls back to median-of-medians, so the worst
+ *        case is O(n) as well. The order within each side is unspecified.
+ *********************************************************************************************************
+ */
+int cds_array_nth_element(struct cds_array *array, size_t nth, cds_cmp_func cmp);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                         CDS ARRAY PARTIAL SORT
+ *
+ * Description: Moves the k smallest elements to the front of the array in sorted order.
+ *
+ * Arguments: array   A pointer to the struct cds_array instance.
+ *            k       The number of elements to sort. Larger values sort the whole array.
+ *            cmp     A pointer to a comparison function.
+ *
+ * Returns: 0 on success, -1 on failure (e.g., if memory allocation fails).
+ *
+ * Notes: Selects the k-th element with cds_array_nth_element and sorts the part before it, which costs
+ *        O(n + k log k). The order of the remaining elements is unspecified.
+ *********************************************************************************************************
+ */
+int cds_array_partial_sort(struct cds_array *array, size_t k, cds_cmp_func cmp);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                           CDS ARRAY TOP K
+ *
+ * Description: Copies the k largest elements of the array to out, largest first.
+ *
+ * Arguments: array   A pointer to the struct cds_array instance. It is not modified.
+ *            k       The number of elements to return. Larger values return every element.
+ *            cmp     A pointer to a comparison function. Pass a reversed one for the k smallest.
+ *            out     A pointer to an array with the same element size; its contents are replaced.
+ *
+ * Returns: 0 on success, -1 on failure (e.g., mismatched element sizes or if memory allocation fails).
+ *
+ * Notes: One pass over the array keeping the best k elements in a cds_heap, O(n log k) time and O(k)
+ *        extra memory. Unlike cds_array_partial_sort it does not reorder the input, and it is the
+ *        cheaper choice when k is much smaller than n.
+ *********************************************************************************************************
+ */
+int cds_array_top_k(const struct cds_array *array, size_t k, cds_cmp_func cmp, struct cds_array *out);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                         CDS ARRAY SORT STABLE
+ *
+ * Description: Sorts the elements of the dynamic array, keeping elements that compare equal in their
+ *              original order.
+ *
+ * Arguments: array      A pointer to the struct cds_array instance to be sorted.
+ *            cmp        A pointer to a comparison function.
+ *
+ * Returns: 0 on success, -1 on failure (e.g., if memory allocation fails).
+ *
+ * Notes: A TimSort-style merge sort. Ascending and strictly descending runs already present in the
+ *        input are detected and used as they are, short runs are extended with binary insertion sort,
+ *        and runs are merged with galloping. Sorted or reverse-sorted input takes n - 1 comparisons
+ *        and allocates nothing; otherwise one scratch buffer of n / 2 + 1 elements is allocated once
+ *        for the whole sort. On failure the array holds a permutation of its elements.
+ *********************************************************************************************************
+ */
+int cds_array_sort_stable(struct cds_array *array, cds_cmp_func cmp);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                        CDS ARRAY SORT PARALLEL
+ *
+ * Description: Sorts the elements of the dynamic array on several threads.
+ *
+ * Arguments: array      A pointer to the struct cds_array instance to be sorted.
+ *            cmp        A pointer to a comparison function. It must be safe to call concurrently.
+ *            nthreads   The number of threads to use, or 0 for the number of online processors.
+ *
+ * Returns: 0 on success, -1 on failure (e.g., if memory allocation fails).
+ *
+ * Notes: The array is cut into one run per thread, each run is sorted with cds_array_sort, and the
+ *        runs are merged pairwise through one scratch buffer. Every merge is split across the threads
+ *        by co-ranking, so the final merges stay parallel. Each thread gets at least
+ *        CDS_SORT_PARALLEL_THRESHOLD elements; smaller arrays are sorted serially. The resulting
+ *        order is the same sorted order cds_array_sort produces, but elements that compare equal may
+ *        end up in a different relative order. If a thread cannot be started its work runs on the
+ *        calling thread.
+ *********************************************************************************************************
+ */
+int cds_array_sort_parallel(struct cds_array *array, cds_cmp_func cmp, size_t nthreads);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                          CDS ARRAY SORT RADIX
+ *
+ * Description: Sorts the elements of the dynamic array by a fixed-width key using LSD radix sort.
+ *
+ * Arguments: array        A pointer to the struct cds_array instance to be sorted.
+ *            key_offset   The byte offset of the key inside each element.
+ *            key_width    The width of the key in bytes: 1, 2, 4 or 8.
+ *            flags        CDS_SORT_RADIX_UNSIGNED (default), CDS_SORT_RADIX_SIGNED for two's complement
+ *                         integers or CDS_SORT_RADIX_FLOAT for IEEE-754 float (width 4) and double
+ *                         (width 8), optionally OR'ed with CDS_SORT_RADIX_DESCENDING.
+ *
+ * Returns: 0 on success, -1 on failure (e.g., invalid key width or if memory allocation fails).
+ *
+ * Notes: The sort is stable. All byte histograms are built in one pass, and a byte position where
+ *        every key has the same value is skipped. One scratch buffer the size of the array is
+ *        allocated per call. Keys are read in native (little-endian) byte order. Float keys order
+ *        -0.0 before +0.0 and NaNs by their bit pattern.
+ *********************************************************************************************************
+ */
+int cds_array_sort_radix(struct cds_array *array, size_t key_offset, size_t key_width, int flags);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                         CDS ARRAY SORT BY KEY
+ *
+ * Description: Sorts the elements of the dynamic array by a 64-bit key extracted from each element.
+ *
+ * Arguments: array   A pointer to the struct cds_array instance to be sorted.
+ *            key     A pointer to a function that returns the key of an element. Keys are compared as
+ *                    uint64_t.
+ *
+ * Returns: 0 on success, -1 on failure (e.g., invalid arguments or if memory allocation fails, in which
+ *          case the array is left unchanged).
+ *
+ * Notes: The sort is stable. key is called once per element, and the (key, index) pairs are radix
+ *        sorted: one pass splits them by the highest byte in which keys differ, and each part is
+ *        finished in cache. The elements are then moved to their places in place by following the
+ *        cycles of the permutation, each exactly once. This beats a comparison sort when elements
+ *        are large or cmp is costly. The pairs take 32 bytes per element of temporary memory. A
+ *        signed key orders correctly once its sign bit is flipped, a double once its bits are
+ *        inverted if negative and its sign bit set otherwise.
+ *********************************************************************************************************
+ */
+int cds_array_sort_by_key(struct cds_array *array, cds_key_func key);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                           CDS ARRAY ARGSORT
+ *
+ * Description: Computes the permutation that would sort the elements of the dynamic array by a 64-bit
+ *              key, without moving them.
+ *
+ * Arguments: array   A pointer to the struct cds_array instance.
+ *            key     A pointer to a function that returns the key of an element, as for
+ *                    cds_array_sort_by_key.
+ *            out     A pointer to a struct cds_array of size_t that receives the permutation. Its
+ *                    previous contents are replaced.
+ *
+ * Returns: 0 on success, -1 on failure (e.g., invalid arguments, out not holding size_t, or if memory
+ *          allocation fails).
+ *
+ * Notes: Element i of the sorted order is the element at index out[i] of array; equal keys keep
+ *        their relative order. See cds_array_sort_by_key.
+ *********************************************************************************************************
+ */
+int cds_array_argsort(const struct cds_array *array, cds_key_func key, struct cds_array *out);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                           CDS EXTERNAL SORT
+ *
+ * Description: Sorts a file of fixed-size records that may be much larger than memory.
+ *
+ * Arguments: in_path        The path of the file to be sorted.
+ *            out_path       The path the sorted records are written to. It may be the same as in_path.
+ *            element_size   The size of each record in bytes.
+ *            cmp            A pointer to a comparison function.
+ *            mem_budget     The number of bytes of memory to use, or 0 for
+ *                           CDS_EXTERNAL_SORT_DEFAULT_BUDGET.
+ *
+ * Returns: 0 on success, -1 on failure (e.g., if a file cannot be read or written, the input size is
+ *          not a multiple of element_size, or if memory allocation fails).
+ *
+ * Notes: Input that fits in mem_budget is sorted in memory with cds_array_sort. Larger input is cut
+ *        into mem_budget-sized runs, each sorted with cds_array_sort and written to a temporary file,
+ *        and the runs are merged with a loser tree. Every run and the output get two buffers, one
+ *        being merged while a background thread reads or writes the other; when the budget cannot
+ *        give each run 64 KiB buffers the runs are merged in several passes. Temporary files are
+ *        created in $TMPDIR, or /tmp, and are unlinked as soon as they are opened. They need up to
+ *        twice the size of the input. On failure out_path may be left incomplete. The sort is not
+ *        stable.
+ *********************************************************************************************************
+ */
+int cds_external_sort(const char *in_path, const char *out_path, size_t element_size, cds_cmp_func cmp,
+                      size_t mem_budget);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                    CDS EXTERNAL SORT WITH TMP DIR
+ *
+ * Description: Same as cds_external_sort, with the temporary files placed in tmp_dir.
+ *
+ * Arguments: in_path, out_path, element_size, cmp, mem_budget   See cds_external_sort.
+ *            tmp_dir                                            The directory for the temporary files,
+ *                                                               or NULL for the default.
+ *
+ * Returns: 0 on success, -1 on failure.
+ *
+ * Notes: none
+ *********************************************************************************************************
+ */
+int cds_external_sort_with_tmp_dir(const char *in_path, const char *out_path, size_t element_size,
+                                   cds_cmp_func cmp, size_t mem_budget, const char *tmp_dir);
+
 /*
  *********************************************************************************************************
  *
@@ -52,8 +308,263 @@ void *cds_array_search_linear(const struct cds_array *array, const void *key, cd
  * Returns: A pointer to the element if found, or NULL if not found.
  *
  * Notes: The array must be sorted according to the comparison function for the binary search to work correctly.
+ *        If several elements are equal to key, the first of them is returned.
  *********************************************************************************************************
  */
 void *cds_array_search_binary(const struct cds_array *array, const void *key, cds_cmp_func cmp);
 
+/*
+ *********************************************************************************************************
+ *
+ *                                          CDS ARRAY LOWER BOUND
+ *
+ * Description: Finds the first element of the sorted array that is not less than key.
+ *
+ * Arguments: array   A pointer to the struct cds_array instance, sorted according to cmp.
+ *            key     A pointer to the value to search for.
+ *            cmp     A pointer to a comparison function.
+ *
+ * Returns: The index of that element, or the size of the array if every element is less than key.
+ *
+ * Notes: A binary search without branches on the comparison results. cds_array_upper_bound is the
+ *        same for the first element greater than key.
+ *********************************************************************************************************
+ */
+size_t cds_array_lower_bound(const struct cds_array *array, const void *key, cds_cmp_func cmp);
+size_t cds_array_upper_bound(const struct cds_array *array, const void *key, cds_cmp_func cmp);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                          CDS ARRAY EQUAL RANGE
+ *
+ * Description: Finds the range of elements of the sorted array that compare equal to key.
+ *
+ * Arguments: array   A pointer to the struct cds_array instance, sorted according to cmp.
+ *            key     A pointer to the value to search for.
+ *            cmp     A pointer to a comparison function.
+ *            first   Receives the index of the first equal element (the lower bound).
+ *            last    Receives the index one past the last equal element (the upper bound).
+ *
+ * Returns: 0 on success, -1 on failure (e.g., invalid arguments).
+ *
+ * Notes: The range is empty (first == last) when no element equals key; first is then where key would
+ *        be inserted.
+ *********************************************************************************************************
+ */
+int cds_array_equal_range(const struct cds_array *array, const void *key, cds_cmp_func cmp,
+                          size_t *first, size_t *last);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                       CDS ARRAY SEARCH EXPONENTIAL
+ *
+ * Description: Finds the lower bound of key in the sorted array, starting from a nearby index.
+ *
+ * Arguments: array   A pointer to the struct cds_array instance, sorted according to cmp.
+ *            hint    The index to start from, e.g. the result of the previous search.
+ *            key     A pointer to the value to search for.
+ *            cmp     A pointer to a comparison function.
+ *
+ * Returns: The same index as cds_array_lower_bound.
+ *
+ * Notes: Gallops away from hint in steps of 1, 2, 4, ... and bisects the last step, which takes
+ *        O(log d) comparisons when the answer is d positions from hint. Walking a cursor through the
+ *        array with nearby keys costs far less than independent binary searches.
+ *********************************************************************************************************
+ */
+size_t cds_array_search_exponential(const struct cds_array *array, size_t hint, const void *key,
+                                    cds_cmp_func cmp);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                      CDS ARRAY SEARCH INTERPOLATION
+ *
+ * Description: Finds the lower bound of a numeric key in the sorted array by interpolating its position.
+ *
+ * Arguments: array        A pointer to the struct cds_array instance, sorted by the key.
+ *            key_offset   The byte offset of the key inside each element.
+ *            key_width    The width of the key in bytes: 1, 2, 4 or 8.
+ *            flags        The key type, as for cds_array_sort_radix: CDS_SORT_RADIX_UNSIGNED,
+ *                         CDS_SORT_RADIX_SIGNED or CDS_SORT_RADIX_FLOAT, optionally OR'ed with
+ *                         CDS_SORT_RADIX_DESCENDING for an array sorted in descending order.
+ *            key          A pointer to the key value to search for, key_width bytes.
+ *
+ * Returns: The index of the first element whose key is not before the searched key in the sort
+ *          order, or the size of the array. 0 if the arguments are invalid.
+ *
+ * Notes: Each probe goes where the key would be if the keys were evenly spread over the remaining
+ *        range, which takes O(log log n) probes on uniformly distributed keys. When two probes in a row
+ *        fail to halve the range a bisection step follows, so skewed keys cost at most O(log n).
+ *********************************************************************************************************
+ */
+size_t cds_array_search_interpolation(const struct cds_array *array, size_t key_offset, size_t key_width,
+                                      int flags, const void *key);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                        CDS ARRAY SEARCH BINARY BATCH
+ *
+ * Description: Searches for many keys in the dynamic array at once using binary search.
+ *
+ * Arguments: array     A pointer to the struct cds_array instance, sorted according to cmp.
+ *            keys      A pointer to n keys stored back to back, each array->element_size bytes.
+ *            n         The number of keys.
+ *            results   A pointer to n pointers that receive the matching element of each key, or NULL
+ *                      for keys that are not found.
+ *            cmp       A pointer to a comparison function.
+ *
+ * Returns: 0 on success, -1 on failure (e.g., invalid arguments).
+ *
+ * Notes: The searches are advanced together in groups of 32, one step at a time, and the element each
+ *        search compares next is prefetched while the others take their step. Once the array is larger
+ *        than the cache, the memory accesses of the group overlap instead of stalling one after
+ *        another. With cds_cmp_i32 or cds_cmp_i64 as cmp the comparisons are inlined. For keys that
+ *        occur several times, the first matching element is returned.
+ *********************************************************************************************************
+ */
+int cds_array_search_binary_batch(const struct cds_array *array, const void *keys, size_t n,
+                                  void **results, cds_cmp_func cmp);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                         CDS ARRAY SET MERGE
+ *
+ * Description: Merges two sorted dynamic arrays into a third one.
+ *
+ * Arguments: a     A pointer to the first struct cds_array instance, sorted according to cmp.
+ *            b     A pointer to the second struct cds_array instance, sorted according to cmp.
+ *            cmp   A pointer to a comparison function.
+ *            out   A pointer to the struct cds_array instance that receives the result. Its previous
+ *                  contents are replaced.
+ *
+ * Returns: 0 on success, -1 on failure (e.g., invalid arguments, element sizes that differ, out being
+ *          the same array as a or b, or if memory allocation fails).
+ *
+ * Notes: All elements of a and b in sorted order; of equal elements, those of a come first. out only
+ *        grows if its capacity is below a->size + b->size, so reusing it avoids allocation. With
+ *        cds_cmp_i32 or cds_cmp_u32 as cmp the inputs are merged eight keys at a time with AVX2 when
+ *        the CPU supports it, and with cds_cmp_i64 or cds_cmp_u64 by a branchless scalar loop. When
+ *        one input is at least 32 times longer than the other, the elements of the shorter one are
+ *        located in it by galloping (exponential search), and the runs in between are copied whole.
+ *********************************************************************************************************
+ */
+int cds_array_set_merge(const struct cds_array *a, const struct cds_array *b, cds_cmp_func cmp,
+                        struct cds_array *out);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                         CDS ARRAY SET UNION
+ *
+ * Description: Writes the union of two sorted dynamic arrays into a third one.
+ *
+ * Arguments: a, b, cmp, out   See cds_array_set_merge.
+ *
+ * Returns: 0 on success, -1 on failure (e.g., invalid arguments, element sizes that differ, out being
+ *          the same array as a or b, or if memory allocation fails).
+ *
+ * Notes: All elements of a and the elements of b that are not equal to any element of a, in sorted
+ *        order. out is reserved for a->size + b->size elements. The typed comparators and galloping
+ *        speed it up as for cds_array_set_merge, and the elements of b are filtered against a as in
+ *        cds_array_set_difference.
+ *********************************************************************************************************
+ */
+int cds_array_set_union(const struct cds_array *a, const struct cds_array *b, cds_cmp_func cmp,
+                        struct cds_array *out);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                       CDS ARRAY SET INTERSECT
+ *
+ * Description: Writes the intersection of two sorted dynamic arrays into a third one.
+ *
+ * Arguments: a, b, cmp, out   See cds_array_set_merge.
+ *
+ * Returns: 0 on success, -1 on failure (e.g., invalid arguments, element sizes that differ, out being
+ *          the same array as a or b, or if memory allocation fails).
+ *
+ * Notes: The elements of a that are equal to some element of b, in order; duplicates in a are kept,
+ *        so for inputs without duplicates this is the set intersection. out is reserved for a->size
+ *        elements. With cds_cmp_i32 or cds_cmp_u32 as cmp, blocks of four keys are compared in all
+ *        rotations with SSSE3, and with cds_cmp_i64 or cds_cmp_u64 with AVX2, when the CPU supports
+ *        it. Inputs of very different lengths are galloped as in cds_array_set_merge.
+ *********************************************************************************************************
+ */
+int cds_array_set_intersect(const struct cds_array *a, const struct cds_array *b, cds_cmp_func cmp,
+                            struct cds_array *out);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                       CDS ARRAY SET DIFFERENCE
+ *
+ * Description: Writes the elements of a sorted dynamic array that are not in another one into a third.
+ *
+ * Arguments: a, b, cmp, out   See cds_array_set_merge.
+ *
+ * Returns: 0 on success, -1 on failure (e.g., invalid arguments, element sizes that differ, out being
+ *          the same array as a or b, or if memory allocation fails).
+ *
+ * Notes: The elements of a that are not equal to any element of b, in order. out is reserved for
+ *        a->size elements. SIMD and galloping as in cds_array_set_intersect.
+ *********************************************************************************************************
+ */
+int cds_array_set_difference(const struct cds_array *a, const struct cds_array *b, cds_cmp_func cmp,
+                             struct cds_array *out);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                         CDS SORT SMALL I32
+ *
+ * Description: Sorts up to CDS_SORT_SMALL_MAX values in ascending order with a sorting network.
+ *
+ * Arguments: data   A pointer to the values to be sorted.
+ *            n      The number of values, at most CDS_SORT_SMALL_MAX.
+ *
+ * Returns: 0 on success, -1 if n is larger than CDS_SORT_SMALL_MAX.
+ *
+ * Notes: cds_sort_small_i64, cds_sort_small_f32 and cds_sort_small_f64 do the same for int64_t,
+ *        float and double. The network runs on AVX2 or SSE4 when the CPU supports it, checked at
+ *        runtime, and falls back to branch-free scalar code otherwise. Floating-point values are
+ *        ordered like cds_cmp_f32 and cds_cmp_f64 order them.
+ *********************************************************************************************************
+ */
+int cds_sort_small_i32(int32_t *data, size_t n);
+int cds_sort_small_i64(int64_t *data, size_t n);
+int cds_sort_small_f32(float *data, size_t n);
+int cds_sort_small_f64(double *data, size_t n);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                            CDS CMP I32
+ *
+ * Description: Comparison functions for arrays of int32_t, int64_t, uint32_t, uint64_t, float and
+ *              double.
+ *
+ * Arguments: a   A pointer to the first value.
+ *            b   A pointer to the second value.
+ *
+ * Returns: A negative value, zero or a positive value if a is less than, equal to or greater than b.
+ *
+ * Notes: When a signed or floating-point one is passed to cds_array_sort for an array of the matching
+ *        element size, ranges of up to CDS_SORT_SMALL_MAX elements are finished with cds_sort_small_*
+ *        instead of insertion sort. The floating-point comparisons are a total order:
+ *        -NaN < -inf < ... < -0.0 < +0.0 < ... < +inf < +NaN.
+ *********************************************************************************************************
+ */
+int cds_cmp_i32(const void *a, const void *b);
+int cds_cmp_i64(const void *a, const void *b);
+int cds_cmp_u32(const void *a, const void *b);
+int cds_cmp_u64(const void *a, const void *b);
+int cds_cmp_f32(const void *a, const void *b);
+int cds_cmp_f64(const void *a, const void *b);
+
 #endif
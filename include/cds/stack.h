@@ -4,9 +4,12 @@
 #include <stddef.h>
 #include <stdbool.h>
 
+#include "allocator.h"
+
 typedef struct cds_stack {
   char *data;
   size_t size, capacity, element_size;
+  const struct cds_allocator *allocator;
 } CdsStack;
 
 /*
@@ -26,6 +29,25 @@ typedef struct cds_stack {
  */
 struct cds_stack cds_stack_new(const size_t element_size);
 
+/*
+ *********************************************************************************************************
+ *
+ *                                      CDS STACK NEW WITH ALLOCATOR
+ * 
+ * Description: Creates a new stack whose storage comes from the given allocator.
+ * 
+ * Arguments: element_size   The size of each element in the stack.
+ *            allocator      A pointer to the allocator, or NULL for cds_default_allocator.
+ *
+ * Returns: A newly created struct cds_stack instance. The data field can be NULL if memory allocation
+ *          fails.
+ * 
+ * Notes: The allocator is referenced, not copied, and must outlive the stack.
+ *********************************************************************************************************
+ */
+struct cds_stack cds_stack_new_with_allocator(const size_t element_size,
+                                              const struct cds_allocator *allocator);
+
 /*
  *********************************************************************************************************
  *
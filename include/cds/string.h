@@ -4,6 +4,7 @@
 #include <stddef.h>
 #include <stdbool.h>
 
+#include "allocator.h"
 #include "array.h"
 
 #ifndef CDS_STRING_OPT_CAPACITY
@@ -13,6 +14,7 @@
 typedef struct cds_string {
   char opt_data[CDS_STRING_OPT_CAPACITY], *data;
   size_t size, capacity;
+  const struct cds_allocator *allocator;
 } CdsString;
 
 /*
@@ -50,6 +52,42 @@ struct cds_string cds_string_new();
  */
 struct cds_string cds_string_from(const char *data, size_t length);
 
+/*
+ *********************************************************************************************************
+ *
+ *                                     CDS STRING NEW WITH ALLOCATOR
+ * 
+ * Description: Creates a new string whose heap buffer comes from the given allocator.
+ * 
+ * Arguments: allocator   A pointer to the allocator, or NULL for cds_default_allocator.
+ *
+ * Returns: A newly created struct cds_string instance. The data field is NULL at first.
+ * 
+ * Notes: The allocator is referenced, not copied, and must outlive the string.
+ *********************************************************************************************************
+ */
+struct cds_string cds_string_new_with_allocator(const struct cds_allocator *allocator);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                     CDS STRING FROM WITH ALLOCATOR
+ * 
+ * Description: Creates a new string from a c string using the given allocator.
+ * 
+ * Arguments: data        A c string.
+ *            length      The length of the string data.
+ *            allocator   A pointer to the allocator, or NULL for cds_default_allocator.
+ *
+ * Returns: A newly created struct cds_string instance. The data field may be NULL at first.
+ * 
+ * Notes: The allocator is referenced, not copied, and must outlive the string. Strings returned by
+ *        cds_string_split share the allocator of the string being split.
+ *********************************************************************************************************
+ */
+struct cds_string cds_string_from_with_allocator(const char *data, size_t length,
+                                                 const struct cds_allocator *allocator);
+
 /*
  *********************************************************************************************************
  *
@@ -0,0 +1,343 @@
+#ifndef CDS_TEMPLATE_H
+#define CDS_TEMPLATE_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "allocator.h"
+
+/*
+ *********************************************************************************************************
+ *
+ *                                           CDS ARRAY DEFINE
+ *
+ * Description: Generates a dynamic array specialized for one element type.
+ *
+ * Arguments: type   The element type, e.g. int32_t or struct foo *.
+ *            name   The name of the generated struct and the prefix of the generated functions.
+ *
+ * Returns: none
+ *
+ * Notes: The following static inline functions are generated, mirroring struct cds_array:
+ *          name_new, name_new_with_allocator, name_delete, name_reserve, name_push_back,
+ *          name_push_back_n, name_pop_back, name_at, name_get, name_size, name_empty.
+ *        Elements are addressed as data[index], so accesses and loops over the data member can be
+ *        inlined and vectorized by the compiler. A new array holds no storage until the first push.
+ *********************************************************************************************************
+ */
+#define CDS_ARRAY_DEFINE(type, name)                                                                  \
+  typedef struct name {                                                                               \
+    type *data;                                                                                       \
+    size_t size, capacity;                                                                            \
+    const struct cds_allocator *allocator;                                                            \
+  } name;                                                                                             \
+                                                                                                      \
+  static inline name name##_new_with_allocator(const struct cds_allocator *allocator) {               \
+    name new_array = {.data = NULL, .size = 0, .capacity = 0, .allocator = allocator};                \
+    return new_array;                                                                                 \
+  }                                                                                                   \
+                                                                                                      \
+  static inline name name##_new(void) {                                                               \
+    return name##_new_with_allocator(&cds_default_allocator);                                         \
+  }                                                                                                   \
+                                                                                                      \
+  static inline void name##_delete(name *array) {                                                     \
+    cds_allocator_free(array->allocator, array->data, array->capacity * sizeof(type));               \
+    array->data = NULL;                                                                               \
+    array->size = array->capacity = 0;                                                                \
+  }                                                                                                   \
+                                                                                                      \
+  static inline int name##_reserve(name *array, const size_t capacity) {                              \
+    if (capacity <= array->capacity) {                                                                \
+      return 0;                                                                                       \
+    }                                                                                                 \
+    if (capacity > SIZE_MAX / sizeof(type)) {                                                         \
+      return -1;                                                                                      \
+    }                                                                                                 \
+    type *new_data = (type*) cds_allocator_realloc(array->allocator, array->data,                     \
+      array->capacity * sizeof(type), capacity * sizeof(type));                                       \
+    if (new_data == NULL) {                                                                           \
+      return -1;                                                                                      \
+    }                                                                                                 \
+    array->data = new_data;                                                                           \
+    array->capacity = capacity;                                                                       \
+    return 0;                                                                                         \
+  }                                                                                                   \
+                                                                                                      \
+  static inline int name##_grow(name *array, const size_t min_capacity) {                             \
+    size_t new_capacity = array->capacity == 0 ? 1 : array->capacity;                                 \
+    while (new_capacity < min_capacity) {                                                             \
+      if (new_capacity > SIZE_MAX / 2) {                                                              \
+        new_capacity = min_capacity;                                                                  \
+        break;                                                                                        \
+      }                                                                                               \
+      new_capacity <<= 1;                                                                             \
+    }                                                                                                 \
+    return name##_reserve(array, new_capacity);                                                       \
+  }                                                                                                   \
+                                                                                                      \
+  static inline int name##_push_back(name *array, const type new_element) {                           \
+    if (array->size == array->capacity && name##_grow(array, array->size + 1) != 0) {                 \
+      return -1;                                                                                      \
+    }                                                                                                 \
+    array->data[array->size++] = new_element;                                                         \
+    return 0;                                                                                         \
+  }                                                                                                   \
+                                                                                                      \
+  static inline int name##_push_back_n(name *array, const type *new_elements, const size_t count) {   \
+    if (count > SIZE_MAX - array->size) {                                                             \
+      return -1;                                                                                      \
+    }                                                                                                 \
+    if (array->size + count > array->capacity && name##_grow(array, array->size + count) != 0) {     \
+      return -1;                                                                                      \
+    }                                                                                                 \
+    if (count > 0) {                                                                                  \
+      memcpy(array->data + array->size, new_elements, count * sizeof(type));                          \
+    }                                                                                                 \
+    array->size += count;                                                                             \
+    return 0;                                                                                         \
+  }                                                                                                   \
+                                                                                                      \
+  static inline int name##_pop_back(name *array) {                                                    \
+    if (array->size == 0) {                                                                           \
+      return -1;                                                                                      \
+    }                                                                                                 \
+    array->size--;                                                                                    \
+    return 0;                                                                                         \
+  }                                                                                                   \
+                                                                                                      \
+  static inline type *name##_at(const name *array, const size_t index) {                              \
+    return index < array->size ? array->data + index : NULL;                                          \
+  }                                                                                                   \
+                                                                                                      \
+  static inline type name##_get(const name *array, const size_t index) {                              \
+    return array->data[index];                                                                        \
+  }                                                                                                   \
+                                                                                                      \
+  static inline size_t name##_size(const name *array) {                                               \
+    return array->size;                                                                               \
+  }                                                                                                   \
+                                                                                                      \
+  static inline bool name##_empty(const name *array) {                                                \
+    return array->size == 0;                                                                          \
+  }
+
+/*
+ *********************************************************************************************************
+ *
+ *                                           CDS STACK DEFINE
+ *
+ * Description: Generates a stack specialized for one element type.
+ *
+ * Arguments: type   The element type.
+ *            name   The name of the generated struct and the prefix of the generated functions.
+ *
+ * Returns: none
+ *
+ * Notes: The stack is a CDS_ARRAY_DEFINE array named name, so every array function is available. In
+ *        addition name_push, name_pop and name_top are generated, mirroring struct cds_stack.
+ *********************************************************************************************************
+ */
+#define CDS_STACK_DEFINE(type, name)                                                                  \
+  CDS_ARRAY_DEFINE(type, name)                                                                        \
+                                                                                                      \
+  static inline int name##_push(name *stack, const type new_element) {                                \
+    return name##_push_back(stack, new_element);                                                      \
+  }                                                                                                   \
+                                                                                                      \
+  static inline int name##_pop(name *stack) {                                                         \
+    return name##_pop_back(stack);                                                                    \
+  }                                                                                                   \
+                                                                                                      \
+  static inline type *name##_top(const name *stack) {                                                 \
+    return stack->size == 0 ? NULL : stack->data + stack->size - 1;                                   \
+  }
+
+/*
+ *********************************************************************************************************
+ *
+ *                                           CDS QUEUE DEFINE
+ *
+ * Description: Generates a ring-buffer queue specialized for one element type.
+ *
+ * Arguments: type   The element type.
+ *            name   The name of the generated struct and the prefix of the generated functions.
+ *
+ * Returns: none
+ *
+ * Notes: The following static inline functions are generated, mirroring struct cds_queue:
+ *          name_new, name_new_with_allocator, name_delete, name_push, name_pop, name_front,
+ *          name_size, name_empty.
+ *        The capacity is kept a power of two so wrapping is a mask instead of a division.
+ *********************************************************************************************************
+ */
+#define CDS_QUEUE_DEFINE(type, name)                                                                  \
+  typedef struct name {                                                                               \
+    type *data;                                                                                       \
+    size_t size, capacity, front;                                                                     \
+    const struct cds_allocator *allocator;                                                            \
+  } name;                                                                                             \
+                                                                                                      \
+  static inline name name##_new_with_allocator(const struct cds_allocator *allocator) {               \
+    name new_queue = {.data = NULL, .size = 0, .capacity = 0, .front = 0, .allocator = allocator};    \
+    return new_queue;                                                                                 \
+  }                                                                                                   \
+                                                                                                      \
+  static inline name name##_new(void) {                                                               \
+    return name##_new_with_allocator(&cds_default_allocator);                                         \
+  }                                                                                                   \
+                                                                                                      \
+  static inline void name##_delete(name *queue) {                                                     \
+    cds_allocator_free(queue->allocator, queue->data, queue->capacity * sizeof(type));               \
+    queue->data = NULL;                                                                               \
+    queue->size = queue->capacity = queue->front = 0;                                                 \
+  }                                                                                                   \
+                                                                                                      \
+  static inline int name##_push(name *queue, const type new_element) {                                \
+    if (queue->size == queue->capacity) {                                                             \
+      const size_t new_capacity = queue->capacity == 0 ? 1 : queue->capacity << 1;                    \
+      type *new_data = (type*) cds_allocator_alloc(queue->allocator, new_capacity * sizeof(type));    \
+      if (new_data == NULL) {                                                                         \
+        return -1;                                                                                    \
+      }                                                                                               \
+      for (size_t i = 0; i < queue->size; ++i) {                                                      \
+        new_data[i] = queue->data[(queue->front + i) & (queue->capacity - 1)];                        \
+      }                                                                                               \
+      cds_allocator_free(queue->allocator, queue->data, queue->capacity * sizeof(type));             \
+      queue->data = new_data;                                                                         \
+      queue->capacity = new_capacity;                                                                 \
+      queue->front = 0;                                                                               \
+    }                                                                                                 \
+    queue->data[(queue->front + queue->size) & (queue->capacity - 1)] = new_element;                  \
+    queue->size++;                                                                                    \
+    return 0;                                                                                         \
+  }                                                                                                   \
+                                                                                                      \
+  static inline int name##_pop(name *queue) {                                                         \
+    if (queue->size == 0) {                                                                           \
+      return -1;                                                                                      \
+    }                                                                                                 \
+    queue->front = (queue->front + 1) & (queue->capacity - 1);                                        \
+    queue->size--;                                                                                    \
+    return 0;                                                                                         \
+  }                                                                                                   \
+                                                                                                      \
+  static inline type *name##_front(const name *queue) {                                               \
+    return queue->size == 0 ? NULL : queue->data + queue->front;                                      \
+  }                                                                                                   \
+                                                                                                      \
+  static inline size_t name##_size(const name *queue) {                                               \
+    return queue->size;                                                                               \
+  }                                                                                                   \
+                                                                                                      \
+  static inline bool name##_empty(const name *queue) {                                                \
+    return queue->size == 0;                                                                          \
+  }
+
+/*
+ *********************************************************************************************************
+ *
+ *                                            CDS HEAP DEFINE
+ *
+ * Description: Generates a binary heap specialized for one element type and ordering.
+ *
+ * Arguments: type        The element type.
+ *            name        The name of the generated struct and the prefix of the generated functions.
+ *            less_expr   An expression over the elements a and b that is true when a must come out
+ *                        of the heap before b, e.g. a < b for a min-heap of integers.
+ *
+ * Returns: none
+ *
+ * Notes: The following static inline functions are generated, mirroring struct cds_heap:
+ *          name_new, name_new_with_allocator, name_delete, name_push, name_pop, name_top, name_size,
+ *          name_empty.
+ *        The comparison is inlined in place of a cds_cmp_func call, and sifting moves a hole instead
+ *        of swapping so each level costs one element copy.
+ *********************************************************************************************************
+ */
+#define CDS_HEAP_DEFINE(type, name, less_expr)                                                        \
+  CDS_ARRAY_DEFINE(type, name##_storage)                                                              \
+                                                                                                      \
+  typedef struct name {                                                                               \
+    name##_storage data;                                                                              \
+  } name;                                                                                             \
+                                                                                                      \
+  static inline bool name##_less(const type a, const type b) {                                        \
+    return (less_expr);                                                                               \
+  }                                                                                                   \
+                                                                                                      \
+  static inline name name##_new_with_allocator(const struct cds_allocator *allocator) {               \
+    name new_heap = {.data = name##_storage_new_with_allocator(allocator)};                           \
+    return new_heap;                                                                                  \
+  }                                                                                                   \
+                                                                                                      \
+  static inline name name##_new(void) {                                                               \
+    return name##_new_with_allocator(&cds_default_allocator);                                         \
+  }                                                                                                   \
+                                                                                                      \
+  static inline void name##_delete(name *heap) {                                                      \
+    name##_storage_delete(&heap->data);                                                               \
+  }                                                                                                   \
+                                                                                                      \
+  static inline int name##_push(name *heap, const type new_element) {                                 \
+    if (name##_storage_push_back(&heap->data, new_element) != 0) {                                   \
+      return -1;                                                                                      \
+    }                                                                                                 \
+    type *data = heap->data.data;                                                                     \
+    size_t hole = heap->data.size - 1;                                                                \
+    while (hole > 0) {                                                                                \
+      const size_t parent = (hole - 1) >> 1;                                                          \
+      if (!name##_less(new_element, data[parent])) {                                                  \
+        break;                                                                                        \
+      }                                                                                               \
+      data[hole] = data[parent];                                                                      \
+      hole = parent;                                                                                  \
+    }                                                                                                 \
+    data[hole] = new_element;                                                                         \
+    return 0;                                                                                         \
+  }                                                                                                   \
+                                                                                                      \
+  static inline int name##_pop(name *heap) {                                                          \
+    if (heap->data.size == 0) {                                                                       \
+      return -1;                                                                                      \
+    }                                                                                                 \
+    type *data = heap->data.data;                                                                     \
+    const size_t size = --heap->data.size;                                                            \
+    if (size == 0) {                                                                                  \
+      return 0;                                                                                       \
+    }                                                                                                 \
+    const type last = data[size];                                                                     \
+    size_t hole = 0;                                                                                  \
+    for (;;) {                                                                                        \
+      size_t child = (hole << 1) + 1;                                                                 \
+      if (child >= size) {                                                                            \
+        break;                                                                                        \
+      }                                                                                               \
+      if (child + 1 < size && name##_less(data[child + 1], data[child])) {                            \
+        child++;                                                                                      \
+      }                                                                                               \
+      if (!name##_less(data[child], last)) {                                                          \
+        break;                                                                                        \
+      }                                                                                               \
+      data[hole] = data[child];                                                                       \
+      hole = child;                                                                                   \
+    }                                                                                                 \
+    data[hole] = last;                                                                                \
+    return 0;                                                                                         \
+  }                                                                                                   \
+                                                                                                      \
+  static inline type *name##_top(const name *heap) {                                                  \
+    return heap->data.size == 0 ? NULL : heap->data.data;                                             \
+  }                                                                                                   \
+                                                                                                      \
+  static inline size_t name##_size(const name *heap) {                                                \
+    return heap->data.size;                                                                           \
+  }                                                                                                   \
+                                                                                                      \
+  static inline bool name##_empty(const name *heap) {                                                 \
+    return heap->data.size == 0;                                                                      \
+  }
+
+#endif
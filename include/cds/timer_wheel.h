@@ -0,0 +1,211 @@
+#ifndef CDS_TIMER_WHEEL_H
+#define CDS_TIMER_WHEEL_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "array.h"
+
+#define CDS_TIMER_WHEEL_LEVELS 11
+#define CDS_TIMER_WHEEL_SLOTS 64
+#define CDS_TIMER_NONE UINT64_MAX
+
+// Identifies an armed timer: the index of its node in the low 32 bits and the node's generation in the
+// high 32, so the id of a timer that has fired or been canceled never matches a later one.
+typedef uint64_t cds_timer_id;
+
+// An expired timer, as passed to a cds_timer_func or appended to an array of expired timers.
+struct cds_timer {
+  cds_timer_id id;
+  uint64_t deadline;          // as given to cds_timer_wheel_arm
+  void *data;
+};
+
+typedef void (*cds_timer_func)(const struct cds_timer *timer, void *context);
+
+// Time is counted in ticks of `tick` units. A timer due at tick d is in level b / 6, where b is the
+// highest bit in which d differs from current, and in the slot given by d's 6 bits for that level; each
+// level's occupied slots are marked in a bit mask. Nodes live in an array and are linked within their
+// slot by index; free nodes are linked through the same field.
+typedef struct cds_timer_wheel {
+  struct cds_array nodes;
+  uint32_t slots[CDS_TIMER_WHEEL_LEVELS * CDS_TIMER_WHEEL_SLOTS];
+  uint64_t occupied[CDS_TIMER_WHEEL_LEVELS];
+  uint64_t tick;              // units per tick
+  uint64_t current;           // every tick up to this one has been processed
+  uint32_t free_head;
+  size_t size;
+} CdsTimerWheel;
+
+/*
+ *********************************************************************************************************
+ *
+ *                                        CDS TIMER WHEEL NEW
+ *
+ * Description: Creates a new hierarchical timer wheel for large numbers of timers that are armed and
+ *              canceled far more often than they fire, such as connection timeouts.
+ *
+ * Arguments: tick   The resolution, in the caller's units of time (e.g., 1000000 for 1 ms ticks with
+ *                   times in nanoseconds). Must be positive.
+ *            now    The current time, in the same units.
+ *
+ * Returns: A newly created struct cds_timer_wheel instance. The data field of nodes is NULL if memory
+ *          allocation fails or tick is 0.
+ *
+ * Notes: Arming and canceling are O(1). Each timer is moved to a lower level at most 10 times before it
+ *        fires, and empty stretches of time are skipped using the occupancy masks, so advancing costs
+ *        O(1) per timer and per level crossed rather than per tick. The caller is responsible for
+ *        freeing the memory using cds_timer_wheel_delete.
+ *********************************************************************************************************
+ */
+struct cds_timer_wheel cds_timer_wheel_new(uint64_t tick, uint64_t now);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                  CDS TIMER WHEEL NEW WITH ALLOCATOR
+ *
+ * Description: Same as cds_timer_wheel_new, with the storage taken from the given allocator.
+ *
+ * Arguments: tick, now   See cds_timer_wheel_new.
+ *            allocator   A pointer to the allocator, or NULL for cds_default_allocator.
+ *
+ * Returns: A newly created struct cds_timer_wheel instance. The data field of nodes is NULL if memory
+ *          allocation fails or tick is 0.
+ *
+ * Notes: The allocator is referenced, not copied, and must outlive the wheel.
+ *********************************************************************************************************
+ */
+struct cds_timer_wheel cds_timer_wheel_new_with_allocator(uint64_t tick, uint64_t now,
+                                                          const struct cds_allocator *allocator);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                       CDS TIMER WHEEL DELETE
+ *
+ * Description: Deletes the wheel and frees the memory allocated for it.
+ *
+ * Arguments: wheel   A pointer to the wheel to be deleted.
+ *
+ * Returns: None.
+ *
+ * Notes: Timers still armed are dropped without firing.
+ *********************************************************************************************************
+ */
+void cds_timer_wheel_delete(struct cds_timer_wheel *wheel);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                        CDS TIMER WHEEL ARM
+ *
+ * Description: Arms a timer.
+ *
+ * Arguments: wheel      A pointer to the wheel.
+ *            deadline   The time at which the timer fires, in the units of cds_timer_wheel_new.
+ *            data       A pointer handed back when the timer fires.
+ *
+ * Returns: The id of the timer, or CDS_TIMER_NONE if memory allocation fails or the wheel failed to be
+ *          created.
+ *
+ * Notes: O(1). The deadline is rounded up to a whole tick, so a timer never fires early and at most one
+ *        tick late. A deadline that has already passed is treated as due in the next tick.
+ *********************************************************************************************************
+ */
+cds_timer_id cds_timer_wheel_arm(struct cds_timer_wheel *wheel, uint64_t deadline, void *data);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                       CDS TIMER WHEEL CANCEL
+ *
+ * Description: Disarms a timer.
+ *
+ * Arguments: wheel   A pointer to the wheel.
+ *            id      The id of the timer.
+ *
+ * Returns: 0 on success, -1 if id is not an armed timer (e.g., if it has already fired or been
+ *          canceled).
+ *
+ * Notes: O(1). Canceling a timer that has just fired is harmless, even if its node has been reused.
+ *********************************************************************************************************
+ */
+int cds_timer_wheel_cancel(struct cds_timer_wheel *wheel, cds_timer_id id);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                       CDS TIMER WHEEL ADVANCE
+ *
+ * Description: Moves the wheel's time forward and fires every timer whose deadline has been reached.
+ *
+ * Arguments: wheel      A pointer to the wheel.
+ *            now        The current time. Times earlier than the wheel's are ignored.
+ *            callback   Called once for each expired timer, in order of tick.
+ *            context    Passed through to callback.
+ *
+ * Returns: The number of timers fired, which is 0 if the wheel failed to be created.
+ *
+ * Notes: A timer is disarmed before its callback runs, so the callback may arm new timers and cancel
+ *        others, including ones due in the same tick. A timer armed by the callback for a time that
+ *        has passed fires in the next tick, within this call if that tick is not after now.
+ *********************************************************************************************************
+ */
+size_t cds_timer_wheel_advance(struct cds_timer_wheel *wheel, uint64_t now, cds_timer_func callback,
+                               void *context);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                    CDS TIMER WHEEL ADVANCE INTO
+ *
+ * Description: Moves the wheel's time forward and appends every timer whose deadline has been reached
+ *              to an array.
+ *
+ * Arguments: wheel     A pointer to the wheel.
+ *            now       The current time. Times earlier than the wheel's are ignored.
+ *            expired   A pointer to an array of struct cds_timer.
+ *
+ * Returns: 0 on success, -1 if memory allocation fails or the wheel failed to be created.
+ *
+ * Notes: Expired timers are appended in order of tick. If an append fails, the timers not yet
+ *        appended stay armed and are returned by the next call.
+ *********************************************************************************************************
+ */
+int cds_timer_wheel_advance_into(struct cds_timer_wheel *wheel, uint64_t now, struct cds_array *expired);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                        CDS TIMER WHEEL SIZE
+ *
+ * Description: Returns the number of armed timers.
+ *
+ * Arguments: wheel   A pointer to the wheel.
+ *
+ * Returns: The number of armed timers.
+ *
+ * Notes: None.
+ *********************************************************************************************************
+ */
+size_t cds_timer_wheel_size(const struct cds_timer_wheel *wheel);
+
+/*
+ *********************************************************************************************************
+ *
+ *                                        CDS TIMER WHEEL EMPTY
+ *
+ * Description: Checks if no timer is armed.
+ *
+ * Arguments: wheel   A pointer to the wheel.
+ *
+ * Returns: true if no timer is armed, false otherwise.
+ *
+ * Notes: None.
+ *********************************************************************************************************
+ */
+bool cds_timer_wheel_empty(const struct cds_timer_wheel *wheel);
+
+#endif
@@ -0,0 +1,127 @@
+#define _GNU_SOURCE  // mremap, MAP_HUGETLB
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include "cds/allocator.h"
+
+static bool cds_aligned_uses_huge_pages(const struct cds_aligned_allocator *aligned, size_t size) {
+  return (aligned->flags & (CDS_ALLOCATOR_HUGE_PAGES | CDS_ALLOCATOR_HUGETLB)) != 0 &&
+         size >= CDS_HUGE_PAGE_SIZE;
+}
+
+static size_t cds_huge_round(size_t size) {
+  return (size + CDS_HUGE_PAGE_SIZE - 1) & ~(CDS_HUGE_PAGE_SIZE - 1);
+}
+
+static void* cds_huge_map(const struct cds_aligned_allocator *aligned, size_t size) {
+  const size_t length = cds_huge_round(size);
+#ifdef MAP_HUGETLB
+  if (aligned->flags & CDS_ALLOCATOR_HUGETLB) {
+    void *block = mmap(NULL, length, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (block != MAP_FAILED) {
+      return block;
+    }
+  }
+#else
+  (void) aligned;
+#endif
+  // Over-map by one huge page and trim both ends so the block starts on a 2 MB boundary.
+  char *raw = mmap(NULL, length + CDS_HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (raw == MAP_FAILED) {
+    return NULL;
+  }
+  char *block = (char*) (((uintptr_t) raw + CDS_HUGE_PAGE_SIZE - 1) & ~(CDS_HUGE_PAGE_SIZE - 1));
+  if (block != raw) {
+    munmap(raw, block - raw);
+  }
+  munmap(block + length, (raw + length + CDS_HUGE_PAGE_SIZE) - (block + length));
+#ifdef MADV_HUGEPAGE
+  madvise(block, length, MADV_HUGEPAGE);
+#endif
+  return block;
+}
+
+static void* aligned_alloc_cb(void *context, size_t size) {
+  const struct cds_aligned_allocator *aligned = context;
+  if (cds_aligned_uses_huge_pages(aligned, size)) {
+    return cds_huge_map(aligned, size);
+  }
+  void *block = NULL;
+  if (posix_memalign(&block, aligned->alignment, size == 0 ? 1 : size) != 0) {
+    return NULL;
+  }
+  return block;
+}
+
+static void aligned_free_cb(void *context, void *ptr, size_t size) {
+  const struct cds_aligned_allocator *aligned = context;
+  if (ptr == NULL) {
+    return;
+  }
+  if (cds_aligned_uses_huge_pages(aligned, size)) {
+    munmap(ptr, cds_huge_round(size));
+  } else {
+    free(ptr);
+  }
+}
+
+static void* aligned_realloc_cb(void *context, void *ptr, size_t old_size, size_t new_size) {
+  const struct cds_aligned_allocator *aligned = context;
+  if (ptr == NULL) {
+    return aligned_alloc_cb(context, new_size);
+  }
+  const bool old_huge = cds_aligned_uses_huge_pages(aligned, old_size);
+  const bool new_huge = cds_aligned_uses_huge_pages(aligned, new_size);
+  if (old_huge && new_huge && cds_huge_round(old_size) == cds_huge_round(new_size)) {
+    return ptr;
+  }
+#ifdef MREMAP_MAYMOVE
+  if (old_huge && new_huge) {
+    void *block = mremap(ptr, cds_huge_round(old_size), cds_huge_round(new_size), MREMAP_MAYMOVE);
+    if (block != MAP_FAILED) {
+#ifdef MADV_HUGEPAGE
+      madvise(block, cds_huge_round(new_size), MADV_HUGEPAGE);
+#endif
+      return block;
+    }
+  }
+#endif
+  void *block = aligned_alloc_cb(context, new_size);
+  if (block == NULL) {
+    return NULL;
+  }
+  memcpy(block, ptr, old_size < new_size ? old_size : new_size);
+  aligned_free_cb(context, ptr, old_size);
+  return block;
+}
+
+int cds_aligned_allocator_init(struct cds_aligned_allocator *aligned, size_t alignment, int flags) {
+  if (alignment < sizeof(void*) || (alignment & (alignment - 1)) != 0 ||
+      alignment > CDS_HUGE_PAGE_SIZE) {
+    return -1;
+  }
+  aligned->allocator.alloc = aligned_alloc_cb;
+  aligned->allocator.realloc = aligned_realloc_cb;
+  aligned->allocator.free = aligned_free_cb;
+  aligned->allocator.context = aligned;
+  aligned->alignment = alignment;
+  aligned->flags = flags;
+  return 0;
+}
+
+static const struct cds_aligned_allocator cache_line_aligned = {
+  .allocator = {aligned_alloc_cb, aligned_realloc_cb, aligned_free_cb, (void*) &cache_line_aligned},
+  .alignment = 64,
+  .flags = 0};
+
+const struct cds_allocator cds_cache_line_allocator = {
+  .alloc = aligned_alloc_cb,
+  .realloc = aligned_realloc_cb,
+  .free = aligned_free_cb,
+  .context = (void*) &cache_line_aligned};
@@ -0,0 +1,70 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "cds/allocator.h"
+
+static void* libc_alloc(void *context, size_t size) {
+  (void) context;
+  return malloc(size);
+}
+
+static void* libc_realloc(void *context, void *ptr, size_t old_size, size_t new_size) {
+  (void) context;
+  (void) old_size;
+  return realloc(ptr, new_size);
+}
+
+static void libc_free(void *context, void *ptr, size_t size) {
+  (void) context;
+  (void) size;
+  free(ptr);
+}
+
+const struct cds_allocator cds_default_allocator = {
+  .alloc = libc_alloc,
+  .realloc = libc_realloc,
+  .free = libc_free,
+  .context = NULL};
+
+void* cds_allocator_alloc(const struct cds_allocator *allocator, const size_t size) {
+  if (allocator == NULL) {
+    return malloc(size);
+  }
+  return allocator->alloc(allocator->context, size);
+}
+
+void* cds_allocator_realloc(const struct cds_allocator *allocator, void *ptr,
+                            const size_t old_size, const size_t new_size) {
+  if (allocator == NULL) {
+    return realloc(ptr, new_size);
+  }
+  return allocator->realloc(allocator->context, ptr, old_size, new_size);
+}
+
+void cds_allocator_free(const struct cds_allocator *allocator, void *ptr, const size_t size) {
+  if (ptr == NULL) {
+    return;
+  }
+  if (allocator == NULL) {
+    free(ptr);
+    return;
+  }
+  allocator->free(allocator->context, ptr, size);
+}
+
+char* cds_allocator_strdup(const struct cds_allocator *allocator, const char *str) {
+  const size_t size = strlen(str) + 1;
+  char *copy = (char*) cds_allocator_alloc(allocator, size);
+  if (copy == NULL) {
+    return NULL;
+  }
+  memcpy(copy, str, size);
+  return copy;
+}
+
+void cds_allocator_strfree(const struct cds_allocator *allocator, char *str) {
+  if (str == NULL) {
+    return;
+  }
+  cds_allocator_free(allocator, str, strlen(str) + 1);
+}
@@ -1,37 +1,121 @@
-#include <stdlib.h>
+#include <stdint.h>
 #include <string.h>
 
 #include "cds/array.h"
 
 struct cds_array cds_array_new(const size_t element_size) {
+  return cds_array_new_with_allocator(element_size, &cds_default_allocator);
+}
+
+struct cds_array cds_array_new_with_allocator(const size_t element_size,
+                                              const struct cds_allocator *allocator) {
   struct cds_array new_array = {
-    .data = (char*) malloc(element_size),
+    .data = (char*) cds_allocator_alloc(allocator, element_size),
     .size = 0,
     .capacity = 1,
-    .element_size = element_size};
+    .element_size = element_size,
+    .allocator = allocator};
   return new_array;
 }
 
 void cds_array_delete(struct cds_array *array) {
-  if (array->data != NULL) free(array->data);
+  if (array->data != NULL) {
+    cds_allocator_free(array->allocator, array->data, array->capacity * array->element_size);
+  }
   array->data = NULL;
   array->size = array->capacity = 0;
   array->element_size = 0;
 }
 
-int cds_array_push_back(struct cds_array *array, const void *new_element) {
-  if (array->size == array->capacity) {
-    array->capacity <<= 1;  // cap * 2
-    array->data = (char*) realloc(array->data, array->capacity * array->element_size);
-    if (array->data == NULL) {
-      return -1;
+static int cds_array_grow(struct cds_array *array, const size_t min_capacity) {
+  size_t new_capacity = array->capacity == 0 ? 1 : array->capacity;
+  while (new_capacity < min_capacity) {
+    if (new_capacity > SIZE_MAX / 2) {
+      new_capacity = min_capacity;  // doubling would wrap
+      break;
     }
+    new_capacity <<= 1;  // cap * 2
+  }
+  return cds_array_reserve(array, new_capacity);
+}
+
+int cds_array_reserve(struct cds_array *array, const size_t capacity) {
+  if (capacity <= array->capacity) {
+    return 0;
+  }
+  if (array->element_size != 0 && capacity > SIZE_MAX / array->element_size) {
+    return -1;
+  }
+  char *new_data = (char*) cds_allocator_realloc(array->allocator, array->data,
+    array->capacity * array->element_size, capacity * array->element_size);
+  if (new_data == NULL) {
+    return -1;
+  }
+  array->data = new_data;
+  array->capacity = capacity;
+  return 0;
+}
+
+int cds_array_shrink_to_fit(struct cds_array *array) {
+  const size_t new_capacity = array->size == 0 ? 1 : array->size;
+  if (new_capacity >= array->capacity) {
+    return 0;
+  }
+  char *new_data = (char*) cds_allocator_realloc(array->allocator, array->data,
+    array->capacity * array->element_size, new_capacity * array->element_size);
+  if (new_data == NULL) {
+    return -1;
+  }
+  array->data = new_data;
+  array->capacity = new_capacity;
+  return 0;
+}
+
+int cds_array_resize(struct cds_array *array, const size_t new_size) {
+  if (new_size > array->capacity && cds_array_reserve(array, new_size) != 0) {
+    return -1;
+  }
+  if (new_size > array->size) {
+    memset(array->data + array->size * array->element_size, 0,
+      (new_size - array->size) * array->element_size);
+  }
+  array->size = new_size;
+  return 0;
+}
+
+int cds_array_push_back(struct cds_array *array, const void *new_element) {
+  if (array->size == array->capacity && cds_array_grow(array, array->size + 1) != 0) {
+    return -1;
   }
   memcpy(array->data + array->size * array->element_size, new_element, array->element_size);
   array->size++;
   return 0;
 }
 
+int cds_array_push_back_n(struct cds_array *array, const void *new_elements, const size_t count) {
+  if (count == 0) {
+    return 0;
+  }
+  if (count > SIZE_MAX - array->size) {
+    return -1;
+  }
+  if (array->size + count > array->capacity &&
+      cds_array_grow(array, array->size + count) != 0) {
+    return -1;
+  }
+  memcpy(array->data + array->size * array->element_size, new_elements,
+    count * array->element_size);
+  array->size += count;
+  return 0;
+}
+
+void* cds_array_emplace_back(struct cds_array *array) {
+  if (array->size == array->capacity && cds_array_grow(array, array->size + 1) != 0) {
+    return NULL;
+  }
+  return (void*) (array->data + array->size++ * array->element_size);
+}
+
 int cds_array_pop_back(struct cds_array *array) {
   if (array->size == 0) {
     return -1;
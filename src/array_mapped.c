@@ -0,0 +1,214 @@
+#define _GNU_SOURCE  // mremap
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "cds/array.h"
+
+#define CDS_ARRAY_MAP_MAGIC "CDSARR01"
+#define CDS_ARRAY_MAP_HEADER_SIZE 64
+
+struct cds_array_map_header {
+  char magic[8];
+  uint64_t element_size;
+  uint64_t size;
+};
+
+struct cds_array_mapping {
+  struct cds_allocator allocator;
+  int fd;
+  bool readonly;
+  char *base;
+  size_t mapped_bytes;
+};
+
+static void* mapped_alloc(void *context, size_t size) {
+  (void) context;
+  (void) size;
+  return NULL;  // The file is a single region, it only ever grows through realloc.
+}
+
+static void* mapped_realloc(void *context, void *ptr, size_t old_size, size_t new_size) {
+  struct cds_array_mapping *mapping = context;
+  (void) ptr;
+  (void) old_size;
+  if (mapping->readonly) {
+    return NULL;
+  }
+  const size_t new_bytes = CDS_ARRAY_MAP_HEADER_SIZE + new_size;
+  if (ftruncate(mapping->fd, (off_t) new_bytes) != 0) {
+    return NULL;
+  }
+#ifdef MREMAP_MAYMOVE
+  char *new_base = mremap(mapping->base, mapping->mapped_bytes, new_bytes, MREMAP_MAYMOVE);
+#else
+  char *new_base = mmap(NULL, new_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, mapping->fd, 0);
+  if (new_base != MAP_FAILED) {
+    munmap(mapping->base, mapping->mapped_bytes);
+  }
+#endif
+  if (new_base == MAP_FAILED) {
+    if (ftruncate(mapping->fd, (off_t) mapping->mapped_bytes) != 0) {
+      // Nothing more to undo: the file keeps a zeroed tail past the mapping, which the header's size
+      // excludes and the next open counts as spare capacity.
+    }
+    return NULL;
+  }
+  mapping->base = new_base;
+  mapping->mapped_bytes = new_bytes;
+  return new_base + CDS_ARRAY_MAP_HEADER_SIZE;
+}
+
+static void mapped_free(void *context, void *ptr, size_t size) {
+  struct cds_array_mapping *mapping = context;
+  (void) ptr;
+  (void) size;
+  munmap(mapping->base, mapping->mapped_bytes);
+  close(mapping->fd);
+  free(mapping);
+}
+
+static struct cds_array_mapping* cds_array_get_mapping(const struct cds_array *array) {
+  if (array->allocator == NULL || array->allocator->free != mapped_free) {
+    return NULL;
+  }
+  return array->allocator->context;
+}
+
+struct cds_array cds_array_open_mapped(const char *path, const size_t element_size, const int flags) {
+  struct cds_array new_array = {
+    .data = NULL,
+    .size = 0,
+    .capacity = 0,
+    .element_size = element_size,
+    .allocator = NULL};
+  const bool readonly = (flags & CDS_ARRAY_MAP_READONLY) != 0;
+  if (element_size == 0 || (readonly && (flags & (CDS_ARRAY_MAP_CREATE | CDS_ARRAY_MAP_TRUNCATE)))) {
+    return new_array;
+  }
+
+  int open_flags = readonly ? O_RDONLY : O_RDWR;
+  if (flags & CDS_ARRAY_MAP_CREATE) open_flags |= O_CREAT;
+  if (flags & CDS_ARRAY_MAP_TRUNCATE) open_flags |= O_TRUNC;
+  const int fd = open(path, open_flags, 0644);
+  if (fd < 0) {
+    return new_array;
+  }
+
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0) {
+    close(fd);
+    return new_array;
+  }
+  size_t file_bytes = (size_t) file_stat.st_size;
+  const bool fresh = file_bytes == 0;
+  if (fresh) {
+    if (readonly) {
+      close(fd);
+      return new_array;
+    }
+    file_bytes = CDS_ARRAY_MAP_HEADER_SIZE + element_size;
+    if (ftruncate(fd, (off_t) file_bytes) != 0) {
+      close(fd);
+      return new_array;
+    }
+  } else if (file_bytes < CDS_ARRAY_MAP_HEADER_SIZE) {
+    close(fd);
+    return new_array;
+  }
+
+  const int prot = readonly ? PROT_READ : PROT_READ | PROT_WRITE;
+  char *base = mmap(NULL, file_bytes, prot, MAP_SHARED, fd, 0);
+  if (base == MAP_FAILED) {
+    close(fd);
+    return new_array;
+  }
+
+  struct cds_array_map_header *header = (struct cds_array_map_header*) base;
+  if (fresh) {
+    memcpy(header->magic, CDS_ARRAY_MAP_MAGIC, sizeof(header->magic));
+    header->element_size = element_size;
+    header->size = 0;
+  } else if (memcmp(header->magic, CDS_ARRAY_MAP_MAGIC, sizeof(header->magic)) != 0 ||
+             header->element_size != element_size ||
+             header->size > (file_bytes - CDS_ARRAY_MAP_HEADER_SIZE) / element_size) {
+    munmap(base, file_bytes);
+    close(fd);
+    return new_array;
+  }
+
+  struct cds_array_mapping *mapping = malloc(sizeof(struct cds_array_mapping));
+  if (mapping == NULL) {
+    munmap(base, file_bytes);
+    close(fd);
+    return new_array;
+  }
+  mapping->allocator.alloc = mapped_alloc;
+  mapping->allocator.realloc = mapped_realloc;
+  mapping->allocator.free = mapped_free;
+  mapping->allocator.context = mapping;
+  mapping->fd = fd;
+  mapping->readonly = readonly;
+  mapping->base = base;
+  mapping->mapped_bytes = file_bytes;
+
+  new_array.data = base + CDS_ARRAY_MAP_HEADER_SIZE;
+  new_array.size = header->size;
+  new_array.capacity = (file_bytes - CDS_ARRAY_MAP_HEADER_SIZE) / element_size;
+  new_array.allocator = &mapping->allocator;
+  return new_array;
+}
+
+int cds_array_flush_mapped(struct cds_array *array, const bool synchronous) {
+  struct cds_array_mapping *mapping = cds_array_get_mapping(array);
+  if (mapping == NULL) {
+    return -1;
+  }
+  if (mapping->readonly) {
+    return 0;
+  }
+  ((struct cds_array_map_header*) mapping->base)->size = array->size;
+  return msync(mapping->base, mapping->mapped_bytes, synchronous ? MS_SYNC : MS_ASYNC) == 0 ? 0 : -1;
+}
+
+int cds_array_advise_mapped(struct cds_array *array, const enum cds_array_map_advice advice) {
+  struct cds_array_mapping *mapping = cds_array_get_mapping(array);
+  if (mapping == NULL) {
+    return -1;
+  }
+  int native_advice = MADV_NORMAL;
+  switch (advice) {
+    case CDS_ARRAY_MAP_ADVICE_NORMAL: native_advice = MADV_NORMAL; break;
+    case CDS_ARRAY_MAP_ADVICE_SEQUENTIAL: native_advice = MADV_SEQUENTIAL; break;
+    case CDS_ARRAY_MAP_ADVICE_RANDOM: native_advice = MADV_RANDOM; break;
+    case CDS_ARRAY_MAP_ADVICE_WILLNEED: native_advice = MADV_WILLNEED; break;
+    default: return -1;
+  }
+  return madvise(mapping->base, mapping->mapped_bytes, native_advice) == 0 ? 0 : -1;
+}
+
+int cds_array_close_mapped(struct cds_array *array) {
+  struct cds_array_mapping *mapping = cds_array_get_mapping(array);
+  if (mapping == NULL) {
+    return -1;
+  }
+  int result = 0;
+  if (!mapping->readonly) {
+    ((struct cds_array_map_header*) mapping->base)->size = array->size;
+    if (msync(mapping->base, mapping->mapped_bytes, MS_SYNC) != 0) {
+      result = -1;
+    }
+    const size_t capacity = array->size == 0 ? 1 : array->size;
+    if (ftruncate(mapping->fd, (off_t) (CDS_ARRAY_MAP_HEADER_SIZE + capacity * array->element_size)) != 0) {
+      result = -1;
+    }
+  }
+  cds_array_delete(array);
+  array->allocator = NULL;
+  return result;
+}
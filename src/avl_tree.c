@@ -28,23 +28,25 @@ static int balance_factor(struct cds_avl_node *node) {
 }
 
 static struct cds_avl_node *new_node(const void *key, const void *value, size_t key_size, 
-                                     size_t element_size, struct cds_avl_node *parent) {
-  struct cds_avl_node *node = (struct cds_avl_node*) malloc(sizeof(struct cds_avl_node));
+                                     size_t element_size, struct cds_avl_node *parent,
+                                     const struct cds_allocator *allocator) {
+  struct cds_avl_node *node = (struct cds_avl_node*) cds_allocator_alloc(allocator,
+                                                                         sizeof(struct cds_avl_node));
   if (node == NULL) {
     return NULL;
   }
 
-  node->key = malloc(key_size);
+  node->key = cds_allocator_alloc(allocator, key_size);
   if (node->key == NULL) {
-    free(node);
+    cds_allocator_free(allocator, node, sizeof(struct cds_avl_node));
     return NULL;
   }
   memcpy(node->key, key, key_size);
 
-  node->value = malloc(element_size);
+  node->value = cds_allocator_alloc(allocator, element_size);
   if (node->value == NULL) {
-    free(node->key);
-    free(node);
+    cds_allocator_free(allocator, node->key, key_size);
+    cds_allocator_free(allocator, node, sizeof(struct cds_avl_node));
     return NULL;
   }
   memcpy(node->value, value, element_size);
@@ -57,11 +59,12 @@ static struct cds_avl_node *new_node(const void *key, const void *value, size_t
   return node;
 }
 
-static void free_node(struct cds_avl_node *node) {
+static void free_node(struct cds_avl_node *node, size_t key_size, size_t element_size,
+                      const struct cds_allocator *allocator) {
   if (node != NULL) {
-    free(node->key);
-    free(node->value);
-    free(node);
+    cds_allocator_free(allocator, node->key, key_size);
+    cds_allocator_free(allocator, node->value, element_size);
+    cds_allocator_free(allocator, node, sizeof(struct cds_avl_node));
   }
 }
 
@@ -131,29 +134,36 @@ static struct cds_avl_node *balance(struct cds_avl_node *node) {
 }
 
 struct cds_avl_tree cds_avl_tree_new(size_t element_size, size_t key_size, int (*cmp)(const void *, const void *)) {
+  return cds_avl_tree_new_with_allocator(element_size, key_size, cmp, &cds_default_allocator);
+}
+
+struct cds_avl_tree cds_avl_tree_new_with_allocator(size_t element_size, size_t key_size,
+                                                    int (*cmp)(const void *, const void *),
+                                                    const struct cds_allocator *allocator) {
   struct cds_avl_tree tree;
   tree.root = NULL;
   tree.element_size = element_size;
   tree.key_size = key_size;
   tree.cmp = cmp;
   tree.size = 0;
+  tree.allocator = allocator;
   return tree;
 }
 
-static void delete_nodes_recursive(struct cds_avl_node *node) {
+static void delete_nodes_recursive(struct cds_avl_node *node, const struct cds_avl_tree *tree) {
   if (node == NULL) {
     return;
   }
-  delete_nodes_recursive(node->left);
-  delete_nodes_recursive(node->right);
-  free_node(node);
+  delete_nodes_recursive(node->left, tree);
+  delete_nodes_recursive(node->right, tree);
+  free_node(node, tree->key_size, tree->element_size, tree->allocator);
 }
 
 void cds_avl_tree_delete(struct cds_avl_tree *tree) {
   if (tree == NULL) {
     return;
   }
-  delete_nodes_recursive(tree->root);
+  delete_nodes_recursive(tree->root, tree);
   tree->root = NULL;
   tree->size = 0;
 }
@@ -161,9 +171,10 @@ void cds_avl_tree_delete(struct cds_avl_tree *tree) {
 static struct cds_avl_node *insert_recursive(struct cds_avl_node *node, const void *key, const void *value,
                                              size_t key_size, size_t element_size,
                                              int (*cmp)(const void *, const void *),
-                                             struct cds_avl_node *parent, int *success_flag) {
+                                             struct cds_avl_node *parent, int *success_flag,
+                                             const struct cds_allocator *allocator) {
   if (node == NULL) {
-    struct cds_avl_node *new_n = new_node(key, value, key_size, element_size, parent);
+    struct cds_avl_node *new_n = new_node(key, value, key_size, element_size, parent, allocator);
     if (new_n == NULL) {
       *success_flag = -1;
       return NULL;
@@ -176,10 +187,10 @@ static struct cds_avl_node *insert_recursive(struct cds_avl_node *node, const vo
 
   if (cmp_res < 0) {
     node->left = insert_recursive(node->left, key, value, key_size,
-                                  element_size, cmp, node, success_flag);
+                                  element_size, cmp, node, success_flag, allocator);
   } else if (cmp_res > 0) {
     node->right = insert_recursive(node->right, key, value, key_size,
-                                   element_size, cmp, node, success_flag);
+                                   element_size, cmp, node, success_flag, allocator);
   } else {
     *success_flag = 0;
     return node;
@@ -203,7 +214,7 @@ int cds_avl_tree_insert(struct cds_avl_tree *tree, const void *key, const void *
 
   int success_flag = 0;
   struct cds_avl_node *new_root = insert_recursive(tree->root, key, value, tree->key_size,
-                       tree->element_size, tree->cmp, NULL, &success_flag);
+                       tree->element_size, tree->cmp, NULL, &success_flag, tree->allocator);
 
   if (success_flag == 1) {
     tree->root = new_root;
@@ -229,7 +240,7 @@ static struct cds_avl_node *min_value_node(struct cds_avl_node *node) {
 
 static struct cds_avl_node *remove_recursive(struct cds_avl_node *node, const void *key,
                  int (*cmp)(const void *, const void *), int *success_flag,
-                 size_t key_size, size_t element_size) {
+                 size_t key_size, size_t element_size, const struct cds_allocator *allocator) {
   if (node == NULL) {
     *success_flag = 0;
     return NULL;
@@ -238,9 +249,11 @@ static struct cds_avl_node *remove_recursive(struct cds_avl_node *node, const vo
   int cmp_res = cmp(key, node->key);
 
   if (cmp_res < 0) {
-    node->left = remove_recursive(node->left, key, cmp, success_flag, key_size, element_size);
+    node->left = remove_recursive(node->left, key, cmp, success_flag, key_size, element_size,
+                                  allocator);
   } else if (cmp_res > 0) {
-    node->right = remove_recursive(node->right, key, cmp, success_flag, key_size, element_size);
+    node->right = remove_recursive(node->right, key, cmp, success_flag, key_size, element_size,
+                                   allocator);
   } else {
     *success_flag = 1;
     struct cds_avl_node *temp = NULL;
@@ -250,7 +263,7 @@ static struct cds_avl_node *remove_recursive(struct cds_avl_node *node, const vo
       if (temp == NULL) {
         temp = node;
         node = NULL;
-        free_node(temp);
+        free_node(temp, key_size, element_size, allocator);
       } else {
         struct cds_avl_node *node_to_free = node;
         if (node->left)
@@ -261,34 +274,18 @@ static struct cds_avl_node *remove_recursive(struct cds_avl_node *node, const vo
         if (temp)
           temp->parent = node->parent;
 
-        free_node(node_to_free);
+        free_node(node_to_free, key_size, element_size, allocator);
         node = temp;
       }
     } else {
       struct cds_avl_node *inorder_successor = min_value_node(node->right);
 
-      free(node->key);
-      free(node->value);
-
-      node->key = malloc(key_size);
-      if (node->key == NULL) {
-        *success_flag = -2;
-        return node;
-      }
       memcpy(node->key, inorder_successor->key, key_size);
-
-      node->value = malloc(element_size);
-      if (node->value == NULL) {
-        free(node->key);
-        node->key = NULL;
-        *success_flag = -2;
-        return node;
-      }
       memcpy(node->value, inorder_successor->value, element_size);
 
       int dummy_flag;
       node->right = remove_recursive(node->right, inorder_successor->key, cmp,
-                                     &dummy_flag, key_size, element_size);
+                                     &dummy_flag, key_size, element_size, allocator);
     }
   }
 
@@ -311,7 +308,7 @@ int cds_avl_tree_remove(struct cds_avl_tree *tree, const void *key) {
 
   int success_flag = 0;
   tree->root = remove_recursive(tree->root, key, tree->cmp, &success_flag,
-                                tree->key_size, tree->element_size);
+                                tree->key_size, tree->element_size, tree->allocator);
 
   if (tree->root != NULL) {
     tree->root->parent = NULL;
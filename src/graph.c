@@ -1,8 +1,10 @@
 #include "cds/graph.h"
+#include "cds/indexed_heap.h"
 #include "cds/queue.h"
 #include "cds/stack.h"
 #include "cds/rb_tree.h"
 #include "cds/list.h"
+#include <math.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -141,3 +143,66 @@ void cds_graph_dfs(const void *start_node,
     cds_stack_delete(&stack);
     cds_rb_tree_delete(&visited);
 }
+
+static int cmp_distance(const void *a, const void *b) {
+    double da = *(const double*)a;
+    double db = *(const double*)b;
+    return (da > db) - (da < db);
+}
+
+int cds_graph_dijkstra(size_t node_count,
+                       size_t source,
+                       CdsGraphGetEdgesFunc get_edges,
+                       double *dist,
+                       size_t *prev) {
+    if (!get_edges || !dist || source >= node_count) {
+        return -1;
+    }
+    for (size_t i = 0; i < node_count; ++i) {
+        dist[i] = INFINITY;
+        if (prev) {
+            prev[i] = CDS_GRAPH_NO_NODE;
+        }
+    }
+
+    struct cds_indexed_heap queue = cds_indexed_heap_new(node_count, sizeof(double), cmp_distance);
+    struct cds_array edges = cds_array_new(sizeof(struct cds_graph_edge));
+    int result = queue.keys && edges.data ? 0 : -1;
+
+    dist[source] = 0.0;
+    if (result == 0) {
+        result = cds_indexed_heap_push(&queue, source, &dist[source]);
+    }
+    while (result == 0 && !cds_indexed_heap_empty(&queue)) {
+        // The closest queued node is settled: no path through the others can be shorter.
+        const size_t u = cds_indexed_heap_top_id(&queue);
+        cds_indexed_heap_pop(&queue);
+
+        edges.size = 0;
+        get_edges(u, &edges);
+        const struct cds_graph_edge *edge = (const struct cds_graph_edge*)edges.data;
+        for (size_t i = 0; i < edges.size; ++i, ++edge) {
+            if (edge->to >= node_count || !(edge->weight >= 0.0)) {
+                result = -1;
+                break;
+            }
+            const double d = dist[u] + edge->weight;
+            if (d < dist[edge->to]) {
+                dist[edge->to] = d;
+                if (prev) {
+                    prev[edge->to] = u;
+                }
+                if (cds_indexed_heap_contains(&queue, edge->to)) {
+                    cds_indexed_heap_decrease_key(&queue, edge->to, &d);
+                } else if (cds_indexed_heap_push(&queue, edge->to, &d) != 0) {
+                    result = -1;
+                    break;
+                }
+            }
+        }
+    }
+
+    cds_array_delete(&edges);
+    cds_indexed_heap_delete(&queue);
+    return result;
+}
@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "cds/allocator.h"
 #include "cds/hashtable.h"
 
 // Define the internal structures for a hash node
@@ -14,6 +15,7 @@ typedef struct cds_hash_node_s {
 struct cds_hashtable_chaining_s {
     size_t size;
     cds_hash_node_t** buckets;
+    const struct cds_allocator* allocator;
 };
 
 // A simple hash function
@@ -27,19 +29,26 @@ static size_t cds_hashtable_chaining_hash(const char* key, size_t table_size) {
 
 // Allocates and initializes the hash table
 cds_hashtable_chaining_t* cds_hashtable_chaining_create(size_t initial_size) {
+    return cds_hashtable_chaining_create_with_allocator(initial_size, &cds_default_allocator);
+}
+
+cds_hashtable_chaining_t* cds_hashtable_chaining_create_with_allocator(size_t initial_size,
+                                                                       const struct cds_allocator* allocator) {
     if (initial_size == 0) {
         return NULL;
     }
-    cds_hashtable_chaining_t* table = malloc(sizeof(cds_hashtable_chaining_t));
+    cds_hashtable_chaining_t* table = cds_allocator_alloc(allocator, sizeof(cds_hashtable_chaining_t));
     if (!table) {
         return NULL;
     }
+    table->allocator = allocator;
     table->size = initial_size;
-    table->buckets = calloc(initial_size, sizeof(cds_hash_node_t*));
+    table->buckets = cds_allocator_alloc(allocator, initial_size * sizeof(cds_hash_node_t*));
     if (!table->buckets) {
-        free(table);
+        cds_allocator_free(table->allocator, table, sizeof(cds_hashtable_chaining_t));
         return NULL;
     }
+    memset(table->buckets, 0, initial_size * sizeof(cds_hash_node_t*));
     return table;
 }
 
@@ -52,14 +61,14 @@ void cds_hashtable_chaining_destroy(cds_hashtable_chaining_t* table) {
         cds_hash_node_t* current = table->buckets[i];
         while (current) {
             cds_hash_node_t* next = current->next;
-            free(current->key); // Assume key was strdup'd
+            cds_allocator_strfree(table->allocator, current->key); // Key was duplicated with the table's allocator
             // User is responsible for freeing the value if it's dynamically allocated
-            free(current);
+            cds_allocator_free(table->allocator, current, sizeof(cds_hash_node_t));
             current = next;
         }
     }
-    free(table->buckets);
-    free(table);
+    cds_allocator_free(table->allocator, table->buckets, table->size * sizeof(cds_hash_node_t*));
+    cds_allocator_free(table->allocator, table, sizeof(cds_hashtable_chaining_t));
 }
 
 // Inserts a key-value pair
@@ -83,13 +92,13 @@ int cds_hashtable_chaining_insert(cds_hashtable_chaining_t* table, const char* k
     }
 
     // Key does not exist, create new node
-    cds_hash_node_t* new_node = malloc(sizeof(cds_hash_node_t));
+    cds_hash_node_t* new_node = cds_allocator_alloc(table->allocator, sizeof(cds_hash_node_t));
     if (!new_node) {
         return -1; // Error: memory allocation failed
     }
-    new_node->key = strdup(key);
+    new_node->key = cds_allocator_strdup(table->allocator, key);
     if (!new_node->key) {
-        free(new_node);
+        cds_allocator_free(table->allocator, new_node, sizeof(cds_hash_node_t));
         return -1; // Error: memory allocation failed for key
     }
     new_node->value = value;
@@ -135,9 +144,9 @@ int cds_hashtable_chaining_delete(cds_hashtable_chaining_t* table, const char* k
             } else {
                 table->buckets[index] = current->next;
             }
-            free(current->key);
+            cds_allocator_strfree(table->allocator, current->key);
             // User is responsible for freeing the value if it's dynamically allocated
-            free(current);
+            cds_allocator_free(table->allocator, current, sizeof(cds_hash_node_t));
             return 0; // Success
         }
         prev = current;
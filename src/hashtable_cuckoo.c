@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "cds/allocator.h"
 #include "cds/hashtable.h"
 
 // Max displacements before considering table full/rehash needed.
@@ -26,35 +27,44 @@ struct cds_hashtable_cuckoo_s {
     cds_hash_function_t hash_func1;
     cds_hash_function_t hash_func2;
     unsigned int max_displacements;
+    const struct cds_allocator* allocator;
 };
 
 // Allocates and initializes the Cuckoo hash table
 cds_hashtable_cuckoo_t* cds_hashtable_cuckoo_create(size_t initial_size_per_table, cds_hash_function_t h1, cds_hash_function_t h2) {
+    return cds_hashtable_cuckoo_create_with_allocator(initial_size_per_table, h1, h2, &cds_default_allocator);
+}
+
+cds_hashtable_cuckoo_t* cds_hashtable_cuckoo_create_with_allocator(size_t initial_size_per_table, cds_hash_function_t h1, cds_hash_function_t h2,
+                                                                   const struct cds_allocator* allocator) {
     if (initial_size_per_table == 0 || !h1 || !h2) {
         return NULL;
     }
-    cds_hashtable_cuckoo_t* table = malloc(sizeof(cds_hashtable_cuckoo_t));
+    cds_hashtable_cuckoo_t* table = cds_allocator_alloc(allocator, sizeof(cds_hashtable_cuckoo_t));
     if (!table) {
         return NULL;
     }
+    table->allocator = allocator;
     table->size = initial_size_per_table;
     table->count = 0;
     table->hash_func1 = h1;
     table->hash_func2 = h2;
     table->max_displacements = DEFAULT_MAX_DISPLACEMENTS; // Or pass as param
 
-    table->table1 = calloc(table->size, sizeof(cds_cuckoo_entry_t));
+    table->table1 = cds_allocator_alloc(allocator, table->size * sizeof(cds_cuckoo_entry_t));
     if (!table->table1) {
-        free(table);
+        cds_allocator_free(table->allocator, table, sizeof(cds_hashtable_cuckoo_t));
         return NULL;
     }
-    table->table2 = calloc(table->size, sizeof(cds_cuckoo_entry_t));
+    table->table2 = cds_allocator_alloc(allocator, table->size * sizeof(cds_cuckoo_entry_t));
     if (!table->table2) {
-        free(table->table1);
-        free(table);
+        cds_allocator_free(table->allocator, table->table1, table->size * sizeof(cds_cuckoo_entry_t));
+        cds_allocator_free(table->allocator, table, sizeof(cds_hashtable_cuckoo_t));
         return NULL;
     }
-    // calloc ensures entries are zeroed, so key pointers are NULL initially.
+    // Zero the entries so key pointers are NULL initially.
+    memset(table->table1, 0, table->size * sizeof(cds_cuckoo_entry_t));
+    memset(table->table2, 0, table->size * sizeof(cds_cuckoo_entry_t));
     return table;
 }
 
@@ -65,17 +75,17 @@ void cds_hashtable_cuckoo_destroy(cds_hashtable_cuckoo_t* table) {
     }
     for (size_t i = 0; i < table->size; i++) {
         if (table->table1[i].key) {
-            free(table->table1[i].key);
+            cds_allocator_strfree(table->allocator, table->table1[i].key);
             // User is responsible for value memory
         }
         if (table->table2[i].key) {
-            free(table->table2[i].key);
+            cds_allocator_strfree(table->allocator, table->table2[i].key);
             // User is responsible for value memory
         }
     }
-    free(table->table1);
-    free(table->table2);
-    free(table);
+    cds_allocator_free(table->allocator, table->table1, table->size * sizeof(cds_cuckoo_entry_t));
+    cds_allocator_free(table->allocator, table->table2, table->size * sizeof(cds_cuckoo_entry_t));
+    cds_allocator_free(table->allocator, table, sizeof(cds_hashtable_cuckoo_t));
 }
 
 // Inserts a key-value pair using Cuckoo hashing
@@ -106,7 +116,7 @@ int cds_hashtable_cuckoo_insert(cds_hashtable_cuckoo_t* table, const char* key,
     }
 
 
-    char* current_key = strdup(key);
+    char* current_key = cds_allocator_strdup(table->allocator, key);
     if (!current_key) return -1; // strdup failed
     void* current_value = value;
 
@@ -149,7 +159,7 @@ int cds_hashtable_cuckoo_insert(cds_hashtable_cuckoo_t* table, const char* key,
 
     // If loop finishes, max_displacements reached. Insertion failed.
     // The `current_key`, `current_value` that couldn't be placed needs to be freed.
-    free(current_key);
+    cds_allocator_strfree(table->allocator, current_key);
     // The original key/value were successfully inserted somewhere, but the last displaced one is homeless.
     // This indicates table is full or needs rehash.
     return -2; // Max displacements reached
@@ -182,7 +192,7 @@ int cds_hashtable_cuckoo_delete(cds_hashtable_cuckoo_t* table, const char* key)
 
     size_t h1 = table->hash_func1(key, table->size);
     if (table->table1[h1].key && strcmp(table->table1[h1].key, key) == 0) {
-        free(table->table1[h1].key);
+        cds_allocator_strfree(table->allocator, table->table1[h1].key);
         table->table1[h1].key = NULL;
         table->table1[h1].value = NULL; // Clear value
         table->count--;
@@ -191,7 +201,7 @@ int cds_hashtable_cuckoo_delete(cds_hashtable_cuckoo_t* table, const char* key)
 
     size_t h2 = table->hash_func2(key, table->size);
     if (table->table2[h2].key && strcmp(table->table2[h2].key, key) == 0) {
-        free(table->table2[h2].key);
+        cds_allocator_strfree(table->allocator, table->table2[h2].key);
         table->table2[h2].key = NULL;
         table->table2[h2].value = NULL; // Clear value
         table->count--;
@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "cds/allocator.h"
 #include "cds/hashtable.h"
 
 // Entry status flags
@@ -22,6 +23,7 @@ struct cds_hashtable_dh_s {
     size_t size;
     size_t count; // Number of OCCUPIED entries
     cds_dh_entry_t* entries;
+    const struct cds_allocator* allocator;
 };
 
 // Primary hash function
@@ -61,18 +63,24 @@ static size_t cds_hashtable_dh_hash2(const char* key, size_t table_size) {
 
 // Allocates and initializes the hash table
 cds_hashtable_dh_t* cds_hashtable_dh_create(size_t initial_size) {
+    return cds_hashtable_dh_create_with_allocator(initial_size, &cds_default_allocator);
+}
+
+cds_hashtable_dh_t* cds_hashtable_dh_create_with_allocator(size_t initial_size,
+                                                           const struct cds_allocator* allocator) {
     if (initial_size == 0) {
         return NULL;
     }
-    cds_hashtable_dh_t* table = malloc(sizeof(cds_hashtable_dh_t));
+    cds_hashtable_dh_t* table = cds_allocator_alloc(allocator, sizeof(cds_hashtable_dh_t));
     if (!table) {
         return NULL;
     }
+    table->allocator = allocator;
     table->size = initial_size;
     table->count = 0;
-    table->entries = malloc(initial_size * sizeof(cds_dh_entry_t));
+    table->entries = cds_allocator_alloc(allocator, initial_size * sizeof(cds_dh_entry_t));
     if (!table->entries) {
-        free(table);
+        cds_allocator_free(table->allocator, table, sizeof(cds_hashtable_dh_t));
         return NULL;
     }
     for (size_t i = 0; i < initial_size; i++) {
@@ -90,11 +98,11 @@ void cds_hashtable_dh_destroy(cds_hashtable_dh_t* table) {
     }
     for (size_t i = 0; i < table->size; i++) {
         if (table->entries[i].status == DH_OCCUPIED || table->entries[i].key != NULL) {
-            free(table->entries[i].key);
+            cds_allocator_strfree(table->allocator, table->entries[i].key);
         }
     }
-    free(table->entries);
-    free(table);
+    cds_allocator_free(table->allocator, table->entries, table->size * sizeof(cds_dh_entry_t));
+    cds_allocator_free(table->allocator, table, sizeof(cds_hashtable_dh_t));
 }
 
 // Inserts a key-value pair using double hashing
@@ -118,7 +126,7 @@ int cds_hashtable_dh_insert(cds_hashtable_dh_t* table, const char* key, void* va
 
         if (table->entries[index].status == DH_EMPTY) {
             size_t insert_pos = (first_deleted_slot != (size_t)-1) ? first_deleted_slot : index;
-            table->entries[insert_pos].key = strdup(key);
+            table->entries[insert_pos].key = cds_allocator_strdup(table->allocator, key);
             if (!table->entries[insert_pos].key) {
                 return -1; // strdup failed
             }
@@ -142,7 +150,7 @@ int cds_hashtable_dh_insert(cds_hashtable_dh_t* table, const char* key, void* va
     // If loop finishes, we couldn't find an EMPTY slot.
     // If we found a DELETED slot during probing, use it.
     if (first_deleted_slot != (size_t)-1) {
-        table->entries[first_deleted_slot].key = strdup(key);
+        table->entries[first_deleted_slot].key = cds_allocator_strdup(table->allocator, key);
         if (!table->entries[first_deleted_slot].key) {
             return -1; // strdup failed
         }
@@ -191,7 +199,7 @@ int cds_hashtable_dh_delete(cds_hashtable_dh_t* table, const char* key) {
 
         if (table->entries[index].status == DH_OCCUPIED) {
             if (strcmp(table->entries[index].key, key) == 0) {
-                free(table->entries[index].key);
+                cds_allocator_strfree(table->allocator, table->entries[index].key);
                 table->entries[index].key = NULL;
                 table->entries[index].value = NULL;
                 table->entries[index].status = DH_DELETED;
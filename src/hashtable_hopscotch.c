@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdint.h> // For uint32_t or uint64_t
+#include "cds/allocator.h"
 #include "cds/hashtable.h"
 
 // Define H: Neighborhood size. Typically word size like 32 or 64.
@@ -23,6 +24,7 @@ struct cds_hashtable_hopscotch_s {
     size_t count;   // Number of items in the table
     unsigned int H; // Actual neighborhood size used (should match hop_info type)
     cds_hopscotch_entry_t* entries;
+    const struct cds_allocator* allocator;
 };
 
 // Primary hash function
@@ -36,6 +38,11 @@ static size_t cds_hashtable_hopscotch_hash(const char* key, size_t table_size) {
 
 // Allocates and initializes the Hopscotch hash table
 cds_hashtable_hopscotch_t* cds_hashtable_hopscotch_create(size_t initial_size, unsigned int H_neighborhood_size) {
+    return cds_hashtable_hopscotch_create_with_allocator(initial_size, H_neighborhood_size, &cds_default_allocator);
+}
+
+cds_hashtable_hopscotch_t* cds_hashtable_hopscotch_create_with_allocator(size_t initial_size, unsigned int H_neighborhood_size,
+                                                                         const struct cds_allocator* allocator) {
     if (initial_size == 0) {
         return NULL;
     }
@@ -49,10 +56,11 @@ cds_hashtable_hopscotch_t* cds_hashtable_hopscotch_create(size_t initial_size, u
     }
 
 
-    cds_hashtable_hopscotch_t* table = malloc(sizeof(cds_hashtable_hopscotch_t));
+    cds_hashtable_hopscotch_t* table = cds_allocator_alloc(allocator, sizeof(cds_hashtable_hopscotch_t));
     if (!table) {
         return NULL;
     }
+    table->allocator = allocator;
     table->size = initial_size;
     table->count = 0;
     table->H = actual_H;
@@ -60,12 +68,13 @@ cds_hashtable_hopscotch_t* cds_hashtable_hopscotch_create(size_t initial_size, u
     // This simplifies finding an empty slot without wrapping around immediately.
     // However, core hopscotch logic usually works within 'size' and handles wrapping.
     // Let's stick to 'size' for entries and handle wrapping.
-    table->entries = calloc(table->size, sizeof(cds_hopscotch_entry_t));
+    table->entries = cds_allocator_alloc(allocator, table->size * sizeof(cds_hopscotch_entry_t));
     if (!table->entries) {
-        free(table);
+        cds_allocator_free(table->allocator, table, sizeof(cds_hashtable_hopscotch_t));
         return NULL;
     }
-    // calloc zeroes entries: key is NULL, hop_info is 0.
+    // Zero the entries: key is NULL, hop_info is 0.
+    memset(table->entries, 0, table->size * sizeof(cds_hopscotch_entry_t));
     return table;
 }
 
@@ -76,12 +85,12 @@ void cds_hashtable_hopscotch_destroy(cds_hashtable_hopscotch_t* table) {
     }
     for (size_t i = 0; i < table->size; i++) {
         if (table->entries[i].key) {
-            free(table->entries[i].key);
+            cds_allocator_strfree(table->allocator, table->entries[i].key);
             // User responsible for value memory
         }
     }
-    free(table->entries);
-    free(table);
+    cds_allocator_free(table->allocator, table->entries, table->size * sizeof(cds_hopscotch_entry_t));
+    cds_allocator_free(table->allocator, table, sizeof(cds_hashtable_hopscotch_t));
 }
 
 // Inserts a key-value pair using Hopscotch hashing
@@ -205,7 +214,7 @@ int cds_hashtable_hopscotch_insert(cds_hashtable_hopscotch_t* table, const char*
     // At this point, empty_slot_idx is within H distance of original_hash_idx
     // So, (empty_slot_idx - original_hash_idx + table->size) % table->size < table->H
 
-    table->entries[empty_slot_idx].key = strdup(key);
+    table->entries[empty_slot_idx].key = cds_allocator_strdup(table->allocator, key);
     if (!table->entries[empty_slot_idx].key) {
         // This is bad, we might have an empty slot marked but strdup failed.
         // Simplest is to return error. More complex would be to revert state.
@@ -253,7 +262,7 @@ int cds_hashtable_hopscotch_delete(cds_hashtable_hopscotch_t* table, const char*
             size_t item_idx = (original_hash_idx + i) % table->size;
             if (table->entries[item_idx].key && strcmp(table->entries[item_idx].key, key) == 0) {
                 // Found the item
-                free(table->entries[item_idx].key);
+                cds_allocator_strfree(table->allocator, table->entries[item_idx].key);
                 table->entries[item_idx].key = NULL;
                 table->entries[item_idx].value = NULL;
 
@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "cds/allocator.h"
 #include "cds/hashtable.h"
 
 // Entry status flags
@@ -22,6 +23,7 @@ struct cds_hashtable_lp_s {
     size_t size;
     size_t count; // Number of OCCUPIED entries, for load factor
     cds_lp_entry_t* entries;
+    const struct cds_allocator* allocator;
 };
 
 // Hash function (same as chaining for simplicity, can be different)
@@ -35,18 +37,24 @@ static size_t cds_hashtable_lp_hash(const char* key, size_t table_size) {
 
 // Allocates and initializes the hash table
 cds_hashtable_lp_t* cds_hashtable_lp_create(size_t initial_size) {
+    return cds_hashtable_lp_create_with_allocator(initial_size, &cds_default_allocator);
+}
+
+cds_hashtable_lp_t* cds_hashtable_lp_create_with_allocator(size_t initial_size,
+                                                           const struct cds_allocator* allocator) {
     if (initial_size == 0) {
         return NULL;
     }
-    cds_hashtable_lp_t* table = malloc(sizeof(cds_hashtable_lp_t));
+    cds_hashtable_lp_t* table = cds_allocator_alloc(allocator, sizeof(cds_hashtable_lp_t));
     if (!table) {
         return NULL;
     }
+    table->allocator = allocator;
     table->size = initial_size;
     table->count = 0;
-    table->entries = malloc(initial_size * sizeof(cds_lp_entry_t));
+    table->entries = cds_allocator_alloc(allocator, initial_size * sizeof(cds_lp_entry_t));
     if (!table->entries) {
-        free(table);
+        cds_allocator_free(table->allocator, table, sizeof(cds_hashtable_lp_t));
         return NULL;
     }
     for (size_t i = 0; i < initial_size; i++) {
@@ -64,11 +72,11 @@ void cds_hashtable_lp_destroy(cds_hashtable_lp_t* table) {
     }
     for (size_t i = 0; i < table->size; i++) {
         if (table->entries[i].status == OCCUPIED || (table->entries[i].key != NULL)) { // Key might exist even if DELETED
-            free(table->entries[i].key);
+            cds_allocator_strfree(table->allocator, table->entries[i].key);
         }
     }
-    free(table->entries);
-    free(table);
+    cds_allocator_free(table->allocator, table->entries, table->size * sizeof(cds_lp_entry_t));
+    cds_allocator_free(table->allocator, table, sizeof(cds_hashtable_lp_t));
 }
 
 // Inserts a key-value pair using linear probing
@@ -90,7 +98,7 @@ int cds_hashtable_lp_insert(cds_hashtable_lp_t* table, const char* key, void* va
             // Found an empty slot. If we passed a DELETED slot, use that one.
             size_t insert_pos = (first_deleted_slot != (size_t)-1) ? first_deleted_slot : index;
 
-            table->entries[insert_pos].key = strdup(key);
+            table->entries[insert_pos].key = cds_allocator_strdup(table->allocator, key);
             if (!table->entries[insert_pos].key) {
                 return -1; // strdup failed
             }
@@ -117,7 +125,7 @@ int cds_hashtable_lp_insert(cds_hashtable_lp_t* table, const char* key, void* va
     // If we are here, it means table is full and no existing key was found.
     // If there was a deleted slot, we can use it.
     if (first_deleted_slot != (size_t)-1) {
-        table->entries[first_deleted_slot].key = strdup(key);
+        table->entries[first_deleted_slot].key = cds_allocator_strdup(table->allocator, key);
         if (!table->entries[first_deleted_slot].key) {
             return -1; // strdup failed
         }
@@ -165,7 +173,7 @@ int cds_hashtable_lp_delete(cds_hashtable_lp_t* table, const char* key) {
     do {
         if (table->entries[index].status == OCCUPIED) {
             if (strcmp(table->entries[index].key, key) == 0) {
-                free(table->entries[index].key); // Free the strdup'd key
+                cds_allocator_strfree(table->allocator, table->entries[index].key); // Free the strdup'd key
                 table->entries[index].key = NULL; // Avoid dangling pointer if this slot is reused
                 table->entries[index].value = NULL; // Clear value
                 table->entries[index].status = DELETED;
@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "cds/allocator.h"
 #include "cds/hashtable.h"
 
 // Entry status flags (can be shared if defined in a common internal header, or redefined)
@@ -23,6 +24,7 @@ struct cds_hashtable_qp_s {
     size_t count; // Number of OCCUPIED entries
     cds_qp_entry_t* entries;
     // For h(k) + i*i, no c1, c2 needed explicitly in struct if we stick to i*i
+    const struct cds_allocator* allocator;
 };
 
 // Primary hash function
@@ -36,18 +38,24 @@ static size_t cds_hashtable_qp_hash(const char* key, size_t table_size) {
 
 // Allocates and initializes the hash table
 cds_hashtable_qp_t* cds_hashtable_qp_create(size_t initial_size) {
+    return cds_hashtable_qp_create_with_allocator(initial_size, &cds_default_allocator);
+}
+
+cds_hashtable_qp_t* cds_hashtable_qp_create_with_allocator(size_t initial_size,
+                                                           const struct cds_allocator* allocator) {
     if (initial_size == 0) {
         return NULL;
     }
-    cds_hashtable_qp_t* table = malloc(sizeof(cds_hashtable_qp_t));
+    cds_hashtable_qp_t* table = cds_allocator_alloc(allocator, sizeof(cds_hashtable_qp_t));
     if (!table) {
         return NULL;
     }
+    table->allocator = allocator;
     table->size = initial_size;
     table->count = 0;
-    table->entries = malloc(initial_size * sizeof(cds_qp_entry_t));
+    table->entries = cds_allocator_alloc(allocator, initial_size * sizeof(cds_qp_entry_t));
     if (!table->entries) {
-        free(table);
+        cds_allocator_free(table->allocator, table, sizeof(cds_hashtable_qp_t));
         return NULL;
     }
     for (size_t i = 0; i < initial_size; i++) {
@@ -65,11 +73,11 @@ void cds_hashtable_qp_destroy(cds_hashtable_qp_t* table) {
     }
     for (size_t i = 0; i < table->size; i++) {
         if (table->entries[i].status == QP_OCCUPIED || table->entries[i].key != NULL) {
-            free(table->entries[i].key);
+            cds_allocator_strfree(table->allocator, table->entries[i].key);
         }
     }
-    free(table->entries);
-    free(table);
+    cds_allocator_free(table->allocator, table->entries, table->size * sizeof(cds_qp_entry_t));
+    cds_allocator_free(table->allocator, table, sizeof(cds_hashtable_qp_t));
 }
 
 // Inserts a key-value pair using quadratic probing
@@ -117,7 +125,7 @@ int cds_hashtable_qp_insert(cds_hashtable_qp_t* table, const char* key, void* va
             // we must ensure the key doesn't actually exist at 'index' if 'index' was probed before 'first_deleted_slot'
             // This logic gets complicated. A common strategy is to insert at first available (EMPTY or DELETED).
 
-            table->entries[actual_insert_index].key = strdup(key);
+            table->entries[actual_insert_index].key = cds_allocator_strdup(table->allocator, key);
             if (!table->entries[actual_insert_index].key) {
                 return -1; // strdup failed
             }
@@ -141,7 +149,7 @@ int cds_hashtable_qp_insert(cds_hashtable_qp_t* table, const char* key, void* va
     // If loop finishes, we couldn't find an EMPTY slot.
     // If we found a DELETED slot, we can use it.
     if (first_deleted_slot != (size_t)-1) {
-        table->entries[first_deleted_slot].key = strdup(key);
+        table->entries[first_deleted_slot].key = cds_allocator_strdup(table->allocator, key);
         if (!table->entries[first_deleted_slot].key) {
             return -1; // strdup failed
         }
@@ -188,7 +196,7 @@ int cds_hashtable_qp_delete(cds_hashtable_qp_t* table, const char* key) {
 
         if (table->entries[index].status == QP_OCCUPIED) {
             if (strcmp(table->entries[index].key, key) == 0) {
-                free(table->entries[index].key);
+                cds_allocator_strfree(table->allocator, table->entries[index].key);
                 table->entries[index].key = NULL;
                 table->entries[index].value = NULL;
                 table->entries[index].status = QP_DELETED;
@@ -4,10 +4,28 @@
 #include "cds/array.h"
 
 struct cds_heap cds_heap_new(size_t element_size, int (*cmp)(const void *, const void *)) {
-  struct cds_heap new_heap = {
-    .data = cds_array_new(element_size),
-    .cmp = cmp};
-  new_heap.data.size = 1;
+  return cds_heap_new_with_allocator(element_size, cmp, &cds_default_allocator);
+}
+
+struct cds_heap cds_heap_new_with_allocator(size_t element_size, int (*cmp)(const void *, const void *),
+                                            const struct cds_allocator *allocator) {
+  return cds_heap_new_dary_with_allocator(element_size, cmp, 2, allocator);
+}
+
+struct cds_heap cds_heap_new_dary(size_t element_size, int (*cmp)(const void *, const void *), size_t arity) {
+  return cds_heap_new_dary_with_allocator(element_size, cmp, arity, &cds_cache_line_allocator);
+}
+
+struct cds_heap cds_heap_new_dary_with_allocator(size_t element_size, int (*cmp)(const void *, const void *),
+                                                 size_t arity, const struct cds_allocator *allocator) {
+  struct cds_heap new_heap = {.cmp = cmp, .arity = arity};
+  if (arity != 2 && arity != 4 && arity != 8) {
+    return new_heap;
+  }
+  new_heap.data = cds_array_new_with_allocator(element_size, allocator);
+  if (new_heap.data.data != NULL && cds_array_resize(&new_heap.data, arity - 1) != 0) {
+    cds_array_delete(&new_heap.data);
+  }
   return new_heap;
 }
 
@@ -16,80 +34,167 @@ void cds_heap_delete(struct cds_heap *heap) {
   heap->cmp = NULL;
 }
 
-int cds_heap_increase_key(struct cds_heap *heap) {
-  size_t i = heap->data.size - 1;
-  while(i > 1 && heap->cmp(cds_array_at(&heap->data, i >> 1), cds_array_at(&heap->data, i)) > 0) {
-    static char tp[1024] = {0};
-    if (heap->data.element_size < 1024) {
-      memmove(tp, cds_array_at(&heap->data, i >> 1), heap->data.element_size);
-      memmove(cds_array_at(&heap->data, i >> 1), cds_array_at(&heap->data, i),
-        heap->data.element_size);
-      memmove(cds_array_at(&heap->data, i), tp, heap->data.element_size);
-    } else {
-      return -1;
+static inline unsigned cds_heap_shift(const struct cds_heap *heap) {
+  return heap->arity == 2 ? 1 : heap->arity == 4 ? 2 : 3;
+}
+
+/*
+ * Index i of data holds node i - (arity - 1), whose children are nodes (i - arity + 1) * arity + 1 to
+ * (i - arity + 2) * arity, i.e. indices (i - arity + 2) * arity onwards, and whose parent is at
+ * (i - arity) / arity + arity - 1. For arity 2 this is the usual 1-based layout.
+ */
+
+// Moves the ancestors of the hole at index i that come after element down by one level each and
+// returns the index where element belongs.
+static size_t cds_heap_sift_up(struct cds_heap *heap, size_t i, const void *element) {
+  const size_t root = heap->arity - 1, es = heap->data.element_size;
+  const unsigned shift = cds_heap_shift(heap);
+  char *data = heap->data.data;
+  while (i > root) {
+    const size_t parent = ((i - heap->arity) >> shift) + root;
+    if (heap->cmp(data + parent * es, element) <= 0) {
+      break;
     }
-    i >>= 1;
+    memcpy(data + i * es, data + parent * es, es);
+    i = parent;
   }
-  return 0;
+  return i;
 }
 
-int cds_heap_push(struct cds_heap *heap, const void *new_element) {
-  if (cds_array_push_back(&heap->data, new_element) != 0) {
-    return -1;
+// Moves the first child of the hole at index i up while it comes before element and returns the index
+// where element belongs. Only indices below end are part of the heap.
+static size_t cds_heap_sift_down(struct cds_heap *heap, size_t i, size_t end, const void *element) {
+  const size_t arity = heap->arity, es = heap->data.element_size;
+  const unsigned shift = cds_heap_shift(heap);
+  char *data = heap->data.data;
+  for (;;) {
+    const size_t first = (i - arity + 2) << shift;
+    if (first >= end) {
+      break;
+    }
+    const size_t last = first + arity < end ? first + arity : end;
+    size_t best = first;
+    for (size_t c = first + 1; c < last; c++) {
+      if (heap->cmp(data + c * es, data + best * es) < 0) {
+        best = c;
+      }
+    }
+    if (heap->cmp(data + best * es, element) >= 0) {
+      break;
+    }
+    memcpy(data + i * es, data + best * es, es);
+    i = best;
   }
-  if (cds_heap_increase_key(heap) != 0) {
-    return -1;
+  return i;
+}
+
+// Sifts down every parent below end, from the last one to the root, leaving a heap (Floyd's method).
+// The slot at end must be allocated; it holds each node while the hole moves down.
+static void cds_heap_heapify(struct cds_heap *heap, size_t end) {
+  const size_t root = heap->arity - 1, es = heap->data.element_size;
+  if (end <= root + 1) {
+    return;
+  }
+  char *data = heap->data.data, *scratch = data + end * es;
+  for (size_t i = ((end - 1 - heap->arity) >> cds_heap_shift(heap)) + root + 1; i-- > root;) {
+    memcpy(scratch, data + i * es, es);
+    const size_t j = cds_heap_sift_down(heap, i, end, scratch);
+    if (j != i) {
+      memcpy(data + j * es, scratch, es);
+    }
   }
-  return 0;
 }
 
-size_t cds_heap_get_smallest(struct cds_heap *heap, size_t index) {
-  size_t l = index << 1;
-  size_t r = index << 1 | 1;
-  size_t smallest = index;
-  if (l <= cds_heap_size(heap) &&
-      heap->cmp(cds_array_at(&heap->data, l), cds_array_at(&heap->data, smallest)) < 0) {
-    smallest = l;
+struct cds_heap cds_heap_from_array(struct cds_array *array, int (*cmp)(const void *, const void *),
+                                    size_t arity) {
+  struct cds_heap new_heap = {.cmp = cmp, .arity = arity};
+  const size_t n = array->size, pad = arity - 1, es = array->element_size;
+  if ((arity != 2 && arity != 4 && arity != 8) || array->data == NULL ||
+      cds_array_reserve(array, n + arity) != 0) {
+    return new_heap;
   }
-  if (r <= cds_heap_size(heap) &&
-      heap->cmp(cds_array_at(&heap->data, r), cds_array_at(&heap->data, smallest)) < 0) {
-    smallest = r;
+  // The first pad elements move past the others; order does not matter before heapifying.
+  const size_t moved = n < pad ? n : pad;
+  memcpy(array->data + (n > pad ? n : pad) * es, array->data, moved * es);
+  array->size = n + pad;
+  new_heap.data = *array;
+  *array = (struct cds_array) {.element_size = es, .allocator = array->allocator};
+  cds_heap_heapify(&new_heap, new_heap.data.size);
+  return new_heap;
+}
+
+int cds_heap_push(struct cds_heap *heap, const void *new_element) {
+  if (heap->data.data == NULL || cds_array_emplace_back(&heap->data) == NULL) {
+    return -1;
   }
-  return smallest;
+  const size_t i = cds_heap_sift_up(heap, heap->data.size - 1, new_element);
+  memcpy(heap->data.data + i * heap->data.element_size, new_element, heap->data.element_size);
+  return 0;
 }
 
-void cds_heap_min_heapify(struct cds_heap *heap, size_t index) {
-  size_t smallest = cds_heap_get_smallest(heap, index);
-  while(smallest != index) {
-    static char tp[1024] = {0};
-    memmove(tp, cds_array_at(&heap->data, index), heap->data.element_size);
-    memmove(cds_array_at(&heap->data, index), cds_array_at(&heap->data, smallest),
-      heap->data.element_size);
-    memmove(cds_array_at(&heap->data, smallest), tp, heap->data.element_size);
-    index = smallest;
-    smallest = cds_heap_get_smallest(heap, smallest);
+int cds_heap_push_n(struct cds_heap *heap, const void *new_elements, size_t count) {
+  const size_t size = heap->data.size, es = heap->data.element_size, old_count = cds_heap_size(heap);
+  if (heap->data.data == NULL || cds_array_push_back_n(&heap->data, new_elements, count) != 0) {
+    return -1;
+  }
+  // One slot past the end holds each element while its hole moves.
+  if (cds_array_emplace_back(&heap->data) == NULL) {
+    heap->data.size = size;
+    return -1;
   }
+  const size_t end = --heap->data.size;
+  if (count >= old_count) {
+    cds_heap_heapify(heap, end);
+    return 0;
+  }
+  char *data = heap->data.data, *scratch = data + end * es;
+  for (size_t k = size; k < end; k++) {
+    memcpy(scratch, data + k * es, es);
+    const size_t i = cds_heap_sift_up(heap, k, scratch);
+    if (i != k) {
+      memcpy(data + i * es, scratch, es);
+    }
+  }
+  return 0;
 }
 
 int cds_heap_pop(struct cds_heap *heap) {
-  memmove(cds_array_at(&heap->data, 1),
-    cds_array_at(&heap->data, heap->data.size - 1),
-    heap->data.element_size);
-  if (cds_array_pop_back(&heap->data) != 0) {
+  if (cds_heap_empty(heap)) {
     return -1;
   }
-  cds_heap_min_heapify(heap, 1);
+  // The last element stays in its slot, now past the end, until its place is found.
+  const size_t end = --heap->data.size, es = heap->data.element_size;
+  const char *last = heap->data.data + end * es;
+  const size_t i = cds_heap_sift_down(heap, heap->arity - 1, end, last);
+  if (i != end) {
+    memcpy(heap->data.data + i * es, last, es);
+  }
   return 0;
 }
 
+size_t cds_heap_pop_n(struct cds_heap *heap, void *out, size_t k) {
+  const size_t root = heap->arity - 1, es = heap->data.element_size;
+  char *dest = out;
+  size_t popped = 0;
+  for (; popped < k && !cds_heap_empty(heap); popped++, dest += es) {
+    memcpy(dest, heap->data.data + root * es, es);
+    cds_heap_pop(heap);
+  }
+  return popped;
+}
+
 void* cds_heap_top(const struct cds_heap *heap) {
-  return cds_array_at(&heap->data, 1);
+  return cds_heap_empty(heap) ? NULL : cds_array_at(&heap->data, heap->arity - 1);
 }
 
 size_t cds_heap_size(const struct cds_heap *heap) {
-  return heap->data.size - 1;
+  // A heap whose creation failed has no padding slots, and its arity may be anything.
+  if (heap->data.data == NULL || heap->data.size < heap->arity) {
+    return 0;
+  }
+  return heap->data.size - (heap->arity - 1);
 }
 
 bool cds_heap_empty(const struct cds_heap *heap) {
   return cds_heap_size(heap) == 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,204 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "cds/indexed_heap.h"
+
+static bool cds_indexed_heap_alloc(struct cds_indexed_heap *heap, size_t capacity) {
+  const struct cds_allocator *allocator = heap->allocator;
+  const size_t widest = heap->element_size > sizeof(size_t) ? heap->element_size : sizeof(size_t);
+  if (capacity > SIZE_MAX / widest) {
+    return false;
+  }
+  char *keys = cds_allocator_alloc(allocator, capacity * heap->element_size);
+  size_t *ids = cds_allocator_alloc(allocator, capacity * sizeof(size_t));
+  size_t *positions = cds_allocator_alloc(allocator, capacity * sizeof(size_t));
+  if (keys == NULL || ids == NULL || positions == NULL) {
+    cds_allocator_free(allocator, keys, capacity * heap->element_size);
+    cds_allocator_free(allocator, ids, capacity * sizeof(size_t));
+    cds_allocator_free(allocator, positions, capacity * sizeof(size_t));
+    return false;
+  }
+  if (heap->keys != NULL) {
+    memcpy(keys, heap->keys, heap->size * heap->element_size);
+    memcpy(ids, heap->ids, heap->size * sizeof(size_t));
+    memcpy(positions, heap->positions, heap->capacity * sizeof(size_t));
+    cds_allocator_free(allocator, heap->keys, heap->capacity * heap->element_size);
+    cds_allocator_free(allocator, heap->ids, heap->capacity * sizeof(size_t));
+    cds_allocator_free(allocator, heap->positions, heap->capacity * sizeof(size_t));
+  }
+  for (size_t id = heap->keys != NULL ? heap->capacity : 0; id < capacity; id++) {
+    positions[id] = CDS_INDEXED_HEAP_ABSENT;
+  }
+  heap->keys = keys;
+  heap->ids = ids;
+  heap->positions = positions;
+  heap->capacity = capacity;
+  return true;
+}
+
+struct cds_indexed_heap cds_indexed_heap_new(size_t capacity, size_t element_size,
+                                             int (*cmp)(const void *, const void *)) {
+  return cds_indexed_heap_new_with_allocator(capacity, element_size, cmp, &cds_default_allocator);
+}
+
+struct cds_indexed_heap cds_indexed_heap_new_with_allocator(size_t capacity, size_t element_size,
+                                                            int (*cmp)(const void *, const void *),
+                                                            const struct cds_allocator *allocator) {
+  struct cds_indexed_heap heap = {.element_size = element_size, .cmp = cmp, .allocator = allocator};
+  cds_indexed_heap_alloc(&heap, capacity > 0 ? capacity : 1);
+  return heap;
+}
+
+void cds_indexed_heap_delete(struct cds_indexed_heap *heap) {
+  if (heap->keys != NULL) {
+    cds_allocator_free(heap->allocator, heap->keys, heap->capacity * heap->element_size);
+    cds_allocator_free(heap->allocator, heap->ids, heap->capacity * sizeof(size_t));
+    cds_allocator_free(heap->allocator, heap->positions, heap->capacity * sizeof(size_t));
+  }
+  heap->keys = NULL;
+  heap->ids = NULL;
+  heap->positions = NULL;
+  heap->size = heap->capacity = 0;
+  heap->cmp = NULL;
+}
+
+static inline void cds_indexed_heap_place(struct cds_indexed_heap *heap, size_t i, const void *key,
+                                          size_t id) {
+  memcpy(heap->keys + i * heap->element_size, key, heap->element_size);
+  heap->ids[i] = id;
+  heap->positions[id] = i;
+}
+
+// Moves the ancestors of the hole at index i whose priority comes after key down by one level each
+// and returns the index where key belongs.
+static size_t cds_indexed_heap_sift_up(struct cds_indexed_heap *heap, size_t i, const void *key) {
+  const size_t es = heap->element_size;
+  while (i > 0) {
+    const size_t parent = (i - 1) / CDS_INDEXED_HEAP_ARITY;
+    const char *parent_key = heap->keys + parent * es;
+    if (heap->cmp(parent_key, key) <= 0) {
+      break;
+    }
+    cds_indexed_heap_place(heap, i, parent_key, heap->ids[parent]);
+    i = parent;
+  }
+  return i;
+}
+
+// Moves the first child of the hole at index i up while its priority comes before key and returns
+// the index where key belongs.
+static size_t cds_indexed_heap_sift_down(struct cds_indexed_heap *heap, size_t i, const void *key) {
+  const size_t es = heap->element_size, size = heap->size;
+  for (;;) {
+    const size_t first = i * CDS_INDEXED_HEAP_ARITY + 1;
+    if (first >= size) {
+      break;
+    }
+    const size_t last = size - first > CDS_INDEXED_HEAP_ARITY ? first + CDS_INDEXED_HEAP_ARITY : size;
+    size_t best = first;
+    for (size_t c = first + 1; c < last; c++) {
+      if (heap->cmp(heap->keys + c * es, heap->keys + best * es) < 0) {
+        best = c;
+      }
+    }
+    if (heap->cmp(heap->keys + best * es, key) >= 0) {
+      break;
+    }
+    cds_indexed_heap_place(heap, i, heap->keys + best * es, heap->ids[best]);
+    i = best;
+  }
+  return i;
+}
+
+int cds_indexed_heap_push(struct cds_indexed_heap *heap, size_t id, const void *priority) {
+  if (id == CDS_INDEXED_HEAP_ABSENT || cds_indexed_heap_contains(heap, id)) {
+    return -1;
+  }
+  if (id >= heap->capacity) {
+    const size_t doubled = heap->capacity > SIZE_MAX / 2 ? SIZE_MAX : 2 * heap->capacity;
+    const size_t capacity = id >= doubled ? id + 1 : doubled;
+    if (!cds_indexed_heap_alloc(heap, capacity)) {
+      return -1;
+    }
+  }
+  const size_t i = cds_indexed_heap_sift_up(heap, heap->size++, priority);
+  cds_indexed_heap_place(heap, i, priority, id);
+  return 0;
+}
+
+int cds_indexed_heap_remove(struct cds_indexed_heap *heap, size_t id) {
+  if (!cds_indexed_heap_contains(heap, id)) {
+    return -1;
+  }
+  const size_t hole = heap->positions[id], end = --heap->size;
+  heap->positions[id] = CDS_INDEXED_HEAP_ABSENT;
+  if (hole == end) {
+    return 0;
+  }
+  // The last entry stays in its slot, now past the end, until its place is found.
+  const char *last = heap->keys + end * heap->element_size;
+  size_t i = cds_indexed_heap_sift_up(heap, hole, last);
+  if (i == hole) {
+    i = cds_indexed_heap_sift_down(heap, hole, last);
+  }
+  cds_indexed_heap_place(heap, i, last, heap->ids[end]);
+  return 0;
+}
+
+int cds_indexed_heap_pop(struct cds_indexed_heap *heap) {
+  if (heap->size == 0) {
+    return -1;
+  }
+  return cds_indexed_heap_remove(heap, heap->ids[0]);
+}
+
+void* cds_indexed_heap_top(const struct cds_indexed_heap *heap) {
+  return heap->size > 0 ? heap->keys : NULL;
+}
+
+size_t cds_indexed_heap_top_id(const struct cds_indexed_heap *heap) {
+  return heap->size > 0 ? heap->ids[0] : CDS_INDEXED_HEAP_ABSENT;
+}
+
+void* cds_indexed_heap_priority(const struct cds_indexed_heap *heap, size_t id) {
+  if (!cds_indexed_heap_contains(heap, id)) {
+    return NULL;
+  }
+  return heap->keys + heap->positions[id] * heap->element_size;
+}
+
+bool cds_indexed_heap_contains(const struct cds_indexed_heap *heap, size_t id) {
+  return id < heap->capacity && heap->positions[id] != CDS_INDEXED_HEAP_ABSENT;
+}
+
+int cds_indexed_heap_decrease_key(struct cds_indexed_heap *heap, size_t id, const void *priority) {
+  if (!cds_indexed_heap_contains(heap, id)) {
+    return -1;
+  }
+  const size_t hole = heap->positions[id];
+  if (heap->cmp(priority, heap->keys + hole * heap->element_size) > 0) {
+    return -1;
+  }
+  cds_indexed_heap_place(heap, cds_indexed_heap_sift_up(heap, hole, priority), priority, id);
+  return 0;
+}
+
+int cds_indexed_heap_increase_key(struct cds_indexed_heap *heap, size_t id, const void *priority) {
+  if (!cds_indexed_heap_contains(heap, id)) {
+    return -1;
+  }
+  const size_t hole = heap->positions[id];
+  if (heap->cmp(priority, heap->keys + hole * heap->element_size) < 0) {
+    return -1;
+  }
+  cds_indexed_heap_place(heap, cds_indexed_heap_sift_down(heap, hole, priority), priority, id);
+  return 0;
+}
+
+size_t cds_indexed_heap_size(const struct cds_indexed_heap *heap) {
+  return heap->size;
+}
+
+bool cds_indexed_heap_empty(const struct cds_indexed_heap *heap) {
+  return heap->size == 0;
+}
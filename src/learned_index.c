@@ -0,0 +1,245 @@
+#include <math.h>
+
+#include "cds/learned_index.h"
+
+/*
+ * Segments are fitted greedily with a shrinking cone: the first point of a segment is its origin and
+ * every further point narrows the range of slopes that keep all points within eps of the line. The
+ * segment is closed at the first point that would leave the range empty, and that point starts the
+ * next one. Each segment covers at least two points as long as eps >= 1.
+ */
+struct fit {
+  struct cds_learned_segment *out;  // NULL to only count the segments
+  size_t count;
+  double eps;
+  bool open;
+  uint64_t x0;
+  double y0, lo, hi;
+};
+
+static void fit_close(struct fit *f) {
+  if (f->out) {
+    f->out[f->count] = (struct cds_learned_segment) {
+      .key = f->x0, .slope = f->hi == INFINITY ? 0.0 : (f->lo + f->hi) / 2, .intercept = f->y0
+    };
+  }
+  f->count++;
+}
+
+static void fit_add(struct fit *f, uint64_t x, double y) {
+  if (f->open) {
+    const double dx = (double) (x - f->x0);
+    const double lo = (y - f->eps - f->y0) / dx, hi = (y + f->eps - f->y0) / dx;
+    if (lo <= f->hi && hi >= f->lo) {
+      f->lo = lo > f->lo ? lo : f->lo;
+      f->hi = hi < f->hi ? hi : f->hi;
+      return;
+    }
+    fit_close(f);
+  }
+  f->open = true;
+  f->x0 = x;
+  f->y0 = y;
+  f->lo = 0.0;
+  f->hi = INFINITY;
+}
+
+static size_t fit_finish(struct fit *f) {
+  if (f->open) {
+    fit_close(f);
+  }
+  return f->count;
+}
+
+/*
+ * The points over the keys are (key, index of its first occurrence). A run of equal keys also gets the
+ * point (key + 1, index after the run): the keys between it and the next key have that lower bound,
+ * and without the point the line could stay near the start of a long run across the whole gap. Unique
+ * keys need no such point, the final search window is one position wider instead.
+ */
+static bool fit_keys(const uint64_t *keys, size_t n, double eps, struct cds_learned_segment *out,
+                     size_t *count) {
+  struct fit f = {.out = out, .eps = eps};
+  for (size_t i = 0, j; i < n; i = j) {
+    const uint64_t key = keys[i];
+    for (j = i + 1; j < n && keys[j] == key; j++) {}
+    if (j < n && keys[j] < key) {
+      return false;
+    }
+    fit_add(&f, key, (double) i);
+    if (j - i > 1 && j < n && keys[j] > key + 1) {
+      fit_add(&f, key + 1, (double) j);
+    }
+  }
+  *count = fit_finish(&f);
+  return true;
+}
+
+static size_t fit_segments(const struct cds_learned_segment *below, size_t m, double eps,
+                           struct cds_learned_segment *out) {
+  struct fit f = {.out = out, .eps = eps};
+  for (size_t i = 0; i < m; i++) {
+    fit_add(&f, below[i].key, (double) i);
+  }
+  return fit_finish(&f);
+}
+
+// The predicted position of key, which lies between the first point of the segment and limit, the
+// first point of the next one.
+static inline size_t predict(const struct cds_learned_segment *segment, uint64_t key, double limit) {
+  double pos = segment->intercept + segment->slope * (double) (key - segment->key);
+  pos = pos < segment->intercept ? segment->intercept : pos;
+  return (size_t) (pos > limit ? limit : pos);
+}
+
+// The last segment of level [0, count) whose first key is not after key. The model puts it within
+// eps + 1 of pos; the window is checked at both ends and widened if rounding moved it.
+static size_t find_segment(const struct cds_learned_segment *level, size_t count, size_t pos, size_t eps,
+                           uint64_t key) {
+  size_t lo = pos > eps + 2 ? pos - eps - 2 : 0;
+  size_t hi = pos + eps + 2 < count ? pos + eps + 2 : count;
+  // The window spans a few cache lines; fetching them together overlaps their misses.
+  for (size_t i = lo; i < hi; i += 2) __builtin_prefetch(level + i);
+  if (level[lo].key > key) {
+    hi = lo;
+    lo = 0;
+  } else if (hi < count && level[hi].key <= key) {
+    lo = hi;
+    hi = count;
+  }
+  size_t len = hi - lo;
+  while (len > 1) {
+    const size_t half = len / 2;
+    lo += (size_t) (level[lo + half].key <= key) * half;
+    len -= half;
+  }
+  return lo;
+}
+
+static size_t keys_lower_bound(const uint64_t *keys, size_t lo, size_t hi, uint64_t key) {
+  if (lo >= hi) return lo;
+  for (size_t i = lo; i < hi; i += 8) __builtin_prefetch(keys + i);  // see find_segment
+  __builtin_prefetch(keys + hi - 1);
+  const uint64_t *base = keys + lo;
+  size_t len = hi - lo;
+  while (len > 1) {
+    const size_t half = len / 2;
+    base += (size_t) (base[half - 1] < key) * half;
+    len -= half;
+  }
+  return (size_t) (base - keys) + (*base < key);
+}
+
+struct cds_learned_index cds_learned_index_new(const struct cds_array *sorted, size_t epsilon) {
+  return cds_learned_index_new_with_allocator(sorted, epsilon, &cds_default_allocator);
+}
+
+struct cds_learned_index cds_learned_index_new_with_allocator(const struct cds_array *sorted, size_t epsilon,
+                                                              const struct cds_allocator *allocator) {
+  struct cds_learned_index index = {.allocator = allocator};
+  if (!sorted || sorted->element_size != sizeof(uint64_t)) {
+    return index;
+  }
+  index.keys = (const uint64_t*) sorted->data;
+  index.size = sorted->size;
+  index.epsilon = epsilon == 0 ? CDS_LEARNED_INDEX_DEFAULT_EPSILON : epsilon;
+
+  size_t count;
+  if (!fit_keys(index.keys, index.size, (double) index.epsilon, NULL, &count)) {
+    return index;
+  }
+  // Every level above the first has at most half the segments of the one below, plus one.
+  size_t capacity = 2 * count + CDS_LEARNED_INDEX_MAX_LEVELS;
+  struct cds_learned_segment *segments = cds_allocator_alloc(allocator, capacity * sizeof(*segments));
+  if (!segments) {
+    return index;
+  }
+  fit_keys(index.keys, index.size, (double) index.epsilon, segments, &count);
+  index.level_offset[0] = 0;
+  index.level_offset[1] = count;
+  index.levels = count > 0;
+  while (index.levels > 0 && index.levels < CDS_LEARNED_INDEX_MAX_LEVELS &&
+         index.level_offset[index.levels] - index.level_offset[index.levels - 1] > 1) {
+    const size_t first = index.level_offset[index.levels - 1], last = index.level_offset[index.levels];
+    count = fit_segments(segments + first, last - first, CDS_LEARNED_INDEX_INTERNAL_EPSILON,
+                         segments + last);
+    index.levels++;
+    index.level_offset[index.levels] = last + count;
+  }
+
+  index.segment_count = index.levels > 0 ? index.level_offset[index.levels] : 0;
+  const size_t used = index.segment_count > 0 ? index.segment_count : 1;
+  struct cds_learned_segment *shrunk = cds_allocator_realloc(allocator, segments,
+                                                             capacity * sizeof(*segments),
+                                                             used * sizeof(*segments));
+  if (!shrunk) {
+    cds_allocator_free(allocator, segments, capacity * sizeof(*segments));
+    return index;
+  }
+  index.segments = shrunk;
+  return index;
+}
+
+void cds_learned_index_delete(struct cds_learned_index *index) {
+  if (index->segments != NULL) {
+    const size_t used = index->segment_count > 0 ? index->segment_count : 1;
+    cds_allocator_free(index->allocator, index->segments, used * sizeof(*index->segments));
+  }
+  index->segments = NULL;
+  index->segment_count = 0;
+  index->levels = 0;
+  index->keys = NULL;
+  index->size = 0;
+}
+
+size_t cds_learned_index_lower_bound(const struct cds_learned_index *index, uint64_t key) {
+  if (!index || !index->segments) {
+    return 0;
+  }
+  const uint64_t *keys = index->keys;
+  const size_t n = index->size;
+  if (n == 0 || key <= keys[0]) {
+    return 0;
+  }
+  if (key > keys[n - 1]) {
+    return n;
+  }
+
+  // The top level is a single segment. Each level predicts where key falls among the segments below.
+  const struct cds_learned_segment *segments = index->segments;
+  size_t s = index->level_offset[index->levels - 1];
+  for (size_t l = index->levels - 1; l > 0; l--) {
+    const size_t below = index->level_offset[l - 1], count = index->level_offset[l] - below;
+    const double limit = s + 1 < index->level_offset[l + 1] ? segments[s + 1].intercept : (double) count;
+    const size_t pos = predict(&segments[s], key, limit);
+    s = below + find_segment(segments + below, count, pos, CDS_LEARNED_INDEX_INTERNAL_EPSILON, key);
+  }
+
+  // The lower bound is within [pos - epsilon, pos + epsilon + 1]; the checks at both ends only fail if
+  // rounding moved the prediction.
+  const double limit = s + 1 < index->level_offset[1] ? segments[s + 1].intercept : (double) n;
+  const size_t pos = predict(&segments[s], key, limit), eps = index->epsilon;
+  size_t lo = pos > eps ? pos - eps : 0;
+  size_t hi = pos + eps + 1 < n ? pos + eps + 1 : n;
+  if (lo > 0 && keys[lo - 1] >= key) {
+    hi = lo;
+    lo = 0;
+  } else if (hi < n && keys[hi] < key) {
+    lo = hi + 1;
+    hi = n;
+  }
+  return keys_lower_bound(keys, lo, hi, key);
+}
+
+const uint64_t *cds_learned_index_lookup(const struct cds_learned_index *index, uint64_t key) {
+  const size_t i = cds_learned_index_lower_bound(index, key);
+  return index && index->segments && i < index->size && index->keys[i] == key ? &index->keys[i] : NULL;
+}
+
+size_t cds_learned_index_size(const struct cds_learned_index *index) {
+  return index->size;
+}
+
+bool cds_learned_index_empty(const struct cds_learned_index *index) {
+  return index->size == 0;
+}
@@ -5,13 +5,18 @@
 #include "cds/list.h"
 
 struct cds_list_node* cds_list_node_new(void *data, const size_t element_size) {
-  struct cds_list_node *new_node = malloc(sizeof(struct cds_list_node));
+  return cds_list_node_new_with_allocator(data, element_size, &cds_default_allocator);
+}
+
+struct cds_list_node* cds_list_node_new_with_allocator(void *data, const size_t element_size,
+                                                       const struct cds_allocator *allocator) {
+  struct cds_list_node *new_node = cds_allocator_alloc(allocator, sizeof(struct cds_list_node));
   if (new_node == NULL) {
     return NULL;
   }
-  new_node->data = malloc(element_size);
+  new_node->data = cds_allocator_alloc(allocator, element_size);
   if (new_node->data == NULL) {
-    free(new_node);
+    cds_allocator_free(allocator, new_node, sizeof(struct cds_list_node));
     return NULL;
   }
   memcpy(new_node->data, data, element_size);
@@ -24,6 +29,12 @@ void cds_list_node_delete(struct cds_list_node *node) {
   free(node);
 }
 
+void cds_list_node_delete_with_allocator(struct cds_list_node *node, const size_t element_size,
+                                         const struct cds_allocator *allocator) {
+  cds_allocator_free(allocator, node->data, element_size);
+  cds_allocator_free(allocator, node, sizeof(struct cds_list_node));
+}
+
 void cds_list_node_set_data(struct cds_list_node *node, void *data, const size_t element_size) {
   memcpy(node->data, data, element_size);
 }
@@ -38,11 +49,17 @@ void cds_list_node_set_prev(struct cds_list_node *node, struct cds_list_node *pr
 
 
 struct cds_list cds_list_new(const size_t element_size) {
+  return cds_list_new_with_allocator(element_size, &cds_default_allocator);
+}
+
+struct cds_list cds_list_new_with_allocator(const size_t element_size,
+                                            const struct cds_allocator *allocator) {
   struct cds_list new_list = {
     .head = NULL,
     .tail = NULL,
     .size = 0,
-    .element_size = element_size};
+    .element_size = element_size,
+    .allocator = allocator};
   return new_list;
 }
 
@@ -50,7 +67,7 @@ void cds_list_delete(struct cds_list *list) {
   struct cds_list_node *head = list->head;
   while (head != NULL) {
     struct cds_list_node *next = head->next;
-    cds_list_node_delete(head);
+    cds_list_node_delete_with_allocator(head, list->element_size, list->allocator);
     head = next;
   }
   list->head = list->tail = NULL;
@@ -58,7 +75,8 @@ void cds_list_delete(struct cds_list *list) {
 }
 
 int cds_list_push_front(struct cds_list *list, void *new_element) {
-  struct cds_list_node *new_node = cds_list_node_new(new_element, list->element_size);
+  struct cds_list_node *new_node = cds_list_node_new_with_allocator(new_element, list->element_size,
+                                                                    list->allocator);
   if (new_node == NULL) {
     return -1;
   }
@@ -74,7 +92,8 @@ int cds_list_push_front(struct cds_list *list, void *new_element) {
 }
 
 int cds_list_push_back(struct cds_list *list, void *new_element) {
-  struct cds_list_node *new_node = cds_list_node_new(new_element, list->element_size);
+  struct cds_list_node *new_node = cds_list_node_new_with_allocator(new_element, list->element_size,
+                                                                    list->allocator);
   if (new_node == NULL) {
     return -1;
   }
@@ -101,7 +120,7 @@ int cds_list_pop_front(struct cds_list *list) {
     list->tail = NULL;
   }
   if (head != NULL) {
-    cds_list_node_delete(head);
+    cds_list_node_delete_with_allocator(head, list->element_size, list->allocator);
   }
   list->size--;
   return 0;
@@ -119,14 +138,15 @@ int cds_list_pop_back(struct cds_list *list) {
     list->head = NULL;
   }
   if (tail != NULL) {
-    cds_list_node_delete(tail);
+    cds_list_node_delete_with_allocator(tail, list->element_size, list->allocator);
   }
   list->size--;
   return 0;
 }
 
 int cds_list_insert(struct cds_list *list, struct cds_list_node *position, void *new_element) {
-  struct cds_list_node *new_node = cds_list_node_new(new_element, list->element_size);
+  struct cds_list_node *new_node = cds_list_node_new_with_allocator(new_element, list->element_size,
+                                                                    list->allocator);
   if (new_node == NULL) {
     return -1;
   }
@@ -155,7 +175,7 @@ int cds_list_remove(struct cds_list *list, struct cds_list_node *position) {
   } else {
     list->head = next;
   }
-  cds_list_node_delete(position);
+  cds_list_node_delete_with_allocator(position, list->element_size, list->allocator);
   list->size--;
   return 0;
 }
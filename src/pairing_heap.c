@@ -0,0 +1,213 @@
+#include <string.h>
+
+#include "cds/pairing_heap.h"
+
+// A block of nodes; the nodes follow the header.
+struct cds_pairing_heap_chunk {
+  struct cds_pairing_heap_chunk *next;
+  size_t bytes;
+};
+
+struct cds_pairing_heap cds_pairing_heap_new(size_t element_size, int (*cmp)(const void *, const void *)) {
+  return cds_pairing_heap_new_with_allocator(element_size, cmp, &cds_default_allocator);
+}
+
+struct cds_pairing_heap cds_pairing_heap_new_with_allocator(size_t element_size,
+                                                            int (*cmp)(const void *, const void *),
+                                                            const struct cds_allocator *allocator) {
+  const size_t node_size = sizeof(struct cds_pairing_heap_node) + ((element_size + 7) & ~(size_t) 7);
+  // NULL is resolved here so that cds_pairing_heap_meld can compare allocators.
+  struct cds_pairing_heap new_heap = {
+    .element_size = element_size, .node_size = node_size, .cmp = cmp,
+    .allocator = allocator != NULL ? allocator : &cds_default_allocator};
+  return new_heap;
+}
+
+void cds_pairing_heap_delete(struct cds_pairing_heap *heap) {
+  struct cds_pairing_heap_chunk *chunk = heap->chunks;
+  while (chunk != NULL) {
+    struct cds_pairing_heap_chunk *next = chunk->next;
+    cds_allocator_free(heap->allocator, chunk, chunk->bytes);
+    chunk = next;
+  }
+  heap->root = heap->free_head = heap->free_tail = NULL;
+  heap->chunks = heap->last_chunk = NULL;
+  heap->size = 0;
+  heap->cmp = NULL;
+}
+
+// Takes a node from the pool, carving a new chunk into free nodes when it is empty.
+static struct cds_pairing_heap_node* cds_pairing_heap_node_alloc(struct cds_pairing_heap *heap) {
+  if (heap->free_head == NULL) {
+    const size_t header = sizeof(struct cds_pairing_heap_chunk);
+    size_t count = (CDS_PAIRING_HEAP_CHUNK_BYTES - header) / heap->node_size;
+    count = count > 0 ? count : 1;
+    const size_t bytes = header + count * heap->node_size;
+    struct cds_pairing_heap_chunk *chunk = cds_allocator_alloc(heap->allocator, bytes);
+    if (chunk == NULL) {
+      return NULL;
+    }
+    chunk->next = NULL;
+    chunk->bytes = bytes;
+    if (heap->last_chunk != NULL) {
+      heap->last_chunk->next = chunk;
+    } else {
+      heap->chunks = chunk;
+    }
+    heap->last_chunk = chunk;
+
+    char *nodes = (char*) chunk + header;
+    for (size_t i = 0; i < count; i++) {
+      ((struct cds_pairing_heap_node*) (nodes + i * heap->node_size))->next =
+        i + 1 < count ? (struct cds_pairing_heap_node*) (nodes + (i + 1) * heap->node_size) : NULL;
+    }
+    heap->free_head = (struct cds_pairing_heap_node*) nodes;
+    heap->free_tail = (struct cds_pairing_heap_node*) (nodes + (count - 1) * heap->node_size);
+  }
+  struct cds_pairing_heap_node *node = heap->free_head;
+  heap->free_head = node->next;
+  if (heap->free_head == NULL) {
+    heap->free_tail = NULL;
+  }
+  return node;
+}
+
+static void cds_pairing_heap_node_free(struct cds_pairing_heap *heap, struct cds_pairing_heap_node *node) {
+  node->next = heap->free_head;
+  if (heap->free_head == NULL) {
+    heap->free_tail = node;
+  }
+  heap->free_head = node;
+}
+
+// Makes the root that comes later the first child of the other and returns the new root. Both must be
+// roots, with no siblings.
+static struct cds_pairing_heap_node* cds_pairing_heap_link(const struct cds_pairing_heap *heap,
+                                                           struct cds_pairing_heap_node *a,
+                                                           struct cds_pairing_heap_node *b) {
+  if (heap->cmp(b->element, a->element) < 0) {
+    struct cds_pairing_heap_node *t = a;
+    a = b;
+    b = t;
+  }
+  b->next = a->child;
+  if (a->child != NULL) {
+    a->child->prev = b;
+  }
+  b->prev = a;
+  a->child = b;
+  return a;
+}
+
+struct cds_pairing_heap_node* cds_pairing_heap_push(struct cds_pairing_heap *heap, const void *new_element) {
+  struct cds_pairing_heap_node *node = cds_pairing_heap_node_alloc(heap);
+  if (node == NULL) {
+    return NULL;
+  }
+  node->child = node->next = node->prev = NULL;
+  memcpy(node->element, new_element, heap->element_size);
+  heap->root = heap->root != NULL ? cds_pairing_heap_link(heap, heap->root, node) : node;
+  heap->size++;
+  return node;
+}
+
+int cds_pairing_heap_pop(struct cds_pairing_heap *heap) {
+  struct cds_pairing_heap_node *old_root = heap->root;
+  if (old_root == NULL) {
+    return -1;
+  }
+  // First pass: link the children in pairs from left to right, stacking the results through next so
+  // that the second pass, which links them into one tree, runs from right to left.
+  struct cds_pairing_heap_node *children = old_root->child, *pairs = NULL;
+  while (children != NULL) {
+    struct cds_pairing_heap_node *a = children, *b = a->next;
+    children = b != NULL ? b->next : NULL;
+    a->next = a->prev = NULL;
+    if (b != NULL) {
+      b->next = b->prev = NULL;
+      a = cds_pairing_heap_link(heap, a, b);
+    }
+    a->next = pairs;
+    pairs = a;
+  }
+  struct cds_pairing_heap_node *root = pairs;
+  if (root != NULL) {
+    pairs = root->next;
+    root->next = NULL;
+    while (pairs != NULL) {
+      struct cds_pairing_heap_node *next = pairs->next;
+      pairs->next = NULL;
+      root = cds_pairing_heap_link(heap, root, pairs);
+      pairs = next;
+    }
+  }
+  heap->root = root;
+  heap->size--;
+  cds_pairing_heap_node_free(heap, old_root);
+  return 0;
+}
+
+void* cds_pairing_heap_top(const struct cds_pairing_heap *heap) {
+  return heap->root != NULL ? heap->root->element : NULL;
+}
+
+int cds_pairing_heap_meld(struct cds_pairing_heap *heap, struct cds_pairing_heap *other) {
+  if (heap == other || heap->element_size != other->element_size || heap->cmp != other->cmp ||
+      heap->allocator != other->allocator) {
+    return -1;
+  }
+  if (other->root != NULL) {
+    heap->root = heap->root != NULL ? cds_pairing_heap_link(heap, heap->root, other->root) : other->root;
+    heap->size += other->size;
+  }
+  if (other->chunks != NULL) {
+    if (heap->last_chunk != NULL) {
+      heap->last_chunk->next = other->chunks;
+    } else {
+      heap->chunks = other->chunks;
+    }
+    heap->last_chunk = other->last_chunk;
+  }
+  if (other->free_head != NULL) {
+    other->free_tail->next = heap->free_head;
+    if (heap->free_head == NULL) {
+      heap->free_tail = other->free_tail;
+    }
+    heap->free_head = other->free_head;
+  }
+  other->root = other->free_head = other->free_tail = NULL;
+  other->chunks = other->last_chunk = NULL;
+  other->size = 0;
+  return 0;
+}
+
+int cds_pairing_heap_decrease_key(struct cds_pairing_heap *heap, struct cds_pairing_heap_node *node,
+                                  const void *element) {
+  if (heap->cmp(element, node->element) > 0) {
+    return -1;
+  }
+  memcpy(node->element, element, heap->element_size);
+  if (node == heap->root) {
+    return 0;
+  }
+  // Cut the node, with its subtree, out of its parent's list of children.
+  if (node->prev->child == node) {
+    node->prev->child = node->next;
+  } else {
+    node->prev->next = node->next;
+  }
+  if (node->next != NULL) {
+    node->next->prev = node->prev;
+  }
+  node->next = node->prev = NULL;
+  heap->root = cds_pairing_heap_link(heap, heap->root, node);
+  return 0;
+}
+
+size_t cds_pairing_heap_size(const struct cds_pairing_heap *heap) {
+  return heap->size;
+}
+
+bool cds_pairing_heap_empty(const struct cds_pairing_heap *heap) {
+  return heap->size == 0;
+}
@@ -7,17 +7,23 @@
 #ifdef CDS_QUEUE_IMPL_WITH_ARRAY
 
 struct cds_queue cds_queue_new(const size_t element_size) {
+  return cds_queue_new_with_allocator(element_size, &cds_default_allocator);
+}
+
+struct cds_queue cds_queue_new_with_allocator(const size_t element_size,
+                                              const struct cds_allocator *allocator) {
   struct cds_queue new_queue = {
-    .data = (char*) malloc(element_size),
+    .data = (char*) cds_allocator_alloc(allocator, element_size),
     .size = 0,
     .capacity = 1,
     .element_size = element_size,
-    .front = 0};
+    .front = 0,
+    .allocator = allocator};
   return new_queue;
 }
 
 void cds_queue_delete(struct cds_queue *queue) {
-  free(queue->data);
+  cds_allocator_free(queue->allocator, queue->data, queue->capacity * queue->element_size);
   queue->data = NULL;
   queue->size = queue->capacity = 0;
   queue->element_size = 0;
@@ -26,13 +32,14 @@ void cds_queue_delete(struct cds_queue *queue) {
 
 int cds_queue_push(struct cds_queue *queue, const void *new_element) {
   if (queue->size == queue->capacity) {
-    queue->capacity <<= 1;  // cap * 2
-    char *tp_buf = (char*) malloc(queue->capacity * queue->element_size);
+    const size_t old_capacity = queue->capacity;
+    char *tp_buf = (char*) cds_allocator_alloc(queue->allocator,
+      (old_capacity << 1) * queue->element_size);  // cap * 2
     if (tp_buf == NULL) {
       return -1;
     }
-    if (queue->front + queue->size >= queue->capacity) {
-      const size_t tail_length = queue->capacity - queue->front;
+    if (queue->front + queue->size > old_capacity) {
+      const size_t tail_length = old_capacity - queue->front;
       memmove(tp_buf, queue->data + queue->front * queue->element_size,
         tail_length * queue->element_size);
       memmove(tp_buf + tail_length * queue->element_size, queue->data,
@@ -41,6 +48,10 @@ int cds_queue_push(struct cds_queue *queue, const void *new_element) {
       memmove(tp_buf, queue->data + queue->front * queue->element_size,
         queue->size * queue->element_size);
     }
+    cds_allocator_free(queue->allocator, queue->data, old_capacity * queue->element_size);
+    queue->data = tp_buf;
+    queue->capacity = old_capacity << 1;
+    queue->front = 0;
   }
   memcpy(queue->data + ((queue->front + queue->size) % queue->capacity) * queue->element_size,
     new_element, queue->element_size);
@@ -64,7 +75,9 @@ void* cds_queue_front(const struct cds_queue *queue) {
 #else
 
 // TODO: link list implmented queue
-struct cds_queue cds_queue_new(size_t element_size)
+struct cds_queue cds_queue_new(size_t element_size);
+struct cds_queue cds_queue_new_with_allocator(size_t element_size,
+                                              const struct cds_allocator *allocator);
 void cds_queue_delete(struct cds_queue *queue);
 int cds_queue_push(struct cds_queue *queue, const void *new_element);
 int cds_queue_pop(struct cds_queue *queue);
@@ -0,0 +1,141 @@
+#include <string.h>
+
+#include "cds/radix_heap.h"
+
+// The size of an entry: the key, then the element padded to a multiple of 8 bytes.
+static inline size_t cds_radix_heap_entry_size(size_t element_size) {
+  return sizeof(uint64_t) + ((element_size + 7) & ~(size_t) 7);
+}
+
+// The bucket of key relative to last: 0 if equal, otherwise one more than the highest differing bit.
+static inline size_t cds_radix_heap_bucket(uint64_t key, uint64_t last) {
+  return key == last ? 0 : 64 - (size_t) __builtin_clzll(key ^ last);
+}
+
+struct cds_radix_heap cds_radix_heap_new(size_t element_size, cds_key_func key) {
+  return cds_radix_heap_new_with_allocator(element_size, key, &cds_default_allocator);
+}
+
+struct cds_radix_heap cds_radix_heap_new_with_allocator(size_t element_size, cds_key_func key,
+                                                        const struct cds_allocator *allocator) {
+  struct cds_radix_heap new_heap = {.element_size = element_size, .key = key};
+  const size_t entry_size = cds_radix_heap_entry_size(element_size);
+  for (size_t b = 0; b < CDS_RADIX_HEAP_BUCKETS; b++) {
+    new_heap.buckets[b] = cds_array_new_with_allocator(entry_size, allocator);
+    if (new_heap.buckets[b].data == NULL) {
+      cds_radix_heap_delete(&new_heap);
+      break;
+    }
+  }
+  return new_heap;
+}
+
+void cds_radix_heap_delete(struct cds_radix_heap *heap) {
+  for (size_t b = 0; b < CDS_RADIX_HEAP_BUCKETS; b++) {
+    cds_array_delete(&heap->buckets[b]);
+  }
+  heap->size = 0;
+  heap->occupied = 0;
+  heap->key = NULL;
+}
+
+int cds_radix_heap_push(struct cds_radix_heap *heap, const void *new_element) {
+  // A heap whose creation failed, or that was deleted, has no key function and no buckets.
+  if (heap->key == NULL || heap->buckets[0].data == NULL) {
+    return -1;
+  }
+  const uint64_t key = heap->key(new_element);
+  if (key < heap->last) {
+    return -1;
+  }
+  const size_t b = cds_radix_heap_bucket(key, heap->last);
+  char *entry = cds_array_emplace_back(&heap->buckets[b]);
+  if (entry == NULL) {
+    return -1;
+  }
+  memcpy(entry, &key, sizeof(key));
+  memcpy(entry + sizeof(key), new_element, heap->element_size);
+  if (b > 0) {
+    heap->occupied |= (uint64_t) 1 << (b - 1);
+  }
+  heap->size++;
+  return 0;
+}
+
+// Makes room for count more entries in bucket, doubling its capacity at least.
+static int cds_radix_heap_reserve(struct cds_array *bucket, size_t count) {
+  const size_t needed = bucket->size + count;
+  if (needed <= bucket->capacity) {
+    return 0;
+  }
+  return cds_array_reserve(bucket, needed > 2 * bucket->capacity ? needed : 2 * bucket->capacity);
+}
+
+// Refills bucket 0 when it is empty: the smallest key in the lowest nonempty bucket becomes last, and
+// that bucket's entries move to lower buckets relative to it. Nothing changes if allocation fails.
+static int cds_radix_heap_refill(struct cds_radix_heap *heap) {
+  const size_t source = (size_t) __builtin_ctzll(heap->occupied) + 1;
+  struct cds_array *from = &heap->buckets[source];
+  const size_t entry_size = from->element_size;
+
+  uint64_t last = UINT64_MAX, key;
+  for (const char *entry = from->data, *end = entry + from->size * entry_size; entry < end;
+       entry += entry_size) {
+    memcpy(&key, entry, sizeof(key));
+    last = key < last ? key : last;
+  }
+
+  // All keys share the bits above source - 1 with last, so every entry moves to a lower bucket.
+  size_t counts[CDS_RADIX_HEAP_BUCKETS - 1] = {0};
+  for (const char *entry = from->data, *end = entry + from->size * entry_size; entry < end;
+       entry += entry_size) {
+    memcpy(&key, entry, sizeof(key));
+    counts[cds_radix_heap_bucket(key, last)]++;
+  }
+  for (size_t b = 0; b < source; b++) {
+    if (counts[b] > 0 && cds_radix_heap_reserve(&heap->buckets[b], counts[b]) != 0) {
+      return -1;
+    }
+  }
+
+  for (const char *entry = from->data, *end = entry + from->size * entry_size; entry < end;
+       entry += entry_size) {
+    memcpy(&key, entry, sizeof(key));
+    struct cds_array *to = &heap->buckets[cds_radix_heap_bucket(key, last)];
+    memcpy(to->data + to->size++ * entry_size, entry, entry_size);
+  }
+  from->size = 0;
+  heap->occupied &= ~((uint64_t) 1 << (source - 1));
+  for (size_t b = 1; b < source; b++) {
+    if (counts[b] > 0) {
+      heap->occupied |= (uint64_t) 1 << (b - 1);
+    }
+  }
+  heap->last = last;
+  return 0;
+}
+
+int cds_radix_heap_pop(struct cds_radix_heap *heap) {
+  if (heap->size == 0 || (heap->buckets[0].size == 0 && cds_radix_heap_refill(heap) != 0)) {
+    return -1;
+  }
+  heap->buckets[0].size--;
+  heap->size--;
+  return 0;
+}
+
+void* cds_radix_heap_top(struct cds_radix_heap *heap) {
+  if (heap->size == 0 || (heap->buckets[0].size == 0 && cds_radix_heap_refill(heap) != 0)) {
+    return NULL;
+  }
+  const struct cds_array *bucket = &heap->buckets[0];
+  return bucket->data + (bucket->size - 1) * bucket->element_size + sizeof(uint64_t);
+}
+
+size_t cds_radix_heap_size(const struct cds_radix_heap *heap) {
+  return heap->size;
+}
+
+bool cds_radix_heap_empty(const struct cds_radix_heap *heap) {
+  return heap->size == 0;
+}
@@ -15,9 +15,16 @@ static void delete_nodes_recursive(struct cds_rb_tree *tree, struct cds_rb_node
 
 struct cds_rb_tree cds_rb_tree_new(size_t element_size, size_t key_size,
                                    int (*cmp)(const void *, const void *)) {
+  return cds_rb_tree_new_with_allocator(element_size, key_size, cmp, &cds_default_allocator);
+}
+
+struct cds_rb_tree cds_rb_tree_new_with_allocator(size_t element_size, size_t key_size,
+                                                  int (*cmp)(const void *, const void *),
+                                                  const struct cds_allocator *allocator) {
   struct cds_rb_tree tree;
+  tree.allocator = allocator;
 
-  tree.nil = (struct cds_rb_node *)malloc(sizeof(struct cds_rb_node));
+  tree.nil = (struct cds_rb_node *)cds_allocator_alloc(allocator, sizeof(struct cds_rb_node));
   if (tree.nil == NULL) {
     tree.cmp = NULL;
     tree.size = 0;
@@ -42,21 +49,22 @@ struct cds_rb_tree cds_rb_tree_new(size_t element_size, size_t key_size,
 }
 
 static struct cds_rb_node *new_node(struct cds_rb_tree *tree, const void *key, const void *value) {
-  struct cds_rb_node *node = (struct cds_rb_node *)malloc(sizeof(struct cds_rb_node));
+  struct cds_rb_node *node = (struct cds_rb_node *)cds_allocator_alloc(tree->allocator,
+                                                                       sizeof(struct cds_rb_node));
   if (node == NULL)
     return NULL;
 
-  node->key = malloc(tree->key_size);
+  node->key = cds_allocator_alloc(tree->allocator, tree->key_size);
   if (node->key == NULL) {
-    free(node);
+    cds_allocator_free(tree->allocator, node, sizeof(struct cds_rb_node));
     return NULL;
   }
   memcpy(node->key, key, tree->key_size);
 
-  node->value = malloc(tree->element_size);
+  node->value = cds_allocator_alloc(tree->allocator, tree->element_size);
   if (node->value == NULL) {
-    free(node->key);
-    free(node);
+    cds_allocator_free(tree->allocator, node->key, tree->key_size);
+    cds_allocator_free(tree->allocator, node, sizeof(struct cds_rb_node));
     return NULL;
   }
   memcpy(node->value, value, tree->element_size);
@@ -71,9 +79,9 @@ static struct cds_rb_node *new_node(struct cds_rb_tree *tree, const void *key, c
 
 static void free_node(struct cds_rb_node *node, struct cds_rb_tree *tree) {
   if (node != tree->nil) {
-    free(node->key);
-    free(node->value);
-    free(node);
+    cds_allocator_free(tree->allocator, node->key, tree->key_size);
+    cds_allocator_free(tree->allocator, node->value, tree->element_size);
+    cds_allocator_free(tree->allocator, node, sizeof(struct cds_rb_node));
   }
 }
 
@@ -355,7 +363,7 @@ void cds_rb_tree_delete(struct cds_rb_tree *tree) {
     return;
   }
   delete_nodes_recursive(tree, tree->root);
-  free(tree->nil);
+  cds_allocator_free(tree->allocator, tree->nil, sizeof(struct cds_rb_node));
   tree->root = NULL;
   tree->nil = NULL;
   tree->size = 0;
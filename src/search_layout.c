@@ -0,0 +1,289 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "cds/search_layout.h"
+#include "cds/sort.h"
+
+#define CACHE_LINE 64
+
+static unsigned floor_log2(size_t x) {
+  return 63 - (unsigned) __builtin_clzll((unsigned long long) x);
+}
+
+static size_t node_keys_for(size_t element_size) {
+  if (element_size <= 8) {
+    return 16;
+  }
+  const size_t keys = 2 * CACHE_LINE / element_size;
+  return keys < 2 ? 2 : keys;
+}
+
+// Eytzinger index k (1-based, children 2k and 2k + 1) of the searches below is prefetched this many
+// times further along, i.e. the first of the descendants that share one cache line with it.
+static size_t prefetch_stride_for(size_t element_size) {
+  return element_size <= 16 && CACHE_LINE % element_size == 0 ? CACHE_LINE / element_size : 2;
+}
+
+/*
+ * The Eytzinger tree of n elements is a complete binary tree. Its in-order position is computed from
+ * the position p the node would have in the perfect tree of the same height, minus the leaves of the
+ * last level that the complete tree lacks before p: the last level holds leaves at the even positions
+ * of the perfect tree, and only the first n - (2^(h-1) - 1) of them exist.
+ */
+static size_t eytzinger_rank(size_t k, size_t n) {
+  const unsigned height = floor_log2(n) + 1;
+  const unsigned depth = floor_log2(k);
+  const size_t p = ((2 * (k - ((size_t) 1 << depth)) + 1) << (height - 1 - depth)) - 1;
+  const size_t leaves = 2 * (n - (((size_t) 1 << (height - 1)) - 1));
+  return p > leaves ? p - (p - leaves + 1) / 2 : p;
+}
+
+// The descent goes right while the element is before key. The last left turn is the answer: strip the
+// trailing right turns (ones) and the left turn itself. Zero means the search never went left.
+static inline size_t eytzinger_result(size_t k, size_t n) {
+  k >>= __builtin_ctzll(~(unsigned long long) k) + 1;
+  return k == 0 ? n : eytzinger_rank(k, n);
+}
+
+static inline void prefetch_index(const char *data, size_t index, size_t element_size) {
+  // Integer arithmetic: the address may lie past the end of the layout, which prefetch ignores.
+  __builtin_prefetch((const void *) ((uintptr_t) data + index * element_size));
+}
+
+static size_t eytzinger_search(const struct cds_search_layout *layout, const void *key, int bias) {
+  const size_t n = layout->size, es = layout->element_size;
+  const size_t stride = prefetch_stride_for(es);
+  const char *t = layout->data;
+  size_t k = 1;
+  while (k <= n) {
+    prefetch_index(t, k * stride, es);
+    k = 2 * k + (layout->cmp(t + k * es, key) < bias);
+  }
+  return eytzinger_result(k, n);
+}
+
+static size_t eytzinger_search_i32(const struct cds_search_layout *layout, int32_t key, bool upper) {
+  const size_t n = layout->size;
+  const int32_t *t = (const int32_t*) layout->data;
+  size_t k = 1;
+  while (k <= n) {
+    prefetch_index(layout->data, k * (CACHE_LINE / sizeof(int32_t)), sizeof(int32_t));
+    k = 2 * k + ((t[k] < key) | (upper & (t[k] == key)));
+  }
+  return eytzinger_result(k, n);
+}
+
+static size_t eytzinger_search_i64(const struct cds_search_layout *layout, int64_t key, bool upper) {
+  const size_t n = layout->size;
+  const int64_t *t = (const int64_t*) layout->data;
+  size_t k = 1;
+  while (k <= n) {
+    prefetch_index(layout->data, k * (CACHE_LINE / sizeof(int64_t)), sizeof(int64_t));
+    k = 2 * k + ((t[k] < key) | (upper & (t[k] == key)));
+  }
+  return eytzinger_result(k, n);
+}
+
+// Counts the elements e of a node with cmp(e, key) < bias by a binary search without branches.
+static inline size_t node_count(const struct cds_search_layout *layout, const char *node, const void *key,
+                                int bias) {
+  const size_t es = layout->element_size;
+  const char *base = node;
+  size_t len = layout->node_keys;
+  while (len > 1) {
+    const size_t half = len / 2;
+    base += (size_t) (layout->cmp(base + (half - 1) * es, key) < bias) * half * es;
+    len -= half;
+  }
+  return (size_t) (base - node) / es + (layout->cmp(base, key) < bias);
+}
+
+static inline size_t node_count_i32(const int32_t *node, int32_t key, bool upper) {
+  size_t count = 0;
+  for (size_t i = 0; i < 16; i++) {
+    count += (node[i] < key) | (upper & (node[i] == key));
+  }
+  return count;
+}
+
+static inline size_t node_count_i64(const int64_t *node, int64_t key, bool upper) {
+  size_t count = 0;
+  for (size_t i = 0; i < 16; i++) {
+    count += (node[i] < key) | (upper & (node[i] == key));
+  }
+  return count;
+}
+
+/*
+ * The B-tree layout is a static B+ tree. Layer 0 is the sorted array padded to whole nodes of B
+ * elements, so the leaf a search ends in gives the index directly. A node of layer l > 0 has B + 1
+ * children in layer l - 1, and its element i is the first element under child i + 1. Counting the
+ * elements of a node before key picks the child to descend into. Missing children and the padding
+ * hold the largest element, and keys past it are answered before the descent, so the search never
+ * leaves the tree.
+ */
+#define BTREE_SEARCH(COUNT) do {                                                                \
+  size_t c = 0;                                                                                 \
+  for (size_t l = layout->layers - 1; l > 0; l--) {                                             \
+    c = c * (b + 1) + COUNT(layout->data + (layout->layer_offset[l] + c * b) * es);             \
+  }                                                                                             \
+  return c * b + COUNT(layout->data + c * b * es);                                              \
+} while (0)
+
+static size_t btree_search(const struct cds_search_layout *layout, const void *key, int bias) {
+  const size_t es = layout->element_size, b = layout->node_keys;
+  if (layout->size == 0 || layout->cmp(layout->data + (layout->size - 1) * es, key) < bias) {
+    return layout->size;
+  }
+#define COUNT(node) node_count(layout, node, key, bias)
+  BTREE_SEARCH(COUNT);
+#undef COUNT
+}
+
+static size_t btree_search_i32(const struct cds_search_layout *layout, int32_t key, bool upper) {
+  const size_t es = sizeof(int32_t), b = 16;
+  const int32_t last = layout->size > 0 ? ((const int32_t*) layout->data)[layout->size - 1] : 0;
+  if (layout->size == 0 || last < key || (upper && last == key)) {
+    return layout->size;
+  }
+#define COUNT(node) node_count_i32((const int32_t*) (node), key, upper)
+  BTREE_SEARCH(COUNT);
+#undef COUNT
+}
+
+static size_t btree_search_i64(const struct cds_search_layout *layout, int64_t key, bool upper) {
+  const size_t es = sizeof(int64_t), b = 16;
+  const int64_t last = layout->size > 0 ? ((const int64_t*) layout->data)[layout->size - 1] : 0;
+  if (layout->size == 0 || last < key || (upper && last == key)) {
+    return layout->size;
+  }
+#define COUNT(node) node_count_i64((const int64_t*) (node), key, upper)
+  BTREE_SEARCH(COUNT);
+#undef COUNT
+}
+
+static void build_eytzinger(struct cds_search_layout *layout, const char *sorted) {
+  const size_t n = layout->size, es = layout->element_size;
+  for (size_t k = 1; k <= n; k++) {
+    memcpy(layout->data + k * es, sorted + eytzinger_rank(k, n) * es, es);
+  }
+}
+
+static size_t btree_layer_count(size_t n, size_t b, size_t *counts) {
+  size_t layers = 1;
+  counts[0] = (n + b - 1) / b;
+  while (counts[layers - 1] > 1) {
+    counts[layers] = (counts[layers - 1] + b) / (b + 1);
+    layers++;
+  }
+  return layers;
+}
+
+struct cds_search_layout cds_search_layout_new(const struct cds_array *sorted,
+                                               enum cds_search_layout_type type, cds_cmp_func cmp) {
+  return cds_search_layout_new_with_allocator(sorted, type, cmp, &cds_default_allocator);
+}
+
+struct cds_search_layout cds_search_layout_new_with_allocator(const struct cds_array *sorted,
+                                                              enum cds_search_layout_type type,
+                                                              cds_cmp_func cmp,
+                                                              const struct cds_allocator *allocator) {
+  struct cds_search_layout layout = {.type = type, .cmp = cmp, .allocator = allocator};
+  if (!sorted || !cmp || sorted->element_size == 0 ||
+      (type != CDS_SEARCH_LAYOUT_EYTZINGER && type != CDS_SEARCH_LAYOUT_BTREE)) {
+    return layout;
+  }
+  const size_t n = sorted->size, es = sorted->element_size;
+  layout.size = n;
+  layout.element_size = es;
+
+  size_t elements = n + 1;  // Eytzinger: index 0 is unused
+  size_t counts[CDS_SEARCH_LAYOUT_MAX_LAYERS] = {0};
+  if (type == CDS_SEARCH_LAYOUT_BTREE) {
+    layout.node_keys = node_keys_for(es);
+    layout.layers = n > 0 ? btree_layer_count(n, layout.node_keys, counts) : 0;
+    // Leaves first, so that an element's index in the leaves is its index in the sorted array.
+    elements = 0;
+    for (size_t l = 0; l < layout.layers; l++) {
+      layout.layer_offset[l] = elements;
+      elements += counts[l] * layout.node_keys;
+    }
+  }
+
+  layout.block_size = elements * es + CACHE_LINE;
+  layout.block = cds_allocator_alloc(allocator, layout.block_size);
+  if (!layout.block) {
+    return layout;
+  }
+  layout.data = (char*) (((uintptr_t) layout.block + CACHE_LINE - 1) & ~(uintptr_t) (CACHE_LINE - 1));
+  if (n == 0) {
+    return layout;
+  }
+
+  if (type == CDS_SEARCH_LAYOUT_EYTZINGER) {
+    build_eytzinger(&layout, sorted->data);
+    return layout;
+  }
+
+  const size_t b = layout.node_keys;
+  const char *last = sorted->data + (n - 1) * es;
+  memcpy(layout.data, sorted->data, n * es);
+  for (size_t i = n; i < counts[0] * b; i++) {
+    memcpy(layout.data + i * es, last, es);
+  }
+  size_t span = b;  // sorted elements under one node of layer l - 1
+  for (size_t l = 1; l < layout.layers; l++) {
+    char *node = layout.data + layout.layer_offset[l] * es;
+    for (size_t j = 0; j < counts[l]; j++) {
+      for (size_t i = 0; i < b; i++, node += es) {
+        const size_t first = (j * (b + 1) + i + 1) * span;
+        memcpy(node, first < n ? sorted->data + first * es : last, es);
+      }
+    }
+    span *= b + 1;
+  }
+  return layout;
+}
+
+void cds_search_layout_delete(struct cds_search_layout *layout) {
+  if (layout->block != NULL) {
+    cds_allocator_free(layout->allocator, layout->block, layout->block_size);
+  }
+  layout->block = NULL;
+  layout->data = NULL;
+  layout->size = 0;
+}
+
+static size_t search_layout_bound(const struct cds_search_layout *layout, const void *key, bool upper) {
+  if (!layout || !layout->data || !key) {
+    return 0;
+  }
+  const bool eytzinger = layout->type == CDS_SEARCH_LAYOUT_EYTZINGER;
+  if (layout->cmp == cds_cmp_i32 && layout->element_size == sizeof(int32_t)) {
+    int32_t value;
+    memcpy(&value, key, sizeof(value));
+    return eytzinger ? eytzinger_search_i32(layout, value, upper) : btree_search_i32(layout, value, upper);
+  }
+  if (layout->cmp == cds_cmp_i64 && layout->element_size == sizeof(int64_t)) {
+    int64_t value;
+    memcpy(&value, key, sizeof(value));
+    return eytzinger ? eytzinger_search_i64(layout, value, upper) : btree_search_i64(layout, value, upper);
+  }
+  return eytzinger ? eytzinger_search(layout, key, upper) : btree_search(layout, key, upper);
+}
+
+size_t cds_search_layout_lower_bound(const struct cds_search_layout *layout, const void *key) {
+  return search_layout_bound(layout, key, false);
+}
+
+size_t cds_search_layout_upper_bound(const struct cds_search_layout *layout, const void *key) {
+  return search_layout_bound(layout, key, true);
+}
+
+size_t cds_search_layout_size(const struct cds_search_layout *layout) {
+  return layout->size;
+}
+
+bool cds_search_layout_empty(const struct cds_search_layout *layout) {
+  return layout->size == 0;
+}
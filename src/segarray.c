@@ -0,0 +1,112 @@
+#include <string.h>
+
+#include "cds/segarray.h"
+
+struct cds_segarray cds_segarray_new(const size_t element_size) {
+  return cds_segarray_new_with_allocator(element_size, &cds_default_allocator);
+}
+
+struct cds_segarray cds_segarray_new_with_allocator(const size_t element_size,
+                                                    const struct cds_allocator *allocator) {
+  const size_t chunk_length = element_size == 0 ? 1 : CDS_SEGARRAY_CHUNK_BYTES / element_size;
+  size_t chunk_shift = 0;
+  while (((size_t) 2 << chunk_shift) <= chunk_length) {
+    chunk_shift++;
+  }
+  struct cds_segarray new_array = {
+    .chunks = NULL,
+    .size = 0,
+    .chunk_count = 0,
+    .directory_capacity = 0,
+    .element_size = element_size,
+    .chunk_shift = chunk_shift,
+    .chunk_mask = ((size_t) 1 << chunk_shift) - 1,
+    .allocator = allocator};
+  return new_array;
+}
+
+static size_t cds_segarray_chunk_bytes(const struct cds_segarray *array) {
+  return (array->chunk_mask + 1) * array->element_size;
+}
+
+void cds_segarray_delete(struct cds_segarray *array) {
+  for (size_t i = 0; i < array->chunk_count; ++i) {
+    cds_allocator_free(array->allocator, array->chunks[i], cds_segarray_chunk_bytes(array));
+  }
+  cds_allocator_free(array->allocator, array->chunks, array->directory_capacity * sizeof(char*));
+  array->chunks = NULL;
+  array->size = array->chunk_count = array->directory_capacity = 0;
+  array->element_size = 0;
+}
+
+static int cds_segarray_add_chunk(struct cds_segarray *array) {
+  if (array->chunk_count == array->directory_capacity) {
+    const size_t new_capacity = array->directory_capacity == 0 ? 8 : array->directory_capacity << 1;
+    char **new_chunks = (char**) cds_allocator_realloc(array->allocator, array->chunks,
+      array->directory_capacity * sizeof(char*), new_capacity * sizeof(char*));
+    if (new_chunks == NULL) {
+      return -1;
+    }
+    array->chunks = new_chunks;
+    array->directory_capacity = new_capacity;
+  }
+  char *chunk = (char*) cds_allocator_alloc(array->allocator, cds_segarray_chunk_bytes(array));
+  if (chunk == NULL) {
+    return -1;
+  }
+  array->chunks[array->chunk_count++] = chunk;
+  return 0;
+}
+
+void* cds_segarray_emplace_back(struct cds_segarray *array) {
+  if ((array->size >> array->chunk_shift) == array->chunk_count &&
+      cds_segarray_add_chunk(array) != 0) {
+    return NULL;
+  }
+  void *slot = cds_segarray_get(array, array->size);
+  array->size++;
+  return slot;
+}
+
+int cds_segarray_push_back(struct cds_segarray *array, const void *new_element) {
+  void *slot = cds_segarray_emplace_back(array);
+  if (slot == NULL) {
+    return -1;
+  }
+  memcpy(slot, new_element, array->element_size);
+  return 0;
+}
+
+int cds_segarray_pop_back(struct cds_segarray *array) {
+  if (array->size == 0) {
+    return -1;
+  }
+  array->size--;
+  const size_t used_chunks = (array->size + array->chunk_mask) >> array->chunk_shift;
+  while (array->chunk_count > used_chunks + 1) {
+    array->chunk_count--;
+    cds_allocator_free(array->allocator, array->chunks[array->chunk_count],
+      cds_segarray_chunk_bytes(array));
+  }
+  return 0;
+}
+
+void* cds_segarray_at(const struct cds_segarray *array, const size_t index) {
+  if (index >= array->size) {
+    return NULL;
+  }
+  return cds_segarray_get(array, index);
+}
+
+void* cds_segarray_get(const struct cds_segarray *array, const size_t index) {
+  return (void*) (array->chunks[index >> array->chunk_shift] +
+    (index & array->chunk_mask) * array->element_size);
+}
+
+size_t cds_segarray_size(const struct cds_segarray *array) {
+  return array->size;
+}
+
+bool cds_segarray_empty(const struct cds_segarray *array) {
+  return array->size == 0;
+}
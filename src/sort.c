@@ -1,107 +1,686 @@
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
-#include <math.h>
 
 #include "cds/sort.h"
 #include "cds/array.h"
+#include "cds/heap.h"
 
-static void swap(void *a, void *b, size_t size) {
-    char buffer[1024];
-    if (size <= 1024) {
-        memcpy(buffer, a, size);
-        memcpy(a, b, size);
-        memcpy(b, buffer, size);
-    } else {
-        char *temp = malloc(size);
-        if (temp) {
-            memcpy(temp, a, size);
-            memcpy(a, b, size);
-            memcpy(b, temp, size);
-            free(temp);
+// Ranges smaller than this are insertion sorted.
+#define PDQ_INSERTION_SORT_THRESHOLD 24
+// Ranges larger than this use Tukey's ninther as the pivot, smaller ones the median of 3.
+#define PDQ_NINTHER_THRESHOLD 128
+// Element moves partial_insertion_sort may make before it gives up.
+#define PDQ_PARTIAL_INSERTION_SORT_LIMIT 8
+// Elements classified per side before the misplaced ones are swapped.
+#define PDQ_BLOCK_SIZE 64
+// Elements up to this size use a stack buffer as the scratch element.
+#define PDQ_STACK_SCRATCH 256
+
+struct pdq_context {
+    size_t element_size;
+    cds_cmp_func cmp;
+    char *tmp;  // one element of scratch, allocated once per sort
+    void (*small_sort)(char *data, size_t n);  // sorting network base case for the cds_cmp_* types
+};
+
+static void small_sort_i32(char *data, size_t n) { cds_sort_small_i32((int32_t *) data, n); }
+static void small_sort_i64(char *data, size_t n) { cds_sort_small_i64((int64_t *) data, n); }
+static void small_sort_f32(char *data, size_t n) { cds_sort_small_f32((float *) data, n); }
+static void small_sort_f64(char *data, size_t n) { cds_sort_small_f64((double *) data, n); }
+
+static inline void element_copy(char *dst, const char *src, size_t element_size) {
+    switch (element_size) {
+        case 4: memcpy(dst, src, 4); break;
+        case 8: memcpy(dst, src, 8); break;
+        case 16: memcpy(dst, src, 16); break;
+        default: memcpy(dst, src, element_size); break;
+    }
+}
+
+static inline void element_swap(const struct pdq_context *ctx, char *a, char *b) {
+    switch (ctx->element_size) {
+        case 4: {
+            uint32_t x, y;
+            memcpy(&x, a, 4);
+            memcpy(&y, b, 4);
+            memcpy(a, &y, 4);
+            memcpy(b, &x, 4);
+            break;
+        }
+        case 8: {
+            uint64_t x, y;
+            memcpy(&x, a, 8);
+            memcpy(&y, b, 8);
+            memcpy(a, &y, 8);
+            memcpy(b, &x, 8);
+            break;
         }
+        default:
+            memcpy(ctx->tmp, a, ctx->element_size);
+            memcpy(a, b, ctx->element_size);
+            memcpy(b, ctx->tmp, ctx->element_size);
+            break;
     }
 }
 
-static void insertion_sort(char *data, size_t n, size_t element_size, cds_cmp_func cmp) {
-    for (size_t i = 1; i < n; i++) {
-        char *key = malloc(element_size);
-        if (!key) return; // Allocation failure
+static inline bool less(const struct pdq_context *ctx, const char *a, const char *b) {
+    return ctx->cmp(a, b) < 0;
+}
+
+static inline void sort2(const struct pdq_context *ctx, char *a, char *b) {
+    if (less(ctx, b, a)) element_swap(ctx, a, b);
+}
+
+static inline void sort3(const struct pdq_context *ctx, char *a, char *b, char *c) {
+    sort2(ctx, a, b);
+    sort2(ctx, b, c);
+    sort2(ctx, a, b);
+}
+
+static void insertion_sort(const struct pdq_context *ctx, char *begin, char *end) {
+    const size_t es = ctx->element_size;
+    if (begin == end) return;
+    for (char *cur = begin + es; cur < end; cur += es) {
+        char *sift = cur, *sift_1 = cur - es;
+        if (less(ctx, sift, sift_1)) {
+            element_copy(ctx->tmp, sift, es);
+            do {
+                element_copy(sift, sift_1, es);
+                sift -= es;
+            } while (sift != begin && less(ctx, ctx->tmp, sift_1 -= es));
+            element_copy(sift, ctx->tmp, es);
+        }
+    }
+}
 
-        memcpy(key, data + i * element_size, element_size);
-        int j = i - 1;
+// Like insertion_sort, but assumes an element not greater than any in [begin, end) precedes begin.
+static void unguarded_insertion_sort(const struct pdq_context *ctx, char *begin, char *end) {
+    const size_t es = ctx->element_size;
+    if (begin == end) return;
+    for (char *cur = begin + es; cur < end; cur += es) {
+        char *sift = cur, *sift_1 = cur - es;
+        if (less(ctx, sift, sift_1)) {
+            element_copy(ctx->tmp, sift, es);
+            do {
+                element_copy(sift, sift_1, es);
+                sift -= es;
+            } while (less(ctx, ctx->tmp, sift_1 -= es));
+            element_copy(sift, ctx->tmp, es);
+        }
+    }
+}
 
-        while (j >= 0 && cmp(data + j * element_size, key) > 0) {
-            memcpy(data + (j + 1) * element_size, data + j * element_size, element_size);
-            j = j - 1;
+// Insertion sorts [begin, end) unless that takes more than PDQ_PARTIAL_INSERTION_SORT_LIMIT moves.
+// Returns true if the range is now sorted.
+static bool partial_insertion_sort(const struct pdq_context *ctx, char *begin, char *end) {
+    const size_t es = ctx->element_size;
+    if (begin == end) return true;
+    size_t limit = 0;
+    for (char *cur = begin + es; cur < end; cur += es) {
+        char *sift = cur, *sift_1 = cur - es;
+        if (less(ctx, sift, sift_1)) {
+            element_copy(ctx->tmp, sift, es);
+            do {
+                element_copy(sift, sift_1, es);
+                sift -= es;
+            } while (sift != begin && less(ctx, ctx->tmp, sift_1 -= es));
+            element_copy(sift, ctx->tmp, es);
+            limit += (size_t) (cur - sift) / es;
         }
-        memcpy(data + (j + 1) * element_size, key, element_size);
-        free(key);
+        if (limit > PDQ_PARTIAL_INSERTION_SORT_LIMIT) return false;
     }
+    return true;
 }
 
-static void heapify(char *data, size_t n, size_t i, size_t element_size, cds_cmp_func cmp) {
-    size_t largest = i;
-    size_t left = 2 * i + 1;
-    size_t right = 2 * i + 2;
+static void sift_down(const struct pdq_context *ctx, char *data, size_t root, size_t n) {
+    const size_t es = ctx->element_size;
+    size_t child;
+    while ((child = 2 * root + 1) < n) {
+        if (child + 1 < n && less(ctx, data + child * es, data + (child + 1) * es)) child++;
+        if (!less(ctx, data + root * es, data + child * es)) return;
+        element_swap(ctx, data + root * es, data + child * es);
+        root = child;
+    }
+}
+
+static void heap_sort(const struct pdq_context *ctx, char *begin, char *end) {
+    const size_t es = ctx->element_size;
+    const size_t n = (size_t) (end - begin) / es;
+    for (size_t i = n / 2; i-- > 0;) {
+        sift_down(ctx, begin, i, n);
+    }
+    for (size_t i = n - 1; i > 0; i--) {
+        element_swap(ctx, begin, begin + i * es);
+        sift_down(ctx, begin, 0, i);
+    }
+}
+
+// Moves the elements at the recorded offsets across the partition, num from each side.
+static void swap_offsets(const struct pdq_context *ctx, char *first, char *last,
+                         const unsigned char *offsets_l, const unsigned char *offsets_r,
+                         size_t num, bool use_swaps) {
+    const size_t es = ctx->element_size;
+    if (use_swaps) {
+        // Needed for descending input, where the cyclic permutation below would not be O(n) overall.
+        for (size_t i = 0; i < num; i++) {
+            element_swap(ctx, first + offsets_l[i] * es, last - offsets_r[i] * es);
+        }
+    } else if (num > 0) {
+        char *l = first + offsets_l[0] * es, *r = last - offsets_r[0] * es;
+        element_copy(ctx->tmp, l, es);
+        element_copy(l, r, es);
+        for (size_t i = 1; i < num; i++) {
+            l = first + offsets_l[i] * es;
+            element_copy(r, l, es);
+            r = last - offsets_r[i] * es;
+            element_copy(l, r, es);
+        }
+        element_copy(r, ctx->tmp, es);
+    }
+}
+
+// Partitions [begin, end) around the pivot at begin: elements less than the pivot end up on its left,
+// the others on its right. Uses BlockQuicksort-style partitioning: each side classifies a block of
+// PDQ_BLOCK_SIZE elements into an offset buffer without branching on the comparison result, then the
+// misplaced elements are swapped in bulk. Returns the final pivot position, and whether the range
+// needed no swaps at all.
+static char *partition_right(const struct pdq_context *ctx, char *begin, char *end, bool *already_partitioned) {
+    const size_t es = ctx->element_size;
+    const char *pivot = begin;  // untouched until the final swap
+    char *first = begin, *last = end;
+
+    // The median-of-3 guarantees an element >= pivot at the end, so this stops.
+    do first += es; while (less(ctx, first, pivot));
+    if (first - es == begin) {
+        while (first < last) {
+            last -= es;
+            if (less(ctx, last, pivot)) break;
+        }
+    } else {
+        do last -= es; while (!less(ctx, last, pivot));
+    }
+
+    *already_partitioned = first >= last;
+    if (!*already_partitioned) {
+        element_swap(ctx, first, last);
+        first += es;
+
+        _Alignas(64) unsigned char offsets_l[PDQ_BLOCK_SIZE];
+        _Alignas(64) unsigned char offsets_r[PDQ_BLOCK_SIZE];
+        char *offsets_l_base = first, *offsets_r_base = last;
+        size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+
+        while (first < last) {
+            // Decide how many elements each side classifies this round.
+            const size_t num_unknown = (size_t) (last - first) / es;
+            const size_t left_split = num_l == 0 ? (num_r == 0 ? num_unknown / 2 : num_unknown) : 0;
+            const size_t right_split = num_r == 0 ? num_unknown - left_split : 0;
 
-    if (left < n && cmp(data + left * element_size, data + largest * element_size) > 0)
-        largest = left;
+            const size_t left_count = left_split < PDQ_BLOCK_SIZE ? left_split : PDQ_BLOCK_SIZE;
+            for (size_t i = 0; i < left_count; i++) {
+                offsets_l[num_l] = (unsigned char) i;
+                num_l += !less(ctx, first, pivot);
+                first += es;
+            }
+            const size_t right_count = right_split < PDQ_BLOCK_SIZE ? right_split : PDQ_BLOCK_SIZE;
+            for (size_t i = 0; i < right_count; i++) {
+                last -= es;
+                offsets_r[num_r] = (unsigned char) (i + 1);
+                num_r += less(ctx, last, pivot);
+            }
 
-    if (right < n && cmp(data + right * element_size, data + largest * element_size) > 0)
-        largest = right;
+            const size_t num = num_l < num_r ? num_l : num_r;
+            swap_offsets(ctx, offsets_l_base, offsets_r_base, offsets_l + start_l, offsets_r + start_r,
+                         num, num_l == num_r);
+            num_l -= num;
+            num_r -= num;
+            start_l += num;
+            start_r += num;
+            if (num_l == 0) {
+                start_l = 0;
+                offsets_l_base = first;
+            }
+            if (num_r == 0) {
+                start_r = 0;
+                offsets_r_base = last;
+            }
+        }
 
-    if (largest != i) {
-        swap(data + i * element_size, data + largest * element_size, element_size);
-        heapify(data, n, largest, element_size, cmp);
+        // One side may still hold misplaced elements; move them next to the boundary.
+        if (num_l) {
+            const unsigned char *offsets = offsets_l + start_l;
+            while (num_l--) {
+                last -= es;
+                element_swap(ctx, offsets_l_base + offsets[num_l] * es, last);
+            }
+            first = last;
+        }
+        if (num_r) {
+            const unsigned char *offsets = offsets_r + start_r;
+            while (num_r--) {
+                element_swap(ctx, offsets_r_base - offsets[num_r] * es, first);
+                first += es;
+            }
+            last = first;
+        }
     }
+
+    char *pivot_pos = first - es;
+    element_swap(ctx, begin, pivot_pos);
+    return pivot_pos;
 }
 
-static void heap_sort(char *data, size_t n, size_t element_size, cds_cmp_func cmp) {
-    for (int i = n / 2 - 1; i >= 0; i--)
-        heapify(data, n, i, element_size, cmp);
+// Partitions [begin, end) around the pivot at begin with elements equal to the pivot going left. Used
+// when the pivot equals the element just before the range, so the whole left part equals the pivot
+// and never has to be sorted again.
+static char *partition_left(const struct pdq_context *ctx, char *begin, char *end) {
+    const size_t es = ctx->element_size;
+    const char *pivot = begin;
+    char *first = begin, *last = end;
+
+    do last -= es; while (less(ctx, pivot, last));
+    if (last + es == end) {
+        while (first < last) {
+            first += es;
+            if (less(ctx, pivot, first)) break;
+        }
+    } else {
+        do first += es; while (!less(ctx, pivot, first));
+    }
 
-    for (int i = n - 1; i > 0; i--) {
-        swap(data, data + i * element_size, element_size);
-        heapify(data, i, 0, element_size, cmp);
+    while (first < last) {
+        element_swap(ctx, first, last);
+        do last -= es; while (less(ctx, pivot, last));
+        do first += es; while (!less(ctx, pivot, first));
     }
+
+    element_swap(ctx, begin, last);
+    return last;
 }
 
-static size_t partition(char *data, int low, int high, size_t element_size, cds_cmp_func cmp) {
-    char *pivot = data + high * element_size;
-    int i = (low - 1);
+static void pdqsort_loop(const struct pdq_context *ctx, char *begin, char *end, int bad_allowed, bool leftmost) {
+    const size_t es = ctx->element_size;
+    for (;;) {
+        const size_t size = (size_t) (end - begin) / es;
+        if (ctx->small_sort != NULL && size <= CDS_SORT_SMALL_MAX) {
+            ctx->small_sort(begin, size);
+            return;
+        }
+        if (size < PDQ_INSERTION_SORT_THRESHOLD) {
+            if (leftmost) {
+                insertion_sort(ctx, begin, end);
+            } else {
+                unguarded_insertion_sort(ctx, begin, end);
+            }
+            return;
+        }
+
+        // Move the pivot to begin.
+        char *mid = begin + (size / 2) * es;
+        if (size > PDQ_NINTHER_THRESHOLD) {
+            sort3(ctx, begin, mid, end - es);
+            sort3(ctx, begin + es, mid - es, end - 2 * es);
+            sort3(ctx, begin + 2 * es, mid + es, end - 3 * es);
+            sort3(ctx, mid - es, mid, mid + es);
+            element_swap(ctx, begin, mid);
+        } else {
+            sort3(ctx, mid, begin, end - es);
+        }
+
+        // If the pivot equals the element before this range, everything equal to it can be skipped.
+        if (!leftmost && !less(ctx, begin - es, begin)) {
+            begin = partition_left(ctx, begin, end) + es;
+            continue;
+        }
+
+        bool already_partitioned;
+        char *pivot_pos = partition_right(ctx, begin, end, &already_partitioned);
+        const size_t l_size = (size_t) (pivot_pos - begin) / es;
+        const size_t r_size = (size_t) (end - (pivot_pos + es)) / es;
 
-    for (int j = low; j <= high - 1; j++) {
-        if (cmp(data + j * element_size, pivot) < 0) {
-            i++;
-            swap(data + i * element_size, data + j * element_size, element_size);
+        if (l_size < size / 8 || r_size < size / 8) {
+            // Too many bad partitions: fall back to heap sort for a guaranteed O(n log n).
+            if (--bad_allowed == 0) {
+                heap_sort(ctx, begin, end);
+                return;
+            }
+            // Otherwise shuffle some elements to break up patterns.
+            if (l_size >= PDQ_INSERTION_SORT_THRESHOLD) {
+                element_swap(ctx, begin, begin + (l_size / 4) * es);
+                element_swap(ctx, pivot_pos - es, pivot_pos - (l_size / 4) * es);
+                if (l_size > PDQ_NINTHER_THRESHOLD) {
+                    element_swap(ctx, begin + es, begin + (l_size / 4 + 1) * es);
+                    element_swap(ctx, begin + 2 * es, begin + (l_size / 4 + 2) * es);
+                    element_swap(ctx, pivot_pos - 2 * es, pivot_pos - (l_size / 4 + 1) * es);
+                    element_swap(ctx, pivot_pos - 3 * es, pivot_pos - (l_size / 4 + 2) * es);
+                }
+            }
+            if (r_size >= PDQ_INSERTION_SORT_THRESHOLD) {
+                element_swap(ctx, pivot_pos + es, pivot_pos + (1 + r_size / 4) * es);
+                element_swap(ctx, end - es, end - (r_size / 4) * es);
+                if (r_size > PDQ_NINTHER_THRESHOLD) {
+                    element_swap(ctx, pivot_pos + 2 * es, pivot_pos + (2 + r_size / 4) * es);
+                    element_swap(ctx, pivot_pos + 3 * es, pivot_pos + (3 + r_size / 4) * es);
+                    element_swap(ctx, end - 2 * es, end - (1 + r_size / 4) * es);
+                    element_swap(ctx, end - 3 * es, end - (2 + r_size / 4) * es);
+                }
+            }
+        } else if (already_partitioned && partial_insertion_sort(ctx, begin, pivot_pos) &&
+                   partial_insertion_sort(ctx, pivot_pos + es, end)) {
+            // A balanced partition that needed no swaps: the range was probably sorted already.
+            return;
         }
+
+        // Recurse into the left part, loop on the right.
+        pdqsort_loop(ctx, begin, pivot_pos, bad_allowed, leftmost);
+        begin = pivot_pos + es;
+        leftmost = false;
     }
-    swap(data + (i + 1) * element_size, data + high * element_size, element_size);
-    return (i + 1);
 }
 
-static void introsort_util(char *data, int low, int high, int depth_limit, size_t element_size, cds_cmp_func cmp) {
-    size_t n = high - low + 1;
-    if (n <= 16) {
-        insertion_sort(data + low * element_size, n, element_size, cmp);
-        return;
+// Sets up ctx for sorting array with cmp. tmp is the caller's stack scratch; larger elements get a
+// heap allocation that pdq_context_release frees. Returns false if that allocation fails.
+static bool pdq_context_init(struct pdq_context *ctx, const struct cds_array *array, cds_cmp_func cmp,
+                             char *stack_scratch) {
+    ctx->element_size = array->element_size;
+    ctx->cmp = cmp;
+    ctx->tmp = array->element_size <= PDQ_STACK_SCRATCH ? stack_scratch : malloc(array->element_size);
+    ctx->small_sort = NULL;
+    if (cmp == cds_cmp_i32 && array->element_size == sizeof(int32_t)) {
+        ctx->small_sort = small_sort_i32;
+    } else if (cmp == cds_cmp_i64 && array->element_size == sizeof(int64_t)) {
+        ctx->small_sort = small_sort_i64;
+    } else if (cmp == cds_cmp_f32 && array->element_size == sizeof(float)) {
+        ctx->small_sort = small_sort_f32;
+    } else if (cmp == cds_cmp_f64 && array->element_size == sizeof(double)) {
+        ctx->small_sort = small_sort_f64;
     }
+    return ctx->tmp != NULL;
+}
 
-    if (depth_limit == 0) {
-        heap_sort(data + low * element_size, n, element_size, cmp);
-        return;
+static void pdq_context_release(struct pdq_context *ctx, char *stack_scratch) {
+    if (ctx->tmp != stack_scratch) {
+        free(ctx->tmp);
     }
+}
 
-    size_t p = partition(data, low, high, element_size, cmp);
-    introsort_util(data, low, p - 1, depth_limit - 1, element_size, cmp);
-    introsort_util(data, p + 1, high, depth_limit - 1, element_size, cmp);
+// The number of bad partitions tolerated before falling back: floor(log2(n)).
+static int pdq_bad_allowed(size_t n) {
+    int bad_allowed = 0;
+    for (; n > 1; n >>= 1) {
+        bad_allowed++;
+    }
+    return bad_allowed;
 }
 
 void cds_array_sort(struct cds_array *array, cds_cmp_func cmp) {
     if (!array || array->size <= 1) return;
 
-    int depth_limit = 2 * log(array->size);
-    introsort_util(array->data, 0, array->size - 1, depth_limit, array->element_size, cmp);
+    _Alignas(16) char stack_scratch[PDQ_STACK_SCRATCH];
+    struct pdq_context ctx;
+    if (!pdq_context_init(&ctx, array, cmp, stack_scratch)) return;
+    pdqsort_loop(&ctx, array->data, array->data + array->size * array->element_size,
+                 pdq_bad_allowed(array->size), true);
+    pdq_context_release(&ctx, stack_scratch);
+}
+
+// Selects nth in [begin, end) with median-of-medians pivots, so the cost is O(n) for any input.
+// Equal elements are gathered by a three-way partition and never revisited.
+static void median_of_medians_select(const struct pdq_context *ctx, char *begin, char *end, char *nth) {
+    const size_t es = ctx->element_size;
+    for (;;) {
+        const size_t size = (size_t) (end - begin) / es;
+        if (size < PDQ_INSERTION_SORT_THRESHOLD) {
+            insertion_sort(ctx, begin, end);
+            return;
+        }
+
+        // Gather the medians of groups of 5 at the front and select their median as the pivot.
+        const size_t groups = size / 5;
+        for (size_t g = 0; g < groups; g++) {
+            char *group = begin + 5 * g * es;
+            insertion_sort(ctx, group, group + 5 * es);
+            element_swap(ctx, begin + g * es, group + 2 * es);
+        }
+        char *mid = begin + (groups / 2) * es;
+        median_of_medians_select(ctx, begin, begin + groups * es, mid);
+        element_swap(ctx, begin, mid);
+
+        // [begin + 1, lt) < pivot, [lt, i) == pivot, [gt, end) > pivot; the pivot stays at begin.
+        char *lt = begin + es, *i = begin + es, *gt = end;
+        while (i < gt) {
+            const int c = ctx->cmp(i, begin);
+            if (c < 0) {
+                element_swap(ctx, lt, i);
+                lt += es;
+                i += es;
+            } else if (c > 0) {
+                gt -= es;
+                element_swap(ctx, i, gt);
+            } else {
+                i += es;
+            }
+        }
+        lt -= es;
+        element_swap(ctx, begin, lt);
+
+        if (nth < lt) {
+            end = lt;
+        } else if (nth >= gt) {
+            begin = gt;
+        } else {
+            return;
+        }
+    }
+}
+
+// Introselect: quickselect with the pivots and partitioning of pdqsort, falling back to
+// median-of-medians after too many unbalanced partitions.
+static void pdq_select(const struct pdq_context *ctx, char *begin, char *end, char *nth, int bad_allowed) {
+    const size_t es = ctx->element_size;
+    bool leftmost = true;
+    for (;;) {
+        const size_t size = (size_t) (end - begin) / es;
+        if (size < PDQ_INSERTION_SORT_THRESHOLD) {
+            insertion_sort(ctx, begin, end);
+            return;
+        }
+
+        char *mid = begin + (size / 2) * es;
+        if (size > PDQ_NINTHER_THRESHOLD) {
+            sort3(ctx, begin, mid, end - es);
+            sort3(ctx, begin + es, mid - es, end - 2 * es);
+            sort3(ctx, begin + 2 * es, mid + es, end - 3 * es);
+            sort3(ctx, mid - es, mid, mid + es);
+            element_swap(ctx, begin, mid);
+        } else {
+            sort3(ctx, mid, begin, end - es);
+        }
+
+        // Everything equal to the element before this range goes left, and all of it is in place.
+        if (!leftmost && !less(ctx, begin - es, begin)) {
+            char *pivot_pos = partition_left(ctx, begin, end);
+            if (nth <= pivot_pos) return;
+            begin = pivot_pos + es;
+            continue;
+        }
+
+        bool already_partitioned;
+        char *pivot_pos = partition_right(ctx, begin, end, &already_partitioned);
+        if (nth == pivot_pos) return;
+        const size_t l_size = (size_t) (pivot_pos - begin) / es;
+        const size_t r_size = (size_t) (end - (pivot_pos + es)) / es;
+        if ((l_size < size / 8 || r_size < size / 8) && --bad_allowed == 0) {
+            if (nth < pivot_pos) {
+                median_of_medians_select(ctx, begin, pivot_pos, nth);
+            } else {
+                median_of_medians_select(ctx, pivot_pos + es, end, nth);
+            }
+            return;
+        }
+        if (nth < pivot_pos) {
+            end = pivot_pos;
+        } else {
+            begin = pivot_pos + es;
+            leftmost = false;
+        }
+    }
+}
+
+int cds_array_nth_element(struct cds_array *array, size_t nth, cds_cmp_func cmp) {
+    if (!array || !cmp || nth >= array->size) return -1;
+
+    _Alignas(16) char stack_scratch[PDQ_STACK_SCRATCH];
+    struct pdq_context ctx;
+    if (!pdq_context_init(&ctx, array, cmp, stack_scratch)) return -1;
+    pdq_select(&ctx, array->data, array->data + array->size * array->element_size,
+               array->data + nth * array->element_size, pdq_bad_allowed(array->size));
+    pdq_context_release(&ctx, stack_scratch);
+    return 0;
+}
+
+int cds_array_partial_sort(struct cds_array *array, size_t k, cds_cmp_func cmp) {
+    if (!array || !cmp) return -1;
+    if (k > array->size) k = array->size;
+    if (k == 0) return 0;
+
+    _Alignas(16) char stack_scratch[PDQ_STACK_SCRATCH];
+    struct pdq_context ctx;
+    if (!pdq_context_init(&ctx, array, cmp, stack_scratch)) return -1;
+    char *begin = array->data, *end = array->data + array->size * array->element_size;
+    char *kth = array->data + k * array->element_size;
+    if (k < array->size) {
+        pdq_select(&ctx, begin, end, kth, pdq_bad_allowed(array->size));
+    }
+    pdqsort_loop(&ctx, begin, kth, pdq_bad_allowed(k), true);
+    pdq_context_release(&ctx, stack_scratch);
+    return 0;
+}
+
+int cds_array_top_k(const struct cds_array *array, size_t k, cds_cmp_func cmp, struct cds_array *out) {
+    if (!array || !cmp || !out || out->element_size != array->element_size) return -1;
+    if (k > array->size) k = array->size;
+
+    // A min-heap of the k largest elements seen so far; its top is the one to evict next.
+    // Its storage is arity - 1 padding slots followed by up to k elements, with one slot to spare.
+    struct cds_heap heap = cds_heap_new(array->element_size, cmp);
+    if (!heap.data.data || cds_array_reserve(&heap.data, k + heap.arity) != 0) {
+        cds_heap_delete(&heap);
+        return -1;
+    }
+    int result = 0;
+    for (size_t i = 0; i < array->size && k > 0 && result == 0; i++) {
+        const char *element = array->data + i * array->element_size;
+        if (cds_heap_size(&heap) < k) {
+            result = cds_heap_push(&heap, element);
+        } else if (cmp(element, cds_heap_top(&heap)) > 0) {
+            cds_heap_pop(&heap);
+            result = cds_heap_push(&heap, element);
+        }
+    }
+
+    // Popping yields ascending order; fill the output from the back.
+    if (result == 0 && cds_array_resize(out, k) == 0) {
+        for (size_t i = k; i-- > 0;) {
+            memcpy(out->data + i * out->element_size, cds_heap_top(&heap), out->element_size);
+            cds_heap_pop(&heap);
+        }
+    } else {
+        result = -1;
+    }
+    cds_heap_delete(&heap);
+    return result;
+}
+
+static uint64_t radix_key(const char *element, size_t key_offset, size_t key_width, int flags) {
+    uint64_t key;
+    switch (key_width) {
+        case 1: { uint8_t k; memcpy(&k, element + key_offset, 1); key = k; break; }
+        case 2: { uint16_t k; memcpy(&k, element + key_offset, 2); key = k; break; }
+        case 4: { uint32_t k; memcpy(&k, element + key_offset, 4); key = k; break; }
+        default: memcpy(&key, element + key_offset, 8); break;
+    }
+    const uint64_t sign_bit = (uint64_t) 1 << (key_width * 8 - 1);
+    const uint64_t all_bits = key_width == 8 ? UINT64_MAX : (sign_bit << 1) - 1;
+    if (flags & CDS_SORT_RADIX_FLOAT) {
+        key = (key & sign_bit) ? ~key & all_bits : key | sign_bit;
+    } else if (flags & CDS_SORT_RADIX_SIGNED) {
+        key ^= sign_bit;
+    }
+    if (flags & CDS_SORT_RADIX_DESCENDING) {
+        key = ~key & all_bits;
+    }
+    return key;
+}
+
+static void radix_copy(char *dst, const char *src, size_t element_size) {
+    switch (element_size) {
+        case 4: memcpy(dst, src, 4); break;
+        case 8: memcpy(dst, src, 8); break;
+        case 16: memcpy(dst, src, 16); break;
+        default: memcpy(dst, src, element_size); break;
+    }
+}
+
+int cds_array_sort_radix(struct cds_array *array, size_t key_offset, size_t key_width, int flags) {
+    if (!array) return -1;
+    if (key_width != 1 && key_width != 2 && key_width != 4 && key_width != 8) return -1;
+    if (key_offset + key_width > array->element_size) return -1;
+    if ((flags & CDS_SORT_RADIX_FLOAT) && key_width != 4 && key_width != 8) return -1;
+    if (array->size <= 1) return 0;
+
+    const size_t n = array->size, element_size = array->element_size;
+    size_t (*histogram)[256] = calloc(key_width, sizeof(*histogram));
+    char *scratch = malloc(n * element_size);
+    if (!histogram || !scratch) {
+        free(histogram);
+        free(scratch);
+        return -1;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        uint64_t key = radix_key(array->data + i * element_size, key_offset, key_width, flags);
+        for (size_t pass = 0; pass < key_width; pass++) {
+            histogram[pass][(key >> (pass * 8)) & 0xff]++;
+        }
+    }
+
+    char *src = array->data, *dst = scratch;
+    for (size_t pass = 0; pass < key_width; pass++) {
+        size_t *counts = histogram[pass];
+        bool trivial = false;
+        for (size_t b = 0; b < 256; b++) {
+            if (counts[b] == n) {
+                trivial = true;
+                break;
+            }
+            if (counts[b] != 0) break;
+        }
+        if (trivial) continue;
+
+        size_t offset = 0;
+        for (size_t b = 0; b < 256; b++) {
+            size_t count = counts[b];
+            counts[b] = offset;
+            offset += count;
+        }
+        for (size_t i = 0; i < n; i++) {
+            const char *element = src + i * element_size;
+            uint64_t key = radix_key(element, key_offset, key_width, flags);
+            radix_copy(dst + counts[(key >> (pass * 8)) & 0xff]++ * element_size, element, element_size);
+        }
+        char *tp = src;
+        src = dst;
+        dst = tp;
+    }
+
+    if (src != array->data) {
+        memcpy(array->data, src, n * element_size);
+    }
+    free(histogram);
+    free(scratch);
+    return 0;
 }
 
 void *cds_array_search_linear(const struct cds_array *array, const void *key, cds_cmp_func cmp) {
@@ -116,27 +695,193 @@ void *cds_array_search_linear(const struct cds_array *array, const void *key, cd
     return NULL;
 }
 
+// The first index in [lo, hi) whose element e has cmp(e, key) >= bias, or hi: bias 0 gives the lower
+// bound, bias 1 the upper bound. The halving does not branch on the comparison results.
+static size_t bound_in(const struct cds_array *array, size_t lo, size_t hi, const void *key,
+                       cds_cmp_func cmp, int bias) {
+    const size_t es = array->element_size;
+    if (lo >= hi) return lo;
+    const char *base = array->data + lo * es;
+    size_t len = hi - lo;
+    while (len > 1) {
+        const size_t half = len / 2;
+        base += (size_t) (cmp(base + (half - 1) * es, key) < bias) * half * es;
+        len -= half;
+    }
+    return (size_t) (base - array->data) / es + (cmp(base, key) < bias);
+}
+
 void *cds_array_search_binary(const struct cds_array *array, const void *key, cds_cmp_func cmp) {
     if (!array || !key || !cmp || array->size == 0) return NULL;
 
-    int low = 0;
-    int high = array->size - 1;
+    const size_t index = bound_in(array, 0, array->size, key, cmp, 0);
+    if (index < array->size && cmp(array->data + index * array->element_size, key) == 0) {
+        return array->data + index * array->element_size;
+    }
+    return NULL;
+}
+
+size_t cds_array_lower_bound(const struct cds_array *array, const void *key, cds_cmp_func cmp) {
+    if (!array || !key || !cmp) return 0;
+    return bound_in(array, 0, array->size, key, cmp, 0);
+}
+
+size_t cds_array_upper_bound(const struct cds_array *array, const void *key, cds_cmp_func cmp) {
+    if (!array || !key || !cmp) return 0;
+    return bound_in(array, 0, array->size, key, cmp, 1);
+}
+
+int cds_array_equal_range(const struct cds_array *array, const void *key, cds_cmp_func cmp,
+                          size_t *first, size_t *last) {
+    if (!array || !key || !cmp || !first || !last) return -1;
+    *first = bound_in(array, 0, array->size, key, cmp, 0);
+    *last = bound_in(array, *first, array->size, key, cmp, 1);
+    return 0;
+}
 
-    while (low <= high) {
-        int mid = low + (high - low) / 2;
-        void *mid_element = cds_array_get(array, mid);
-        int result = cmp(mid_element, key);
+size_t cds_array_search_exponential(const struct cds_array *array, size_t hint, const void *key,
+                                    cds_cmp_func cmp) {
+    if (!array || !key || !cmp) return 0;
+    const size_t n = array->size, es = array->element_size;
+    if (hint >= n) hint = n == 0 ? 0 : n - 1;
+    if (n == 0) return 0;
 
-        if (result == 0) {
-            return mid_element;
+    // Gallop away from the hint with doubling steps until the lower bound is bracketed, then bisect
+    // the last step: O(log d) comparisons for an answer d positions away.
+    size_t lo, hi;
+    if (cmp(array->data + hint * es, key) < 0) {
+        lo = hint + 1;
+        size_t step = 1;
+        while (lo + step - 1 < n && cmp(array->data + (lo + step - 1) * es, key) < 0) {
+            lo += step;
+            step *= 2;
         }
+        hi = lo + step - 1 < n ? lo + step - 1 : n;
+    } else {
+        hi = hint;
+        size_t step = 1;
+        while (hi >= step && cmp(array->data + (hi - step) * es, key) >= 0) {
+            hi -= step;
+            step *= 2;
+        }
+        lo = hi >= step ? hi - step + 1 : 0;
+    }
+    return bound_in(array, lo, hi, key, cmp, 0);
+}
+
+// Ranges at most this long are bisected instead of interpolated.
+#define INTERPOLATION_MIN_RANGE 16
 
-        if (result < 0) {
-            low = mid + 1;
+size_t cds_array_search_interpolation(const struct cds_array *array, size_t key_offset, size_t key_width,
+                                      int flags, const void *key) {
+    if (!array || !key || (key_width != 1 && key_width != 2 && key_width != 4 && key_width != 8) ||
+        ((flags & CDS_SORT_RADIX_FLOAT) && key_width < 4) || key_offset + key_width > array->element_size) {
+        return 0;
+    }
+    const size_t es = array->element_size;
+    const char *data = array->data;
+    const uint64_t target = radix_key(key, 0, key_width, flags);
+
+    // Invariant: the keys before lo are less than target, the keys from hi on are not.
+    size_t lo = 0, hi = array->size;
+    int strikes = 0;
+    while (hi - lo > INTERPOLATION_MIN_RANGE) {
+        const uint64_t first = radix_key(data + lo * es, key_offset, key_width, flags);
+        const uint64_t last = radix_key(data + (hi - 1) * es, key_offset, key_width, flags);
+        if (target <= first) return lo;
+        if (target > last) return hi;
+
+        // Probe where the target would sit if the keys were evenly spread between first and last.
+        const size_t len = hi - lo;
+        size_t probe = lo + (size_t) ((double) (target - first) / (double) (last - first) * (double) (len - 1));
+        if (probe >= hi) probe = hi - 1;
+        if (radix_key(data + probe * es, key_offset, key_width, flags) < target) {
+            lo = probe + 1;
         } else {
-            high = mid - 1;
+            hi = probe;
+        }
+
+        // On skewed keys interpolation can shrink the range by one element per probe. A bisection step
+        // after two probes in a row that failed to halve the range keeps the worst case at O(log n);
+        // on uniform keys it is rarely taken.
+        strikes = hi - lo > len / 2 ? strikes + 1 : 0;
+        if (strikes == 2 && hi - lo > INTERPOLATION_MIN_RANGE) {
+            strikes = 0;
+            const size_t mid = lo + (hi - lo) / 2;
+            if (radix_key(data + mid * es, key_offset, key_width, flags) < target) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
         }
     }
+    while (lo < hi && radix_key(data + lo * es, key_offset, key_width, flags) < target) {
+        lo++;
+    }
+    return lo;
+}
 
-    return NULL;
+// Searches in flight at once. Each step touches one element per search, so this many cache misses overlap.
+#define SEARCH_BATCH_WIDTH 32
+
+/*
+ * Every search of a group runs the same branch-free lower bound: the remaining length halves on a
+ * fixed schedule, only the base differs. So the group advances one step at a time, and right after a
+ * search's base moves, the element its next step compares is prefetched; it is needed only after the
+ * other searches of the group took their step.
+ */
+#define SEARCH_BATCH_BODY(LESS, EQUAL) do {                                                    \
+    for (size_t first = 0; first < n; first += SEARCH_BATCH_WIDTH) {                         \
+        const size_t count = n - first < SEARCH_BATCH_WIDTH ? n - first : SEARCH_BATCH_WIDTH; \
+        size_t base[SEARCH_BATCH_WIDTH] = {0};                                                \
+        size_t len = size;                                                                    \
+        while (len > 1) {                                                                     \
+            const size_t half = len / 2, next = (len - half) / 2;                             \
+            for (size_t i = 0; i < count; i++) {                                              \
+                const size_t probe = base[i] + half - 1;                                      \
+                base[i] += (size_t) LESS(probe, first + i) * half;                            \
+                __builtin_prefetch(data + (base[i] + (next > 0 ? next - 1 : 0)) * es);        \
+            }                                                                                 \
+            len -= half;                                                                      \
+        }                                                                                     \
+        for (size_t i = 0; i < count; i++) {                                                  \
+            const size_t lower = base[i] + LESS(base[i], first + i);                          \
+            results[first + i] = lower < size && EQUAL(lower, first + i) ? data + lower * es : NULL; \
+        }                                                                                     \
+    }                                                                                         \
+} while (0)
+
+int cds_array_search_binary_batch(const struct cds_array *array, const void *keys, size_t n,
+                                  void **results, cds_cmp_func cmp) {
+    if (!array || (n > 0 && (!keys || !results)) || !cmp) return -1;
+    const size_t size = array->size, es = array->element_size;
+    char *data = array->data;
+    if (size == 0) {
+        for (size_t i = 0; i < n; i++) results[i] = NULL;
+        return 0;
+    }
+
+    if (cmp == cds_cmp_i32 && es == sizeof(int32_t)) {
+        const int32_t *values = (const int32_t *) data, *k = keys;
+#define LESS(e, q) (values[e] < k[q])
+#define EQUAL(e, q) (values[e] == k[q])
+        SEARCH_BATCH_BODY(LESS, EQUAL);
+#undef LESS
+#undef EQUAL
+    } else if (cmp == cds_cmp_i64 && es == sizeof(int64_t)) {
+        const int64_t *values = (const int64_t *) data, *k = keys;
+#define LESS(e, q) (values[e] < k[q])
+#define EQUAL(e, q) (values[e] == k[q])
+        SEARCH_BATCH_BODY(LESS, EQUAL);
+#undef LESS
+#undef EQUAL
+    } else {
+        const char *k = keys;
+#define LESS(e, q) (cmp(data + (e) * es, k + (q) * es) < 0)
+#define EQUAL(e, q) (cmp(data + (e) * es, k + (q) * es) == 0)
+        SEARCH_BATCH_BODY(LESS, EQUAL);
+#undef LESS
+#undef EQUAL
+    }
+    return 0;
 }
@@ -0,0 +1,443 @@
+#define _POSIX_C_SOURCE 200809L  // mkstemp, pread, pwrite, posix_fadvise
+#define _FILE_OFFSET_BITS 64
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "cds/sort.h"
+#include "cds/array.h"
+
+// Merge buffers are at least this large so that every read and write stays a long sequential
+// transfer. When the budget cannot give each run two of them, the runs are merged in several passes.
+#define EXTERNAL_MIN_BLOCK (64 * 1024)
+
+/*
+ * Reads and writes of the merge phase are queued to one I/O thread. Every run and the output own two
+ * buffers: while the merge consumes (or fills) one, the I/O thread reads (or writes) the other.
+ */
+struct io_job {
+    struct io_job *next;
+    int fd;
+    bool write;
+    char *buf;
+    size_t len;
+    off_t offset;
+    ssize_t result;  // bytes transferred, or -1 on error
+    bool done;
+};
+
+struct io_thread {
+    pthread_mutex_t lock;
+    pthread_cond_t queued;    // a job was queued or stop was set
+    pthread_cond_t finished;  // a job is done
+    struct io_job *head, *tail;
+    bool stop, started;
+    pthread_t thread;
+};
+
+struct run {
+    off_t offset, length;  // bytes of a temporary file
+};
+
+struct run_reader {
+    struct io_job job;  // reads the next block into buf[1 - active]
+    char *buf[2];
+    int active;
+    size_t pos, len;    // the next element and the end of the data in buf[active]
+    off_t next, end;    // the part of the run not requested yet
+    bool pending;
+};
+
+struct run_writer {
+    struct io_job job;  // writes buf[1 - active]
+    char *buf[2];
+    int active;
+    size_t len;
+    off_t offset;
+    bool pending;
+};
+
+struct external_sort {
+    size_t element_size;
+    cds_cmp_func cmp;
+    size_t block;    // bytes per buffer, a multiple of element_size
+    size_t fan_in;   // runs merged at once
+    char *buffers;   // 2 * (fan_in + 1) blocks
+    struct io_thread io;
+};
+
+// Transfers the whole range, retrying short transfers. A read stops early only at end of file.
+static ssize_t io_transfer(int fd, bool write, char *buf, size_t len, off_t offset) {
+    size_t done = 0;
+    while (done < len) {
+        const ssize_t n = write ? pwrite(fd, buf + done, len - done, offset + (off_t) done)
+                                : pread(fd, buf + done, len - done, offset + (off_t) done);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) return -1;
+        if (n == 0) break;
+        done += (size_t) n;
+    }
+    return (ssize_t) done;
+}
+
+static void *io_thread_main(void *arg) {
+    struct io_thread *io = arg;
+    pthread_mutex_lock(&io->lock);
+    for (;;) {
+        while (!io->head && !io->stop) pthread_cond_wait(&io->queued, &io->lock);
+        struct io_job *job = io->head;
+        if (!job) break;  // stopped and drained
+        io->head = job->next;
+        if (!io->head) io->tail = NULL;
+        pthread_mutex_unlock(&io->lock);
+
+        const ssize_t result = io_transfer(job->fd, job->write, job->buf, job->len, job->offset);
+
+        pthread_mutex_lock(&io->lock);
+        job->result = result;
+        job->done = true;
+        pthread_cond_broadcast(&io->finished);
+    }
+    pthread_mutex_unlock(&io->lock);
+    return NULL;
+}
+
+// If the thread cannot be started every job runs synchronously in io_submit.
+static void io_start(struct io_thread *io) {
+    pthread_mutex_init(&io->lock, NULL);
+    pthread_cond_init(&io->queued, NULL);
+    pthread_cond_init(&io->finished, NULL);
+    io->head = io->tail = NULL;
+    io->stop = false;
+    io->started = pthread_create(&io->thread, NULL, io_thread_main, io) == 0;
+}
+
+// Finishes the queued jobs before the thread exits, so their buffers can be freed afterwards.
+static void io_stop(struct io_thread *io) {
+    if (io->started) {
+        pthread_mutex_lock(&io->lock);
+        io->stop = true;
+        pthread_cond_signal(&io->queued);
+        pthread_mutex_unlock(&io->lock);
+        pthread_join(io->thread, NULL);
+    }
+    pthread_cond_destroy(&io->finished);
+    pthread_cond_destroy(&io->queued);
+    pthread_mutex_destroy(&io->lock);
+}
+
+static void io_submit(struct io_thread *io, struct io_job *job) {
+    job->next = NULL;
+    job->done = false;
+    if (!io->started) {
+        job->result = io_transfer(job->fd, job->write, job->buf, job->len, job->offset);
+        job->done = true;
+        return;
+    }
+    pthread_mutex_lock(&io->lock);
+    if (io->tail) {
+        io->tail->next = job;
+    } else {
+        io->head = job;
+    }
+    io->tail = job;
+    pthread_cond_signal(&io->queued);
+    pthread_mutex_unlock(&io->lock);
+}
+
+// Returns 0 if the whole job was transferred.
+static int io_wait(struct io_thread *io, struct io_job *job) {
+    if (io->started) {
+        pthread_mutex_lock(&io->lock);
+        while (!job->done) pthread_cond_wait(&io->finished, &io->lock);
+        pthread_mutex_unlock(&io->lock);
+    }
+    return job->result == (ssize_t) job->len ? 0 : -1;
+}
+
+static void reader_prefetch(struct external_sort *s, struct run_reader *r, int fd) {
+    if (r->next >= r->end) return;
+    const off_t remaining = r->end - r->next;
+    const size_t len = remaining < (off_t) s->block ? (size_t) remaining : s->block;
+    r->job = (struct io_job) {.fd = fd, .write = false, .buf = r->buf[1 - r->active], .len = len,
+                              .offset = r->next};
+    r->next += (off_t) len;
+    r->pending = true;
+    io_submit(&s->io, &r->job);
+}
+
+// Switches to the prefetched block and requests the one after it. With nothing prefetched the
+// reader is left empty.
+static int reader_refill(struct external_sort *s, struct run_reader *r) {
+    r->pos = r->len = 0;
+    if (!r->pending) return 0;
+    r->pending = false;
+    if (io_wait(&s->io, &r->job) != 0) return -1;
+    r->active = 1 - r->active;
+    r->len = r->job.len;
+    reader_prefetch(s, r, r->job.fd);
+    return 0;
+}
+
+static int reader_start(struct external_sort *s, struct run_reader *r, int fd, const struct run *run,
+                        char *buf) {
+    r->buf[0] = buf;
+    r->buf[1] = buf + s->block;
+    r->active = 1;
+    r->pending = false;
+    r->next = run->offset;
+    r->end = run->offset + run->length;
+    reader_prefetch(s, r, fd);
+    return reader_refill(s, r);
+}
+
+static inline bool reader_empty(const struct run_reader *r) {
+    return r->pos == r->len;
+}
+
+static inline int reader_advance(struct external_sort *s, struct run_reader *r) {
+    r->pos += s->element_size;
+    return r->pos == r->len ? reader_refill(s, r) : 0;
+}
+
+static int writer_flush(struct external_sort *s, struct run_writer *w, int fd) {
+    if (w->pending) {
+        w->pending = false;
+        if (io_wait(&s->io, &w->job) != 0) return -1;
+    }
+    if (w->len == 0) return 0;
+    w->job = (struct io_job) {.fd = fd, .write = true, .buf = w->buf[w->active], .len = w->len,
+                              .offset = w->offset};
+    w->offset += (off_t) w->len;
+    w->pending = true;
+    io_submit(&s->io, &w->job);
+    w->active = 1 - w->active;
+    w->len = 0;
+    return 0;
+}
+
+// Loser tree over k runs: tree[1, k) holds the loser of the match at each internal node, tree[0] the
+// overall winner. Leaf i is node k + i, so the tree is complete for any k. An empty run loses every
+// match, and ties go to the lower run index.
+static inline bool run_less(const struct external_sort *s, const struct run_reader *readers,
+                            size_t a, size_t b) {
+    if (reader_empty(&readers[a])) return false;
+    if (reader_empty(&readers[b])) return true;
+    const int c = s->cmp(readers[a].buf[readers[a].active] + readers[a].pos,
+                         readers[b].buf[readers[b].active] + readers[b].pos);
+    return c < 0 || (c == 0 && a < b);
+}
+
+static size_t loser_tree_build(const struct external_sort *s, const struct run_reader *readers,
+                               size_t *tree, size_t k, size_t node) {
+    if (node >= k) return node - k;
+    const size_t a = loser_tree_build(s, readers, tree, k, 2 * node);
+    const size_t b = loser_tree_build(s, readers, tree, k, 2 * node + 1);
+    const bool a_wins = run_less(s, readers, a, b);
+    tree[node] = a_wins ? b : a;
+    return a_wins ? a : b;
+}
+
+// Merges runs[0, k) of src_fd into one run written to dst_fd at dst_offset.
+static int merge_runs(struct external_sort *s, int src_fd, const struct run *runs, size_t k,
+                      int dst_fd, off_t dst_offset) {
+    const size_t es = s->element_size;
+    struct run_reader *readers = malloc(k * sizeof(*readers));
+    size_t *tree = malloc(k * sizeof(*tree));
+    struct run_writer writer = {.buf = {s->buffers + 2 * k * s->block, s->buffers + (2 * k + 1) * s->block},
+                                .offset = dst_offset};
+    size_t started = 0;
+    int result = -1;
+    if (!readers || !tree) goto out;
+
+    for (; started < k; started++) {
+        struct run_reader *r = &readers[started];
+        if (reader_start(s, r, src_fd, &runs[started], s->buffers + 2 * started * s->block) != 0) goto out;
+    }
+
+    tree[0] = k > 1 ? loser_tree_build(s, readers, tree, k, 1) : 0;
+    for (;;) {
+        size_t winner = tree[0];
+        struct run_reader *r = &readers[winner];
+        if (reader_empty(r)) break;  // the winner is empty only when all runs are
+        memcpy(writer.buf[writer.active] + writer.len, r->buf[r->active] + r->pos, es);
+        writer.len += es;
+        if (writer.len == s->block && writer_flush(s, &writer, dst_fd) != 0) goto out;
+        if (reader_advance(s, r) != 0) goto out;
+
+        for (size_t node = (winner + k) / 2; node > 0; node /= 2) {
+            if (run_less(s, readers, tree[node], winner)) {
+                const size_t loser = winner;
+                winner = tree[node];
+                tree[node] = loser;
+            }
+        }
+        tree[0] = winner;
+    }
+    // The first flush queues the last block, the second waits for it.
+    if (writer_flush(s, &writer, dst_fd) == 0 && writer_flush(s, &writer, dst_fd) == 0) result = 0;
+
+out:
+    // After an error, jobs may still be queued on the readers and the writer.
+    for (size_t i = 0; i < started; i++) {
+        if (readers[i].pending) io_wait(&s->io, &readers[i].job);
+    }
+    if (writer.pending) io_wait(&s->io, &writer.job);
+    free(tree);
+    free(readers);
+    return result;
+}
+
+// The file is unlinked right away, so it disappears once closed, even if the process dies.
+static int open_temp(const char *tmp_dir) {
+    const char *name = "/cds-sort-XXXXXX";
+    char *path = malloc(strlen(tmp_dir) + strlen(name) + 1);
+    if (!path) return -1;
+    strcpy(path, tmp_dir);
+    strcat(path, name);
+    const int fd = mkstemp(path);
+    if (fd >= 0) unlink(path);
+    free(path);
+    return fd;
+}
+
+static void sort_chunk(char *data, size_t size, size_t element_size, cds_cmp_func cmp) {
+    struct cds_array view = {
+        .data = data,
+        .size = size,
+        .capacity = size,
+        .element_size = element_size,
+        .allocator = NULL};
+    cds_array_sort(&view, cmp);
+}
+
+// Sorts every mem_budget-sized chunk of the input into a run of tmp_fd.
+static int create_runs(int in_fd, off_t in_size, int tmp_fd, char *chunk, size_t chunk_bytes,
+                       size_t element_size, cds_cmp_func cmp, struct run *runs) {
+    size_t count = 0;
+    for (off_t offset = 0; offset < in_size; offset += (off_t) chunk_bytes) {
+        const size_t len = in_size - offset < (off_t) chunk_bytes ? (size_t) (in_size - offset) : chunk_bytes;
+        if (io_transfer(in_fd, false, chunk, len, offset) != (ssize_t) len) return -1;
+        sort_chunk(chunk, len / element_size, element_size, cmp);
+        if (io_transfer(tmp_fd, true, chunk, len, offset) != (ssize_t) len) return -1;
+        runs[count++] = (struct run) {offset, (off_t) len};
+    }
+    return 0;
+}
+
+static int sort_in_memory(int in_fd, size_t in_size, const char *out_path, size_t element_size,
+                          cds_cmp_func cmp) {
+    char *data = in_size > 0 ? malloc(in_size) : NULL;
+    if (in_size > 0 && !data) return -1;
+    int result = -1;
+    if (io_transfer(in_fd, false, data, in_size, 0) != (ssize_t) in_size) goto out;
+    sort_chunk(data, in_size / element_size, element_size, cmp);
+    // The input is fully read before the output is truncated, so in_path may equal out_path.
+    const int out_fd = open(out_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (out_fd < 0) goto out;
+    result = io_transfer(out_fd, true, data, in_size, 0) == (ssize_t) in_size ? 0 : -1;
+    if (close(out_fd) != 0) result = -1;
+
+out:
+    free(data);
+    return result;
+}
+
+int cds_external_sort(const char *in_path, const char *out_path, size_t element_size, cds_cmp_func cmp,
+                      size_t mem_budget) {
+    return cds_external_sort_with_tmp_dir(in_path, out_path, element_size, cmp, mem_budget, NULL);
+}
+
+int cds_external_sort_with_tmp_dir(const char *in_path, const char *out_path, size_t element_size,
+                                   cds_cmp_func cmp, size_t mem_budget, const char *tmp_dir) {
+    if (!in_path || !out_path || element_size == 0 || !cmp) return -1;
+    if (mem_budget == 0) mem_budget = CDS_EXTERNAL_SORT_DEFAULT_BUDGET;
+    if (!tmp_dir) {
+        tmp_dir = getenv("TMPDIR");
+        if (!tmp_dir || !*tmp_dir) tmp_dir = "/tmp";
+    }
+
+    const int in_fd = open(in_path, O_RDONLY);
+    if (in_fd < 0) return -1;
+    struct stat in_stat;
+    if (fstat(in_fd, &in_stat) != 0 || in_stat.st_size % (off_t) element_size != 0) {
+        close(in_fd);
+        return -1;
+    }
+    const off_t in_size = in_stat.st_size;
+    posix_fadvise(in_fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    size_t chunk_bytes = mem_budget / element_size * element_size;
+    if (chunk_bytes == 0) chunk_bytes = element_size;
+    if (in_size <= (off_t) chunk_bytes) {
+        const int result = sort_in_memory(in_fd, (size_t) in_size, out_path, element_size, cmp);
+        close(in_fd);
+        return result;
+    }
+
+    // Phase 1: sorted runs of chunk_bytes each.
+    size_t nruns = (size_t) ((in_size + (off_t) chunk_bytes - 1) / (off_t) chunk_bytes);
+    struct run *runs = malloc(nruns * sizeof(*runs));
+    char *chunk = malloc(chunk_bytes);
+    int tmp_fd[2] = {open_temp(tmp_dir), -1};
+    int result = -1;
+    struct external_sort s = {.element_size = element_size, .cmp = cmp};
+    bool io_started = false;
+    if (!runs || !chunk || tmp_fd[0] < 0) goto out;
+    if (create_runs(in_fd, in_size, tmp_fd[0], chunk, chunk_bytes, element_size, cmp, runs) != 0) goto out;
+    free(chunk);
+    chunk = NULL;
+    close(in_fd);
+
+    // Phase 2: merge fan_in runs at a time until one pass into out_path is left.
+    s.fan_in = mem_budget / (2 * EXTERNAL_MIN_BLOCK);
+    s.fan_in = s.fan_in > 3 ? s.fan_in - 1 : 2;
+    if (s.fan_in > nruns) s.fan_in = nruns;
+    s.block = mem_budget / (2 * (s.fan_in + 1)) / element_size * element_size;
+    if (s.block == 0) s.block = element_size;
+    s.buffers = malloc(2 * (s.fan_in + 1) * s.block);
+    if (!s.buffers) goto out_no_input;
+    io_start(&s.io);
+    io_started = true;
+
+    int src = 0;
+    while (nruns > s.fan_in) {
+        const int dst = 1 - src;
+        if (tmp_fd[dst] < 0) tmp_fd[dst] = open_temp(tmp_dir);
+        if (tmp_fd[dst] < 0 || ftruncate(tmp_fd[dst], 0) != 0) goto out_no_input;
+        size_t merged = 0;
+        for (size_t first = 0; first < nruns; first += s.fan_in) {
+            const size_t k = nruns - first < s.fan_in ? nruns - first : s.fan_in;
+            const off_t offset = runs[first].offset;  // runs are stored back to back
+            const off_t length = runs[first + k - 1].offset + runs[first + k - 1].length - offset;
+            if (merge_runs(&s, tmp_fd[src], runs + first, k, tmp_fd[dst], offset) != 0) goto out_no_input;
+            runs[merged++] = (struct run) {offset, length};
+        }
+        nruns = merged;
+        src = dst;
+    }
+
+    const int out_fd = open(out_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (out_fd < 0) goto out_no_input;
+    result = merge_runs(&s, tmp_fd[src], runs, nruns, out_fd, 0);
+    if (close(out_fd) != 0) result = -1;
+    goto out_no_input;
+
+out:
+    close(in_fd);
+out_no_input:
+    if (io_started) io_stop(&s.io);
+    free(s.buffers);
+    free(chunk);
+    free(runs);
+    for (int i = 0; i < 2; i++) {
+        if (tmp_fd[i] >= 0) close(tmp_fd[i]);
+    }
+    return result;
+}
@@ -0,0 +1,189 @@
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cds/sort.h"
+#include "cds/array.h"
+
+// Up to this many pairs are sorted by insertion; above it the histograms cost more than they save.
+#define KEY_INSERTION_MAX 64
+// Up to this many pairs (256 KiB) are sorted with LSD passes, which then run in cache.
+#define KEY_LSD_MAX 16384
+// Elements up to this size are held on the stack while a permutation cycle is rotated.
+#define KEY_STACK_SCRATCH 256
+
+struct key_index {
+    uint64_t key;
+    size_t index;
+};
+
+static void insertion_sort_pairs(struct key_index *pairs, size_t n) {
+    for (size_t i = 1; i < n; i++) {
+        const struct key_index pair = pairs[i];
+        size_t j = i;
+        for (; j > 0 && pair.key < pairs[j - 1].key; j--) {
+            pairs[j] = pairs[j - 1];
+        }
+        pairs[j] = pair;
+    }
+}
+
+// Sorts the pairs by bytes [0, top] of their keys, a byte per pass; the result ends up in pairs. All
+// histograms are built in one pass and a byte where every key is the same is skipped.
+static void lsd_sort_pairs(struct key_index *pairs, struct key_index *scratch, size_t n, unsigned top) {
+    size_t histogram[8][256] = {{0}};
+    for (size_t i = 0; i < n; i++) {
+        const uint64_t key = pairs[i].key;
+        for (unsigned pass = 0; pass <= top; pass++) {
+            histogram[pass][(key >> (pass * 8)) & 0xff]++;
+        }
+    }
+
+    struct key_index *src = pairs, *dst = scratch;
+    for (unsigned pass = 0; pass <= top; pass++) {
+        size_t *counts = histogram[pass];
+        const unsigned shift = pass * 8;
+        if (counts[(src[0].key >> shift) & 0xff] == n) continue;
+
+        size_t offset = 0;
+        for (size_t b = 0; b < 256; b++) {
+            const size_t count = counts[b];
+            counts[b] = offset;
+            offset += count;
+        }
+        for (size_t i = 0; i < n; i++) {
+            dst[counts[(src[i].key >> shift) & 0xff]++] = src[i];
+        }
+        struct key_index *tp = src;
+        src = dst;
+        dst = tp;
+    }
+    if (src != pairs) {
+        memcpy(pairs, src, n * sizeof(*pairs));
+    }
+}
+
+/*
+ * Sorts the pairs by bytes [0, top] of their keys; the result ends up in pairs. Large inputs are
+ * split into 256 buckets by their highest byte that differs, and every bucket is sorted the same way
+ * and copied back while it is still in cache, so only the first pass streams the whole input through
+ * memory. Buckets of up to KEY_LSD_MAX pairs are finished with LSD passes. Every pass is stable and
+ * the pairs start in index order, so equal keys keep their original order.
+ */
+static void msd_sort_pairs(struct key_index *pairs, struct key_index *scratch, size_t n, unsigned top) {
+    if (n <= KEY_INSERTION_MAX) {
+        insertion_sort_pairs(pairs, n);
+        return;
+    }
+    if (n <= KEY_LSD_MAX) {
+        lsd_sort_pairs(pairs, scratch, n, top);
+        return;
+    }
+
+    size_t counts[256];
+    for (;;) {
+        memset(counts, 0, sizeof(counts));
+        for (size_t i = 0; i < n; i++) {
+            counts[(pairs[i].key >> (top * 8)) & 0xff]++;
+        }
+        if (counts[(pairs[0].key >> (top * 8)) & 0xff] != n) break;
+        if (top == 0) return;
+        top--;
+    }
+
+    size_t offset = 0;
+    for (size_t b = 0; b < 256; b++) {
+        const size_t count = counts[b];
+        counts[b] = offset;
+        offset += count;
+    }
+    for (size_t i = 0; i < n; i++) {
+        scratch[counts[(pairs[i].key >> (top * 8)) & 0xff]++] = pairs[i];
+    }
+    // counts[b] is now the end of bucket b.
+    for (size_t b = 0, begin = 0; b < 256; begin = counts[b++]) {
+        const size_t count = counts[b] - begin;
+        if (count == 0) continue;
+        if (top > 0) {
+            msd_sort_pairs(scratch + begin, pairs + begin, count, top - 1);
+        }
+        memcpy(pairs + begin, scratch + begin, count * sizeof(*pairs));
+    }
+}
+
+// Extracts and sorts the (key, index) pairs of array. Returns the sorted pairs, or NULL if memory
+// allocation fails. The caller frees them.
+static struct key_index *sorted_pairs(const struct cds_array *array, cds_key_func key) {
+    const size_t n = array->size, es = array->element_size;
+    struct key_index *pairs = malloc(2 * n * sizeof(*pairs));
+    if (!pairs) return NULL;
+
+    const char *element = array->data;
+    uint64_t differ = 0;
+    for (size_t i = 0; i < n; i++, element += es) {
+        pairs[i].key = key(element);
+        pairs[i].index = i;
+        differ |= pairs[i].key ^ pairs[0].key;
+    }
+    if (differ == 0) return pairs;
+    unsigned top = 7;
+    while ((differ >> (top * 8)) == 0) top--;
+    msd_sort_pairs(pairs, pairs + n, n, top);
+    return pairs;
+}
+
+int cds_array_argsort(const struct cds_array *array, cds_key_func key, struct cds_array *out) {
+    if (!array || !key || !out || out == array || out->element_size != sizeof(size_t)) return -1;
+    const size_t n = array->size;
+    if (cds_array_resize(out, n) != 0) return -1;
+    if (n == 0) return 0;
+
+    struct key_index *pairs = sorted_pairs(array, key);
+    if (!pairs) {
+        out->size = 0;
+        return -1;
+    }
+    size_t *permutation = (size_t *) out->data;
+    for (size_t i = 0; i < n; i++) {
+        permutation[i] = pairs[i].index;
+    }
+    free(pairs);
+    return 0;
+}
+
+int cds_array_sort_by_key(struct cds_array *array, cds_key_func key) {
+    if (!array || !key) return -1;
+    const size_t n = array->size, es = array->element_size;
+    if (n <= 1) return 0;
+
+    _Alignas(16) char stack_scratch[KEY_STACK_SCRATCH];
+    char *tmp = es <= KEY_STACK_SCRATCH ? stack_scratch : malloc(es);
+    if (!tmp) return -1;
+    struct key_index *pairs = sorted_pairs(array, key);
+    if (!pairs) {
+        if (tmp != stack_scratch) free(tmp);
+        return -1;
+    }
+
+    // Position i receives the element at pairs[i].index. Each cycle of the permutation is rotated
+    // through tmp, and a position that has been filled is marked by pointing its pair at itself, so
+    // every element is moved exactly once.
+    char *data = array->data;
+    for (size_t i = 0; i < n; i++) {
+        if (pairs[i].index == i) continue;
+        memcpy(tmp, data + i * es, es);
+        size_t j = i;
+        for (;;) {
+            const size_t from = pairs[j].index;
+            pairs[j].index = j;
+            if (from == i) break;
+            memcpy(data + j * es, data + from * es, es);
+            j = from;
+        }
+        memcpy(data + j * es, tmp, es);
+    }
+
+    free(pairs);
+    if (tmp != stack_scratch) free(tmp);
+    return 0;
+}
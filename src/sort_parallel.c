@@ -0,0 +1,194 @@
+#define _POSIX_C_SOURCE 200809L  // sysconf
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "cds/sort.h"
+#include "cds/array.h"
+
+struct parallel_sort_task {
+    // Sort phase: data[lo, hi) is sorted in place.
+    // Merge phase: src[a_lo, a_hi) and src[b_lo, b_hi) are merged into dst starting at out.
+    const char *src;
+    char *dst;
+    size_t a_lo, a_hi, b_lo, b_hi, out;
+    size_t element_size;
+    cds_cmp_func cmp;
+};
+
+struct parallel_sort_worker {
+    struct parallel_sort_task *tasks;
+    size_t first, count, stride;
+    void (*run)(struct parallel_sort_task *task);
+};
+
+static void run_sort_task(struct parallel_sort_task *task) {
+    struct cds_array view = {
+        .data = task->dst + task->a_lo * task->element_size,
+        .size = task->a_hi - task->a_lo,
+        .capacity = task->a_hi - task->a_lo,
+        .element_size = task->element_size,
+        .allocator = NULL};
+    cds_array_sort(&view, task->cmp);
+}
+
+static void run_merge_task(struct parallel_sort_task *task) {
+    const size_t es = task->element_size;
+    const char *src = task->src;
+    char *out = task->dst + task->out * es;
+    size_t i = task->a_lo, j = task->b_lo;
+    while (i < task->a_hi && j < task->b_hi) {
+        if (task->cmp(src + j * es, src + i * es) < 0) {
+            memcpy(out, src + j * es, es);
+            j++;
+        } else {
+            memcpy(out, src + i * es, es);
+            i++;
+        }
+        out += es;
+    }
+    memcpy(out, src + i * es, (task->a_hi - i) * es);
+    out += (task->a_hi - i) * es;
+    memcpy(out, src + j * es, (task->b_hi - j) * es);
+}
+
+static void *parallel_sort_worker_main(void *arg) {
+    struct parallel_sort_worker *worker = arg;
+    for (size_t t = worker->first; t < worker->count; t += worker->stride) {
+        worker->run(&worker->tasks[t]);
+    }
+    return NULL;
+}
+
+static void run_tasks(struct parallel_sort_task *tasks, size_t count, size_t nthreads,
+                      void (*run)(struct parallel_sort_task *task)) {
+    pthread_t threads[CDS_SORT_PARALLEL_MAX_THREADS];
+    struct parallel_sort_worker workers[CDS_SORT_PARALLEL_MAX_THREADS];
+    bool started[CDS_SORT_PARALLEL_MAX_THREADS];
+    if (count == 0 || nthreads == 0) return;
+    if (nthreads > count) nthreads = count;
+
+    for (size_t t = 0; t < nthreads; t++) {
+        workers[t] = (struct parallel_sort_worker) {tasks, t, count, nthreads, run};
+        started[t] = t > 0 && pthread_create(&threads[t], NULL, parallel_sort_worker_main, &workers[t]) == 0;
+    }
+    parallel_sort_worker_main(&workers[0]);
+    for (size_t t = 1; t < nthreads; t++) {
+        if (started[t]) {
+            pthread_join(threads[t], NULL);
+        } else {
+            parallel_sort_worker_main(&workers[t]);
+        }
+    }
+}
+
+// Number of elements of a taken among the first k of the stable merge of a and b.
+static size_t merge_corank(const char *a, size_t a_len, const char *b, size_t b_len, size_t k,
+                           size_t element_size, cds_cmp_func cmp) {
+    size_t lo = k > b_len ? k - b_len : 0;
+    size_t hi = k < a_len ? k : a_len;
+    while (lo < hi) {
+        size_t i = lo + (hi - lo) / 2;
+        size_t j = k - i;
+        if (i < a_len && j > 0 && cmp(a + i * element_size, b + (j - 1) * element_size) <= 0) {
+            lo = i + 1;
+        } else if (i > 0 && j < b_len && cmp(a + (i - 1) * element_size, b + j * element_size) > 0) {
+            hi = i - 1;
+        } else {
+            return i;
+        }
+    }
+    return lo;
+}
+
+int cds_array_sort_parallel(struct cds_array *array, cds_cmp_func cmp, size_t nthreads) {
+    if (!array || !cmp) return -1;
+    if (nthreads == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        nthreads = online > 0 ? (size_t) online : 1;
+    }
+    if (nthreads > CDS_SORT_PARALLEL_MAX_THREADS) nthreads = CDS_SORT_PARALLEL_MAX_THREADS;
+    if (nthreads > array->size / CDS_SORT_PARALLEL_THRESHOLD) {
+        nthreads = array->size / CDS_SORT_PARALLEL_THRESHOLD;
+    }
+    if (nthreads <= 1) {
+        cds_array_sort(array, cmp);
+        return 0;
+    }
+
+    const size_t n = array->size, es = array->element_size;
+    char *scratch = malloc(n * es);
+    struct parallel_sort_task *tasks = malloc(nthreads * 2 * sizeof(struct parallel_sort_task));
+    size_t *bounds = malloc((nthreads + 1) * sizeof(size_t));
+    if (!scratch || !tasks || !bounds) {
+        free(scratch);
+        free(tasks);
+        free(bounds);
+        return -1;
+    }
+
+    // Phase 1: sort nthreads contiguous runs independently.
+    size_t runs = nthreads;
+    for (size_t r = 0; r <= runs; r++) {
+        bounds[r] = n * r / runs;
+    }
+    for (size_t r = 0; r < runs; r++) {
+        tasks[r] = (struct parallel_sort_task) {
+            .dst = array->data, .a_lo = bounds[r], .a_hi = bounds[r + 1],
+            .element_size = es, .cmp = cmp};
+    }
+    run_tasks(tasks, runs, nthreads, run_sort_task);
+
+    // Phase 2: merge adjacent runs pairwise, splitting every merge across the threads so that the
+    // last rounds stay parallel.
+    char *src = array->data, *dst = scratch;
+    while (runs > 1) {
+        const size_t pairs = runs / 2;
+        const size_t pieces = nthreads / pairs > 0 ? nthreads / pairs : 1;
+        size_t task_count = 0;
+        for (size_t p = 0; p < pairs; p++) {
+            const size_t lo = bounds[2 * p], mid = bounds[2 * p + 1], hi = bounds[2 * p + 2];
+            const char *a = src + lo * es, *b = src + mid * es;
+            size_t prev_i = 0, prev_k = 0;
+            for (size_t s = 1; s <= pieces; s++) {
+                const size_t k = (hi - lo) * s / pieces;
+                const size_t i = s == pieces ? mid - lo : merge_corank(a, mid - lo, b, hi - mid, k, es, cmp);
+                tasks[task_count++] = (struct parallel_sort_task) {
+                    .src = src, .dst = dst,
+                    .a_lo = lo + prev_i, .a_hi = lo + i,
+                    .b_lo = mid + (prev_k - prev_i), .b_hi = mid + (k - i),
+                    .out = lo + prev_k, .element_size = es, .cmp = cmp};
+                prev_i = i;
+                prev_k = k;
+            }
+        }
+        if (runs % 2 == 1) {
+            const size_t lo = bounds[runs - 1], hi = bounds[runs];
+            tasks[task_count++] = (struct parallel_sort_task) {
+                .src = src, .dst = dst, .a_lo = lo, .a_hi = hi, .b_lo = hi, .b_hi = hi,
+                .out = lo, .element_size = es, .cmp = cmp};
+        }
+        run_tasks(tasks, task_count, nthreads, run_merge_task);
+
+        for (size_t p = 0; p < pairs; p++) {
+            bounds[p + 1] = bounds[2 * p + 2];
+        }
+        if (runs % 2 == 1) {
+            bounds[pairs + 1] = bounds[runs];
+        }
+        runs = (runs + 1) / 2;
+        char *tp = src;
+        src = dst;
+        dst = tp;
+    }
+
+    if (src != array->data) {
+        memcpy(array->data, src, n * es);
+    }
+    free(scratch);
+    free(tasks);
+    free(bounds);
+    return 0;
+}
@@ -0,0 +1,427 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "cds/sort.h"
+
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(CDS_SORT_SET_NO_SIMD)
+#define CDS_SORT_SET_X86 1
+#include <immintrin.h>
+#else
+#define CDS_SORT_SET_X86 0
+#endif
+
+// The longer input is galloped through once it is this many times longer than the other.
+#define SET_GALLOP_RATIO 32
+
+enum set_op { SET_MERGE, SET_UNION, SET_INTERSECT, SET_DIFFERENCE };
+
+struct set_output {
+    char *data;
+    size_t size, es;
+};
+
+static inline void emit(struct set_output *out, const char *src, size_t count) {
+    memcpy(out->data + out->size * out->es, src, count * out->es);
+    out->size += count;
+}
+
+/*
+ * Every operation keeps the elements of a in their order and treats b as a set of values: intersect
+ * keeps the elements of a whose value is in b, difference those whose value is not, union adds the
+ * elements of b whose value is not in a, and merge adds all of b after the equal elements of a. For
+ * inputs without duplicates these are the usual set operations.
+ */
+static void linear_generic(enum set_op op, const char *a, size_t na, const char *b, size_t nb, size_t es,
+                           cds_cmp_func cmp, struct set_output *out) {
+    size_t i = 0, j = 0;
+    while (i < na && j < nb) {
+        const int c = cmp(a + i * es, b + j * es);
+        if (c < 0) {
+            if (op != SET_INTERSECT) emit(out, a + i * es, 1);
+            i++;
+        } else if (c > 0) {
+            if (op == SET_MERGE || op == SET_UNION) emit(out, b + j * es, 1);
+            j++;
+        } else if (op == SET_UNION) {
+            j++;
+        } else {
+            if (op != SET_DIFFERENCE) emit(out, a + i * es, 1);
+            i++;
+        }
+    }
+    if (op != SET_INTERSECT) emit(out, a + i * es, na - i);
+    if (op == SET_MERGE || op == SET_UNION) emit(out, b + j * es, nb - j);
+}
+
+/*
+ * Galloping: each element of the short input is located in the long one with an exponential search
+ * that starts where the previous one ended, and the runs in between are copied whole, which takes
+ * O(m log(n / m)) comparisons for inputs of m and n elements.
+ */
+
+// The first index from `from` on whose element e has cmp(e, key) >= bias: the lower bound of key for
+// bias 0, the upper bound for bias 1.
+static size_t gallop(const char *base, size_t from, size_t n, size_t es, const void *key, cds_cmp_func cmp,
+                     int bias) {
+    size_t lo = from, step = 1;
+    while (lo + step - 1 < n && cmp(base + (lo + step - 1) * es, key) < bias) {
+        lo += step;
+        step *= 2;
+    }
+    size_t len = (lo + step - 1 < n ? lo + step - 1 : n) - lo;
+    while (len > 0) {
+        const size_t half = len / 2;
+        if (cmp(base + (lo + half) * es, key) < bias) {
+            lo += half + 1;
+            len -= half + 1;
+        } else {
+            len = half;
+        }
+    }
+    return lo;
+}
+
+static void gallop_long_a(enum set_op op, const char *a, size_t na, const char *b, size_t nb, size_t es,
+                          cds_cmp_func cmp, struct set_output *out) {
+    size_t i = 0;
+    for (size_t j = 0; j < nb; j++) {
+        const char *key = b + j * es;
+        const size_t lo = gallop(a, i, na, es, key, cmp, op == SET_MERGE);
+        if (op != SET_INTERSECT) emit(out, a + i * es, lo - i);
+        i = lo;
+        if (op == SET_MERGE || (op == SET_UNION && (i == na || cmp(a + i * es, key) != 0))) {
+            emit(out, key, 1);
+        } else if (op == SET_INTERSECT || op == SET_DIFFERENCE) {
+            const size_t hi = gallop(a, i, na, es, key, cmp, 1);
+            if (op == SET_INTERSECT) emit(out, a + i * es, hi - i);
+            i = hi;
+        }
+    }
+    if (op != SET_INTERSECT) emit(out, a + i * es, na - i);
+}
+
+static void gallop_long_b(enum set_op op, const char *a, size_t na, const char *b, size_t nb, size_t es,
+                          cds_cmp_func cmp, struct set_output *out) {
+    size_t j = 0;
+    for (size_t i = 0; i < na; i++) {
+        const char *key = a + i * es;
+        const size_t lo = gallop(b, j, nb, es, key, cmp, 0);
+        if (op == SET_MERGE || op == SET_UNION) {
+            emit(out, b + j * es, lo - j);
+            emit(out, key, 1);
+            j = op == SET_UNION ? gallop(b, lo, nb, es, key, cmp, 1) : lo;
+        } else {
+            const bool found = lo < nb && cmp(b + lo * es, key) == 0;
+            if (found == (op == SET_INTERSECT)) emit(out, key, 1);
+            j = lo;
+        }
+    }
+    if (op == SET_MERGE || op == SET_UNION) emit(out, b + j * es, nb - j);
+}
+
+#if CDS_SORT_SET_X86
+/*
+ * The SIMD kernels work on 32- or 64-bit integers and take sign, the value xor-ed onto the keys to
+ * order them as signed integers: 0 for signed keys, the top bit for unsigned ones. They run while
+ * whole vectors are left in both inputs and return through i, j and k where the scalar code resumes.
+ *
+ * Filtering (intersect and difference) compares a block of a with a block of b in all rotations and
+ * collects which elements of the a block have a match. The a block is written out, compacted to the
+ * kept elements with a shuffle, once its last element is not past the last one of the b block; the
+ * b block is skipped once its last element is before the last one of the a block. Equal last
+ * elements only advance a, so a run of equal values that continues into the next a block is still
+ * compared with the b block that holds its match.
+ */
+
+// pshufb masks that move the 32-bit lanes set in the index to the front.
+static const int8_t compact_epi32[16][16] = {
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {0, 1, 2, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {4, 5, 6, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {0, 1, 2, 3, 4, 5, 6, 7, -1, -1, -1, -1, -1, -1, -1, -1},
+    {8, 9, 10, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {0, 1, 2, 3, 8, 9, 10, 11, -1, -1, -1, -1, -1, -1, -1, -1},
+    {4, 5, 6, 7, 8, 9, 10, 11, -1, -1, -1, -1, -1, -1, -1, -1},
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, -1, -1, -1, -1},
+    {12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {0, 1, 2, 3, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1},
+    {4, 5, 6, 7, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1},
+    {0, 1, 2, 3, 4, 5, 6, 7, 12, 13, 14, 15, -1, -1, -1, -1},
+    {8, 9, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1},
+    {0, 1, 2, 3, 8, 9, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1},
+    {4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1},
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+};
+
+// vpermd indices that move the 64-bit lanes set in the index to the front.
+static const int32_t compact_epi64[16][8] = {
+    {0, 0, 0, 0, 0, 0, 0, 0}, {0, 1, 0, 0, 0, 0, 0, 0}, {2, 3, 0, 0, 0, 0, 0, 0}, {0, 1, 2, 3, 0, 0, 0, 0},
+    {4, 5, 0, 0, 0, 0, 0, 0}, {0, 1, 4, 5, 0, 0, 0, 0}, {2, 3, 4, 5, 0, 0, 0, 0}, {0, 1, 2, 3, 4, 5, 0, 0},
+    {6, 7, 0, 0, 0, 0, 0, 0}, {0, 1, 6, 7, 0, 0, 0, 0}, {2, 3, 6, 7, 0, 0, 0, 0}, {0, 1, 2, 3, 6, 7, 0, 0},
+    {4, 5, 6, 7, 0, 0, 0, 0}, {0, 1, 4, 5, 6, 7, 0, 0}, {2, 3, 4, 5, 6, 7, 0, 0}, {0, 1, 2, 3, 4, 5, 6, 7},
+};
+
+// The b elements skipped while the current a block was open may match it; the scalar code has to see
+// them again unless the block had no match so far.
+#define FILTER_KERNEL_BODY(T, S, LOAD_COMPARE, STORE) do {                                     \
+    size_t i = *pi, j = *pj, k = *pk, block_j = j;                                              \
+    unsigned found = 0;                                                                         \
+    while (i + 4 <= na && j + 4 <= nb) {                                                        \
+        found |= LOAD_COMPARE;                                                                  \
+        const S a_last = (S) (a[i + 3] ^ sign), b_last = (S) (b[j + 3] ^ sign);                 \
+        if (b_last < a_last) {                                                                  \
+            j += 4;                                                                             \
+            continue;                                                                           \
+        }                                                                                       \
+        const unsigned mask = keep ? found : ~found & 0xF;                                      \
+        STORE;                                                                                  \
+        k += (size_t) __builtin_popcount(mask);                                                 \
+        i += 4;                                                                                 \
+        found = 0;                                                                              \
+        block_j = j;                                                                            \
+    }                                                                                           \
+    *pi = i;                                                                                    \
+    *pj = found ? block_j : j;                                                                  \
+    *pk = k;                                                                                    \
+} while (0)
+
+__attribute__((target("ssse3")))
+static inline unsigned match_epi32(const uint32_t *a, const uint32_t *b) {
+    const __m128i va = _mm_loadu_si128((const __m128i *) a), vb = _mm_loadu_si128((const __m128i *) b);
+    const __m128i eq = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi32(va, vb), _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0x39))),
+        _mm_or_si128(_mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0x4E)),
+                     _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0x93))));
+    return (unsigned) _mm_movemask_ps(_mm_castsi128_ps(eq));
+}
+
+__attribute__((target("ssse3")))
+static void filter_32_ssse3(const uint32_t *a, size_t na, const uint32_t *b, size_t nb, uint32_t *out,
+                            bool keep, uint32_t sign, size_t *pi, size_t *pj, size_t *pk) {
+    FILTER_KERNEL_BODY(uint32_t, int32_t, match_epi32(a + i, b + j),
+        _mm_storeu_si128((__m128i *) (out + k),
+                         _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (a + i)),
+                                          _mm_loadu_si128((const __m128i *) compact_epi32[mask]))));
+}
+
+__attribute__((target("avx2")))
+static inline unsigned match_epi64(const uint64_t *a, const uint64_t *b) {
+    const __m256i va = _mm256_loadu_si256((const __m256i *) a), vb = _mm256_loadu_si256((const __m256i *) b);
+    const __m256i eq = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi64(va, vb),
+                        _mm256_cmpeq_epi64(va, _mm256_permute4x64_epi64(vb, 0x39))),
+        _mm256_or_si256(_mm256_cmpeq_epi64(va, _mm256_permute4x64_epi64(vb, 0x4E)),
+                        _mm256_cmpeq_epi64(va, _mm256_permute4x64_epi64(vb, 0x93))));
+    return (unsigned) _mm256_movemask_pd(_mm256_castsi256_pd(eq));
+}
+
+__attribute__((target("avx2")))
+static void filter_64_avx2(const uint64_t *a, size_t na, const uint64_t *b, size_t nb, uint64_t *out,
+                           bool keep, uint64_t sign, size_t *pi, size_t *pj, size_t *pk) {
+    FILTER_KERNEL_BODY(uint64_t, int64_t, match_epi64(a + i, b + j),
+        _mm256_storeu_si256((__m256i *) (out + k),
+                            _mm256_permutevar8x32_epi32(
+                                _mm256_loadu_si256((const __m256i *) (a + i)),
+                                _mm256_loadu_si256((const __m256i *) compact_epi64[mask]))));
+}
+
+/*
+ * Merging keeps one vector of pending elements. Each step loads the next vector from the input with
+ * the smaller next element, merges it with the pending one in a bitonic network, writes out the
+ * lower half and keeps the upper half pending. The vector is loaded before anything is written, so
+ * b may lie in out behind the write position (see set_union). On return the pending elements are
+ * counted as read but not written, i + j - k of them; the scalar code splits them back between the
+ * inputs.
+ */
+__attribute__((target("avx2")))
+static inline __m256i minmax_epi32(__m256i x, __m256i y, __m256i *hi) {
+    *hi = _mm256_max_epi32(x, y);
+    return _mm256_min_epi32(x, y);
+}
+
+// Sorts a bitonic vector of 8 keys: lane l is compared with lane l ^ 4, then l ^ 2, then l ^ 1.
+__attribute__((target("avx2")))
+static inline __m256i bitonic_clean_epi32(__m256i v) {
+    __m256i hi, lo;
+    lo = minmax_epi32(v, _mm256_permute2x128_si256(v, v, 0x01), &hi);
+    v = _mm256_blend_epi32(lo, hi, 0xF0);
+    lo = minmax_epi32(v, _mm256_shuffle_epi32(v, 0x4E), &hi);
+    v = _mm256_blend_epi32(lo, hi, 0xCC);
+    lo = minmax_epi32(v, _mm256_shuffle_epi32(v, 0xB1), &hi);
+    return _mm256_blend_epi32(lo, hi, 0xAA);
+}
+
+__attribute__((target("avx2")))
+static void merge_32_avx2(const uint32_t *a, size_t na, const uint32_t *b, size_t nb, uint32_t *out,
+                          uint32_t sign, size_t *pi, size_t *pj, size_t *pk) {
+    size_t i = *pi, j = *pj, k = *pk;
+    if (na - i < 8 || nb - j < 8) return;
+    const __m256i flip = _mm256_set1_epi32((int32_t) sign);
+    const __m256i reverse = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+    __m256i pending = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *) (a + i)), flip);
+    i += 8;
+    for (;;) {
+        const bool from_a = i < na && (j == nb || (int32_t) (a[i] ^ sign) <= (int32_t) (b[j] ^ sign));
+        if (from_a ? i + 8 > na : j + 8 > nb) break;
+        const uint32_t *src = from_a ? a + i : b + j;
+        const __m256i next = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *) src), flip);
+        if (from_a) i += 8; else j += 8;
+        __m256i hi;
+        const __m256i lo = minmax_epi32(pending, _mm256_permutevar8x32_epi32(next, reverse), &hi);
+        _mm256_storeu_si256((__m256i *) (out + k), _mm256_xor_si256(bitonic_clean_epi32(lo), flip));
+        pending = bitonic_clean_epi32(hi);
+        k += 8;
+    }
+    *pi = i;
+    *pj = j;
+    *pk = k;
+}
+#endif
+
+/*
+ * Typed versions for the integer comparators. FILTER writes the elements of a whose value is (keep)
+ * or is not (!keep) in b; MERGE writes both inputs in order and accepts b inside out, behind the
+ * write position.
+ */
+#define DEFINE_SET_TYPED(T, U, S, NAME, SIGN, FILTER_SIMD, MERGE_SIMD)                          \
+static size_t filter_##NAME(const T *a, size_t na, const T *b, size_t nb, T *out, bool keep) {  \
+    size_t i = 0, j = 0, k = 0;                                                                 \
+    FILTER_SIMD((const U *) a, na, (const U *) b, nb, (U *) out, keep, SIGN, &i, &j, &k);       \
+    while (i < na && j < nb) {                                                                  \
+        const T x = a[i], y = b[j];                                                             \
+        out[k] = x;                                                                             \
+        k += (x <= y) & ((x == y) == keep);                                                     \
+        i += x <= y;                                                                            \
+        j += y < x;                                                                             \
+    }                                                                                           \
+    if (!keep) {                                                                                \
+        memcpy(out + k, a + i, (na - i) * sizeof(T));                                           \
+        k += na - i;                                                                            \
+    }                                                                                           \
+    return k;                                                                                   \
+}                                                                                               \
+                                                                                                \
+static size_t merge_##NAME(const T *a, size_t na, const T *b, size_t nb, T *out) {              \
+    size_t i = 0, j = 0, k = 0;                                                                 \
+    MERGE_SIMD((const U *) a, na, (const U *) b, nb, (U *) out, SIGN, &i, &j, &k);              \
+    if (k < i + j) {                                                                            \
+        /* Give the pending elements back: the first k read ones end at a[x - 1] and b[k - x - 1] \
+           for the x where neither is past the next element of the other input. */              \
+        size_t x = k > j ? k - j : 0;                                                           \
+        while (x < i && k - x > 0 && !(b[k - x - 1] <= a[x])) x++;                              \
+        j = k - x;                                                                              \
+        i = x;                                                                                  \
+    }                                                                                           \
+    while (i < na && j < nb) {                                                                  \
+        const T x = a[i], y = b[j];                                                             \
+        const bool take_b = y < x;                                                              \
+        out[k++] = take_b ? y : x;                                                              \
+        i += !take_b;                                                                           \
+        j += take_b;                                                                            \
+    }                                                                                           \
+    memcpy(out + k, a + i, (na - i) * sizeof(T));                                               \
+    k += na - i;                                                                                \
+    memmove(out + k, b + j, (nb - j) * sizeof(T));                                              \
+    return k + nb - j;                                                                          \
+}
+
+#if CDS_SORT_SET_X86
+static void filter_32_simd(const uint32_t *a, size_t na, const uint32_t *b, size_t nb, uint32_t *out,
+                           bool keep, uint32_t sign, size_t *pi, size_t *pj, size_t *pk) {
+    if (__builtin_cpu_supports("ssse3")) filter_32_ssse3(a, na, b, nb, out, keep, sign, pi, pj, pk);
+}
+
+static void filter_64_simd(const uint64_t *a, size_t na, const uint64_t *b, size_t nb, uint64_t *out,
+                           bool keep, uint64_t sign, size_t *pi, size_t *pj, size_t *pk) {
+    if (__builtin_cpu_supports("avx2")) filter_64_avx2(a, na, b, nb, out, keep, sign, pi, pj, pk);
+}
+
+static void merge_32_simd(const uint32_t *a, size_t na, const uint32_t *b, size_t nb, uint32_t *out,
+                          uint32_t sign, size_t *pi, size_t *pj, size_t *pk) {
+    if (__builtin_cpu_supports("avx2")) merge_32_avx2(a, na, b, nb, out, sign, pi, pj, pk);
+}
+#else
+#define filter_32_simd(...) ((void) 0)
+#define filter_64_simd(...) ((void) 0)
+#define merge_32_simd(...) ((void) 0)
+#endif
+
+// A bitonic merge of 64-bit keys is no faster than the scalar loop: four lanes per vector leave
+// too little work per step to hide the network's latency.
+#define merge_64_simd(...) ((void) 0)
+
+DEFINE_SET_TYPED(int32_t, uint32_t, int32_t, i32, 0, filter_32_simd, merge_32_simd)
+DEFINE_SET_TYPED(uint32_t, uint32_t, int32_t, u32, UINT32_C(0x80000000), filter_32_simd, merge_32_simd)
+DEFINE_SET_TYPED(int64_t, uint64_t, int64_t, i64, 0, filter_64_simd, merge_64_simd)
+DEFINE_SET_TYPED(uint64_t, uint64_t, int64_t, u64, UINT64_C(0x8000000000000000), filter_64_simd,
+                 merge_64_simd)
+
+/*
+ * Union writes the elements of b that are not in a behind the room for a, then merges a with them
+ * into the front of out.
+ */
+#define RUN_TYPED(T, NAME, op, a, na, b, nb, out) do {                                          \
+    const T *a_ = (const T *) (a), *b_ = (const T *) (b);                                       \
+    T *out_ = (T *) (out);                                                                      \
+    switch (op) {                                                                               \
+        case SET_MERGE: return merge_##NAME(a_, na, b_, nb, out_);                              \
+        case SET_UNION: return merge_##NAME(a_, na, out_ + (na),                                \
+                                            filter_##NAME(b_, nb, a_, na, out_ + (na), false), out_); \
+        case SET_INTERSECT: return filter_##NAME(a_, na, b_, nb, out_, true);                   \
+        case SET_DIFFERENCE: return filter_##NAME(a_, na, b_, nb, out_, false);                 \
+    }                                                                                           \
+    return 0;                                                                                   \
+} while (0)
+
+// Returns the size of the result, or SIZE_MAX if cmp has no typed version for the element size.
+static size_t linear_typed(enum set_op op, const char *a, size_t na, const char *b, size_t nb, size_t es,
+                           cds_cmp_func cmp, char *out) {
+    if (cmp == cds_cmp_i32 && es == sizeof(int32_t)) RUN_TYPED(int32_t, i32, op, a, na, b, nb, out);
+    if (cmp == cds_cmp_u32 && es == sizeof(uint32_t)) RUN_TYPED(uint32_t, u32, op, a, na, b, nb, out);
+    if (cmp == cds_cmp_i64 && es == sizeof(int64_t)) RUN_TYPED(int64_t, i64, op, a, na, b, nb, out);
+    if (cmp == cds_cmp_u64 && es == sizeof(uint64_t)) RUN_TYPED(uint64_t, u64, op, a, na, b, nb, out);
+    return SIZE_MAX;
+}
+
+static int set_operation(enum set_op op, const struct cds_array *a, const struct cds_array *b,
+                         cds_cmp_func cmp, struct cds_array *out) {
+    if (!a || !b || !cmp || !out || out == a || out == b || a->element_size != b->element_size ||
+        out->element_size != a->element_size) {
+        return -1;
+    }
+    const size_t na = a->size, nb = b->size, es = a->element_size;
+    const size_t capacity = op == SET_MERGE || op == SET_UNION ? na + nb : na;
+    if (cds_array_reserve(out, capacity > 0 ? capacity : 1) != 0) return -1;
+
+    struct set_output result = {.data = out->data, .size = 0, .es = es};
+    if (na > 0 && nb / na >= SET_GALLOP_RATIO) {
+        gallop_long_b(op, a->data, na, b->data, nb, es, cmp, &result);
+    } else if (nb > 0 && na / nb >= SET_GALLOP_RATIO) {
+        gallop_long_a(op, a->data, na, b->data, nb, es, cmp, &result);
+    } else if ((result.size = linear_typed(op, a->data, na, b->data, nb, es, cmp, out->data)) == SIZE_MAX) {
+        result.size = 0;
+        linear_generic(op, a->data, na, b->data, nb, es, cmp, &result);
+    }
+    out->size = result.size;
+    return 0;
+}
+
+int cds_array_set_merge(const struct cds_array *a, const struct cds_array *b, cds_cmp_func cmp,
+                        struct cds_array *out) {
+    return set_operation(SET_MERGE, a, b, cmp, out);
+}
+
+int cds_array_set_union(const struct cds_array *a, const struct cds_array *b, cds_cmp_func cmp,
+                        struct cds_array *out) {
+    return set_operation(SET_UNION, a, b, cmp, out);
+}
+
+int cds_array_set_intersect(const struct cds_array *a, const struct cds_array *b, cds_cmp_func cmp,
+                            struct cds_array *out) {
+    return set_operation(SET_INTERSECT, a, b, cmp, out);
+}
+
+int cds_array_set_difference(const struct cds_array *a, const struct cds_array *b, cds_cmp_func cmp,
+                             struct cds_array *out) {
+    return set_operation(SET_DIFFERENCE, a, b, cmp, out);
+}
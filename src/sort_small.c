@@ -0,0 +1,479 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "cds/sort.h"
+
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(CDS_SORT_SMALL_NO_SIMD)
+#define CDS_SORT_SMALL_X86 1
+#include <immintrin.h>
+#else
+#define CDS_SORT_SMALL_X86 0
+#endif
+
+/*
+ * All kernels run the same bitonic network on the smallest power-of-two number of elements that
+ * holds n and fills whole vectors, with the missing elements set to the largest key. Floats and
+ * doubles are mapped to integers with the same order (see float_key), so only integer kernels are
+ * needed. The SIMD kernels load, pad and store partial vectors directly from the caller's array:
+ * staging the data through a stack buffer costs a store-forwarding stall per vector.
+ *
+ * In stage (k, j) element i is compared with element i ^ j, and keeps the larger of the two when
+ * bit j of i differs from bit k of i (the block of size k it belongs to is sorted descending).
+ */
+#define TAKE_MAX(i, k, j) ((((i) & (j)) != 0) != (((i) & (k)) != 0))
+#define LANE_MASK4(base, k, j) \
+    (TAKE_MAX((base) + 0, k, j) | TAKE_MAX((base) + 1, k, j) << 1 | \
+     TAKE_MAX((base) + 2, k, j) << 2 | TAKE_MAX((base) + 3, k, j) << 3)
+// Blend mask for lanes base .. base + 7; lanes past the vector width are ignored by the kernels.
+#define LANE_MASK(base, k, j) (LANE_MASK4(base, k, j) | LANE_MASK4((base) + 4, k, j) << 4)
+
+// Scalar compare-exchanges select with a mask instead of branching; a constant LOG_K lets the
+// loops unroll fully.
+#define SCALAR_NETWORK(T, buf, LOG_K) do {                                             \
+    _Pragma("GCC unroll 4")                                                             \
+    for (int ks_ = 1; ks_ <= (LOG_K); ks_++) {                                          \
+        _Pragma("GCC unroll 4")                                                         \
+        for (int js_ = ks_ - 1; js_ >= 0; js_--) {                                      \
+            const size_t k_ = (size_t) 1 << ks_, j_ = (size_t) 1 << js_;                \
+            _Pragma("GCC unroll 16")                                                    \
+            for (size_t i_ = 0; i_ < ((size_t) 1 << (LOG_K)); i_++) {                   \
+                const size_t p_ = i_ ^ j_;                                              \
+                if (p_ < i_) continue;                                                  \
+                const T a_ = (buf)[i_], b_ = (buf)[p_];                                 \
+                const T mask_ = -(T) (a_ < b_);                                         \
+                const T lo_ = b_ ^ ((a_ ^ b_) & mask_), hi_ = a_ ^ b_ ^ lo_;             \
+                const bool desc_ = (i_ & k_) != 0;                                      \
+                (buf)[i_] = desc_ ? hi_ : lo_;                                          \
+                (buf)[p_] = desc_ ? lo_ : hi_;                                          \
+            }                                                                           \
+        }                                                                               \
+    }                                                                                   \
+} while (0)
+
+// Maps the bits of an IEEE float to a signed integer with the same order: negative values have
+// their magnitude bits flipped. The mapping is its own inverse.
+static inline int32_t float_key(uint32_t bits) {
+    return (int32_t) (bits ^ ((bits >> 31) ? UINT32_C(0x7FFFFFFF) : 0));
+}
+
+static inline int64_t double_key(uint64_t bits) {
+    return (int64_t) (bits ^ ((bits >> 63) ? UINT64_C(0x7FFFFFFFFFFFFFFF) : 0));
+}
+
+static void bitonic_i32_scalar(void *data, size_t n, bool float_keys) {
+    int32_t buf[CDS_SORT_SMALL_MAX];
+    for (size_t i = 0; i < n; i++) {
+        uint32_t bits;
+        memcpy(&bits, (char *) data + i * sizeof(bits), sizeof(bits));
+        buf[i] = float_keys ? float_key(bits) : (int32_t) bits;
+    }
+    for (size_t i = n; i < CDS_SORT_SMALL_MAX; i++) buf[i] = INT32_MAX;
+    if (n <= 4) {
+        SCALAR_NETWORK(int32_t, buf, 2);
+    } else if (n <= 8) {
+        SCALAR_NETWORK(int32_t, buf, 3);
+    } else {
+        SCALAR_NETWORK(int32_t, buf, 4);
+    }
+    for (size_t i = 0; i < n; i++) {
+        const int32_t key = float_keys ? float_key((uint32_t) buf[i]) : buf[i];
+        memcpy((char *) data + i * sizeof(key), &key, sizeof(key));
+    }
+}
+
+static void bitonic_i64_scalar(void *data, size_t n, bool float_keys) {
+    int64_t buf[CDS_SORT_SMALL_MAX];
+    for (size_t i = 0; i < n; i++) {
+        uint64_t bits;
+        memcpy(&bits, (char *) data + i * sizeof(bits), sizeof(bits));
+        buf[i] = float_keys ? double_key(bits) : (int64_t) bits;
+    }
+    for (size_t i = n; i < CDS_SORT_SMALL_MAX; i++) buf[i] = INT64_MAX;
+    if (n <= 4) {
+        SCALAR_NETWORK(int64_t, buf, 2);
+    } else if (n <= 8) {
+        SCALAR_NETWORK(int64_t, buf, 3);
+    } else {
+        SCALAR_NETWORK(int64_t, buf, 4);
+    }
+    for (size_t i = 0; i < n; i++) {
+        const int64_t key = float_keys ? double_key((uint64_t) buf[i]) : buf[i];
+        memcpy((char *) data + i * sizeof(key), &key, sizeof(key));
+    }
+}
+
+#if CDS_SORT_SMALL_X86
+
+/*
+ * BITONIC_BODY expands to a kernel over VEC_ registers of W_ lanes of type T_. Before expanding it,
+ * define:
+ *   LOAD_(p), STORE_(p, v)           unaligned load and store of a full vector
+ *   LOAD_N_(p, c), STORE_N_(p, v, c) the same for the first 0 < c < W_ lanes, padding with SENTINEL_
+ *   SENTINEL_                        a vector of the largest key
+ *   FLIP_(v)                         float_key or double_key on every lane
+ *   MINMAX_(a, b, mn, mx)            lane-wise minimum and maximum
+ *   PERM_1 .. PERM_8(v)              swap lanes i and i ^ j inside a register (unused for j >= W_)
+ *   BLEND_(mn, mx, mask)             lane i from mx if bit i of the immediate mask is set, else mn
+ * Stages with j < W_ permute inside each register; the others compare whole registers.
+ */
+#define BITONIC_STAGE(k, j) do {                                                        \
+    if ((j) < W_) {                                                                     \
+        for (size_t r_ = 0; r_ < regs; r_++) {                                          \
+            VEC_ p_ = PERM_##j(v[r_]), mn_, mx_;                                        \
+            MINMAX_(v[r_], p_, mn_, mx_);                                               \
+            if (((r_ * W_) & (k)) == 0) {                                               \
+                v[r_] = BLEND_(mn_, mx_, LANE_MASK(0, k, j));                           \
+            } else {                                                                    \
+                v[r_] = BLEND_(mn_, mx_, LANE_MASK(k, k, j));                           \
+            }                                                                           \
+        }                                                                               \
+    } else {                                                                            \
+        for (size_t r_ = 0; r_ < regs; r_++) {                                          \
+            const size_t q_ = r_ + (j) / W_;                                            \
+            if ((r_ & ((j) / W_)) != 0) continue;                                       \
+            VEC_ mn_, mx_;                                                              \
+            MINMAX_(v[r_], v[q_], mn_, mx_);                                            \
+            const bool desc_ = ((r_ * W_) & (k)) != 0;                                  \
+            v[r_] = desc_ ? mx_ : mn_;                                                  \
+            v[q_] = desc_ ? mn_ : mx_;                                                  \
+        }                                                                               \
+    }                                                                                   \
+} while (0)
+
+// Sorts data[0, n) with a network of SIZE elements, a constant so that the register loops unroll.
+#define BITONIC_NETWORK(data, n, float_keys, SIZE) do {                                 \
+    const size_t regs = (SIZE) / W_;                                                    \
+    T_ *p = (T_ *) (data);                                                              \
+    VEC_ v[16 / W_];                                                                    \
+    for (size_t r = 0; r < regs; r++) {                                                 \
+        const int count = (int) (n) - (int) (r * W_);                                   \
+        v[r] = count >= W_ ? LOAD_(p + r * W_) : count > 0 ? LOAD_N_(p + r * W_, count) \
+                                                           : SENTINEL_;                 \
+        if (float_keys) v[r] = FLIP_(v[r]);                                             \
+    }                                                                                   \
+    BITONIC_STAGE(2, 1);                                                                \
+    if ((SIZE) >= 4) { BITONIC_STAGE(4, 2); BITONIC_STAGE(4, 1); }                      \
+    if ((SIZE) >= 8) { BITONIC_STAGE(8, 4); BITONIC_STAGE(8, 2); BITONIC_STAGE(8, 1); } \
+    if ((SIZE) >= 16) {                                                                 \
+        BITONIC_STAGE(16, 8); BITONIC_STAGE(16, 4);                                     \
+        BITONIC_STAGE(16, 2); BITONIC_STAGE(16, 1);                                     \
+    }                                                                                   \
+    for (size_t r = 0; r < regs; r++) {                                                 \
+        const int count = (int) (n) - (int) (r * W_);                                   \
+        if (float_keys) v[r] = FLIP_(v[r]);                                             \
+        if (count >= W_) {                                                              \
+            STORE_(p + r * W_, v[r]);                                                   \
+        } else if (count > 0) {                                                         \
+            STORE_N_(p + r * W_, v[r], count);                                          \
+        }                                                                               \
+    }                                                                                   \
+} while (0)
+
+#define BITONIC_BODY(data, n, float_keys) do {                                          \
+    if (W_ <= 4 && (n) <= 4) {                                                          \
+        BITONIC_NETWORK(data, n, float_keys, 4);                                        \
+    } else if (W_ <= 8 && (n) <= 8) {                                                   \
+        BITONIC_NETWORK(data, n, float_keys, 8);                                        \
+    } else {                                                                            \
+        BITONIC_NETWORK(data, n, float_keys, 16);                                       \
+    }                                                                                   \
+} while (0)
+
+// Spread a 4-lane mask over the 8 control bits of a 32-bit blend.
+#define WIDEN4(m) ((((m) & 1) ? 0x03 : 0) | (((m) & 2) ? 0x0C : 0) | (((m) & 4) ? 0x30 : 0) | \
+                   (((m) & 8) ? 0xC0 : 0))
+
+__attribute__((target("avx2")))
+static inline __m256i avx2_i32_lane_mask(int count) {
+    return _mm256_cmpgt_epi32(_mm256_set1_epi32(count), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+}
+
+__attribute__((target("avx2")))
+static inline __m256i avx2_i64_lane_mask(int count) {
+    return _mm256_cmpgt_epi64(_mm256_set1_epi64x(count), _mm256_setr_epi64x(0, 1, 2, 3));
+}
+
+// AVX2, 8 x int32
+#define T_ int32_t
+#define VEC_ __m256i
+#define W_ 8
+#define LOAD_(p) _mm256_loadu_si256((const __m256i *) (p))
+#define STORE_(p, x) _mm256_storeu_si256((__m256i *) (p), x)
+#define LOAD_N_(p, c) _mm256_blendv_epi8(SENTINEL_, \
+    _mm256_maskload_epi32((const int *) (p), avx2_i32_lane_mask(c)), avx2_i32_lane_mask(c))
+#define STORE_N_(p, x, c) _mm256_maskstore_epi32((int *) (p), avx2_i32_lane_mask(c), x)
+#define SENTINEL_ _mm256_set1_epi32(INT32_MAX)
+#define FLIP_(x) _mm256_xor_si256(x, _mm256_and_si256(_mm256_srai_epi32(x, 31), SENTINEL_))
+#define MINMAX_(a, b, mn, mx) do { mn = _mm256_min_epi32(a, b); mx = _mm256_max_epi32(a, b); } while (0)
+#define PERM_1(x) _mm256_shuffle_epi32(x, 0xB1)
+#define PERM_2(x) _mm256_shuffle_epi32(x, 0x4E)
+#define PERM_4(x) _mm256_permute2x128_si256(x, x, 0x01)
+#define PERM_8(x) (x)
+#define BLEND_(mn, mx, m) _mm256_blend_epi32(mn, mx, (m) & 0xFF)
+__attribute__((target("avx2")))
+static void bitonic_i32_avx2(void *data, size_t n, bool float_keys) {
+    BITONIC_BODY(data, n, float_keys);
+}
+#undef T_
+#undef VEC_
+#undef W_
+#undef LOAD_
+#undef STORE_
+#undef LOAD_N_
+#undef STORE_N_
+#undef SENTINEL_
+#undef FLIP_
+#undef MINMAX_
+#undef PERM_1
+#undef PERM_2
+#undef PERM_4
+#undef PERM_8
+#undef BLEND_
+
+// AVX2, 4 x int64
+#define T_ int64_t
+#define VEC_ __m256i
+#define W_ 4
+#define LOAD_(p) _mm256_loadu_si256((const __m256i *) (p))
+#define STORE_(p, x) _mm256_storeu_si256((__m256i *) (p), x)
+#define LOAD_N_(p, c) _mm256_blendv_epi8(SENTINEL_, \
+    _mm256_maskload_epi64((const long long *) (p), avx2_i64_lane_mask(c)), avx2_i64_lane_mask(c))
+#define STORE_N_(p, x, c) _mm256_maskstore_epi64((long long *) (p), avx2_i64_lane_mask(c), x)
+#define SENTINEL_ _mm256_set1_epi64x(INT64_MAX)
+#define FLIP_(x) _mm256_xor_si256(x, _mm256_and_si256(_mm256_cmpgt_epi64(_mm256_setzero_si256(), x), \
+                                                      SENTINEL_))
+#define MINMAX_(a, b, mn, mx) do {                                                      \
+    __m256i gt_ = _mm256_cmpgt_epi64(a, b);                                             \
+    mn = _mm256_blendv_epi8(a, b, gt_);                                                 \
+    mx = _mm256_blendv_epi8(b, a, gt_);                                                 \
+} while (0)
+#define PERM_1(x) _mm256_shuffle_epi32(x, 0x4E)
+#define PERM_2(x) _mm256_permute4x64_epi64(x, 0x4E)
+#define PERM_4(x) (x)
+#define PERM_8(x) (x)
+#define BLEND_(mn, mx, m) _mm256_blend_epi32(mn, mx, WIDEN4((m) & 0xF))
+__attribute__((target("avx2")))
+static void bitonic_i64_avx2(void *data, size_t n, bool float_keys) {
+    BITONIC_BODY(data, n, float_keys);
+}
+#undef T_
+#undef VEC_
+#undef W_
+#undef LOAD_
+#undef STORE_
+#undef LOAD_N_
+#undef STORE_N_
+#undef SENTINEL_
+#undef FLIP_
+#undef MINMAX_
+#undef PERM_1
+#undef PERM_2
+#undef PERM_4
+#undef PERM_8
+#undef BLEND_
+
+__attribute__((target("sse4.1")))
+static inline __m128i sse41_i32_load_n(const int32_t *p, int count) {
+    int32_t x;
+    __m128i v = _mm_set1_epi32(INT32_MAX);
+    memcpy(&x, p, sizeof(x));
+    v = _mm_insert_epi32(v, x, 0);
+    if (count > 1) {
+        memcpy(&x, p + 1, sizeof(x));
+        v = _mm_insert_epi32(v, x, 1);
+    }
+    if (count > 2) {
+        memcpy(&x, p + 2, sizeof(x));
+        v = _mm_insert_epi32(v, x, 2);
+    }
+    return v;
+}
+
+__attribute__((target("sse4.1")))
+static inline void sse41_i32_store_n(int32_t *p, __m128i v, int count) {
+    int32_t x = _mm_extract_epi32(v, 0);
+    memcpy(p, &x, sizeof(x));
+    if (count > 1) {
+        x = _mm_extract_epi32(v, 1);
+        memcpy(p + 1, &x, sizeof(x));
+    }
+    if (count > 2) {
+        x = _mm_extract_epi32(v, 2);
+        memcpy(p + 2, &x, sizeof(x));
+    }
+}
+
+// SSE4.1, 4 x int32
+#define T_ int32_t
+#define VEC_ __m128i
+#define W_ 4
+#define LOAD_(p) _mm_loadu_si128((const __m128i *) (p))
+#define STORE_(p, x) _mm_storeu_si128((__m128i *) (p), x)
+#define LOAD_N_(p, c) sse41_i32_load_n(p, c)
+#define STORE_N_(p, x, c) sse41_i32_store_n(p, x, c)
+#define SENTINEL_ _mm_set1_epi32(INT32_MAX)
+#define FLIP_(x) _mm_xor_si128(x, _mm_and_si128(_mm_srai_epi32(x, 31), SENTINEL_))
+#define MINMAX_(a, b, mn, mx) do { mn = _mm_min_epi32(a, b); mx = _mm_max_epi32(a, b); } while (0)
+#define PERM_1(x) _mm_shuffle_epi32(x, 0xB1)
+#define PERM_2(x) _mm_shuffle_epi32(x, 0x4E)
+#define PERM_4(x) (x)
+#define PERM_8(x) (x)
+#define BLEND_(mn, mx, m) \
+    _mm_castps_si128(_mm_blend_ps(_mm_castsi128_ps(mn), _mm_castsi128_ps(mx), (m) & 0xF))
+__attribute__((target("sse4.1")))
+static void bitonic_i32_sse41(void *data, size_t n, bool float_keys) {
+    BITONIC_BODY(data, n, float_keys);
+}
+#undef T_
+#undef VEC_
+#undef W_
+#undef LOAD_
+#undef STORE_
+#undef LOAD_N_
+#undef STORE_N_
+#undef SENTINEL_
+#undef FLIP_
+#undef MINMAX_
+#undef PERM_1
+#undef PERM_2
+#undef PERM_4
+#undef PERM_8
+#undef BLEND_
+
+// SSE4.2 (for pcmpgtq), 2 x int64. A partial vector is always a single element.
+#define T_ int64_t
+#define VEC_ __m128i
+#define W_ 2
+#define LOAD_(p) _mm_loadu_si128((const __m128i *) (p))
+#define STORE_(p, x) _mm_storeu_si128((__m128i *) (p), x)
+#define LOAD_N_(p, c) _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *) (p)), SENTINEL_)
+#define STORE_N_(p, x, c) _mm_storel_epi64((__m128i *) (p), x)
+#define SENTINEL_ _mm_set1_epi64x(INT64_MAX)
+#define FLIP_(x) _mm_xor_si128(x, _mm_and_si128(_mm_cmpgt_epi64(_mm_setzero_si128(), x), SENTINEL_))
+#define MINMAX_(a, b, mn, mx) do {                                                      \
+    __m128i gt_ = _mm_cmpgt_epi64(a, b);                                                \
+    mn = _mm_blendv_epi8(a, b, gt_);                                                    \
+    mx = _mm_blendv_epi8(b, a, gt_);                                                    \
+} while (0)
+#define PERM_1(x) _mm_shuffle_epi32(x, 0x4E)
+#define PERM_2(x) (x)
+#define PERM_4(x) (x)
+#define PERM_8(x) (x)
+#define BLEND_(mn, mx, m) \
+    _mm_castpd_si128(_mm_blend_pd(_mm_castsi128_pd(mn), _mm_castsi128_pd(mx), (m) & 0x3))
+__attribute__((target("sse4.2")))
+static void bitonic_i64_sse42(void *data, size_t n, bool float_keys) {
+    BITONIC_BODY(data, n, float_keys);
+}
+#undef T_
+#undef VEC_
+#undef W_
+#undef LOAD_
+#undef STORE_
+#undef LOAD_N_
+#undef STORE_N_
+#undef SENTINEL_
+#undef FLIP_
+#undef MINMAX_
+#undef PERM_1
+#undef PERM_2
+#undef PERM_4
+#undef PERM_8
+#undef BLEND_
+
+#endif  // CDS_SORT_SMALL_X86
+
+// The CPU features are read with cpuid once by libgcc, so each check is a load and a test.
+static void sort_network_i32(void *data, size_t n, bool float_keys) {
+#if CDS_SORT_SMALL_X86
+    if (__builtin_cpu_supports("avx2")) {
+        bitonic_i32_avx2(data, n, float_keys);
+        return;
+    }
+    if (__builtin_cpu_supports("sse4.1")) {
+        bitonic_i32_sse41(data, n, float_keys);
+        return;
+    }
+#endif
+    bitonic_i32_scalar(data, n, float_keys);
+}
+
+static void sort_network_i64(void *data, size_t n, bool float_keys) {
+#if CDS_SORT_SMALL_X86
+    if (__builtin_cpu_supports("avx2")) {
+        bitonic_i64_avx2(data, n, float_keys);
+        return;
+    }
+    if (__builtin_cpu_supports("sse4.2")) {
+        bitonic_i64_sse42(data, n, float_keys);
+        return;
+    }
+#endif
+    bitonic_i64_scalar(data, n, float_keys);
+}
+
+int cds_sort_small_i32(int32_t *data, size_t n) {
+    if (n > CDS_SORT_SMALL_MAX || (!data && n > 0)) return -1;
+    if (n > 1) sort_network_i32(data, n, false);
+    return 0;
+}
+
+int cds_sort_small_i64(int64_t *data, size_t n) {
+    if (n > CDS_SORT_SMALL_MAX || (!data && n > 0)) return -1;
+    if (n > 1) sort_network_i64(data, n, false);
+    return 0;
+}
+
+int cds_sort_small_f32(float *data, size_t n) {
+    if (n > CDS_SORT_SMALL_MAX || (!data && n > 0)) return -1;
+    if (n > 1) sort_network_i32(data, n, true);
+    return 0;
+}
+
+int cds_sort_small_f64(double *data, size_t n) {
+    if (n > CDS_SORT_SMALL_MAX || (!data && n > 0)) return -1;
+    if (n > 1) sort_network_i64(data, n, true);
+    return 0;
+}
+
+int cds_cmp_i32(const void *a, const void *b) {
+    int32_t x, y;
+    memcpy(&x, a, sizeof(x));
+    memcpy(&y, b, sizeof(y));
+    return (x > y) - (x < y);
+}
+
+int cds_cmp_i64(const void *a, const void *b) {
+    int64_t x, y;
+    memcpy(&x, a, sizeof(x));
+    memcpy(&y, b, sizeof(y));
+    return (x > y) - (x < y);
+}
+
+int cds_cmp_u32(const void *a, const void *b) {
+    uint32_t x, y;
+    memcpy(&x, a, sizeof(x));
+    memcpy(&y, b, sizeof(y));
+    return (x > y) - (x < y);
+}
+
+int cds_cmp_u64(const void *a, const void *b) {
+    uint64_t x, y;
+    memcpy(&x, a, sizeof(x));
+    memcpy(&y, b, sizeof(y));
+    return (x > y) - (x < y);
+}
+
+int cds_cmp_f32(const void *a, const void *b) {
+    uint32_t x, y;
+    memcpy(&x, a, sizeof(x));
+    memcpy(&y, b, sizeof(y));
+    return (float_key(x) > float_key(y)) - (float_key(x) < float_key(y));
+}
+
+int cds_cmp_f64(const void *a, const void *b) {
+    uint64_t x, y;
+    memcpy(&x, a, sizeof(x));
+    memcpy(&y, b, sizeof(y));
+    return (double_key(x) > double_key(y)) - (double_key(x) < double_key(y));
+}
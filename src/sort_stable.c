@@ -0,0 +1,431 @@
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cds/sort.h"
+#include "cds/array.h"
+
+// Runs shorter than this are extended with binary insertion sort before they are merged.
+#define TIMSORT_MIN_MERGE 32
+// Consecutive wins by one side of a merge before switching to galloping.
+#define TIMSORT_MIN_GALLOP 7
+// Run lengths on the stack grow at least as fast as Fibonacci numbers, so 85 covers any size_t.
+#define TIMSORT_MAX_RUNS 85
+
+struct timsort_run {
+    size_t base;
+    size_t len;
+};
+
+struct timsort_state {
+    char *data;
+    size_t size;
+    size_t element_size;
+    cds_cmp_func cmp;
+    char *tmp;  // n / 2 + 1 elements, allocated on first use
+    size_t min_gallop;
+    struct timsort_run runs[TIMSORT_MAX_RUNS];
+    size_t run_count;
+};
+
+static int timsort_tmp(struct timsort_state *ts) {
+    if (ts->tmp == NULL) {
+        ts->tmp = malloc((ts->size / 2 + 1) * ts->element_size);
+    }
+    return ts->tmp == NULL ? -1 : 0;
+}
+
+static void reverse_range(char *lo, char *hi, size_t element_size) {
+    hi -= element_size;
+    while (lo < hi) {
+        for (size_t b = 0; b < element_size; b++) {
+            char c = lo[b];
+            lo[b] = hi[b];
+            hi[b] = c;
+        }
+        lo += element_size;
+        hi -= element_size;
+    }
+}
+
+static size_t min_run_length(size_t n) {
+    size_t r = 0;
+    while (n >= TIMSORT_MIN_MERGE) {
+        r |= n & 1;
+        n >>= 1;
+    }
+    return n + r;
+}
+
+// Length of the run starting at lo; a strictly descending run is reversed in place.
+static size_t count_run(struct timsort_state *ts, size_t lo, size_t hi) {
+    const size_t es = ts->element_size;
+    char *a = ts->data;
+    size_t run_hi = lo + 1;
+    if (run_hi == hi) return 1;
+
+    if (ts->cmp(a + run_hi * es, a + lo * es) < 0) {
+        run_hi++;
+        while (run_hi < hi && ts->cmp(a + run_hi * es, a + (run_hi - 1) * es) < 0) run_hi++;
+        reverse_range(a + lo * es, a + run_hi * es, es);
+    } else {
+        run_hi++;
+        while (run_hi < hi && ts->cmp(a + run_hi * es, a + (run_hi - 1) * es) >= 0) run_hi++;
+    }
+    return run_hi - lo;
+}
+
+// Sorts [lo, hi) given that [lo, start) is already sorted.
+static void binary_insertion_sort(struct timsort_state *ts, size_t lo, size_t hi, size_t start) {
+    const size_t es = ts->element_size;
+    char *a = ts->data, *pivot = ts->tmp;
+    for (; start < hi; start++) {
+        memcpy(pivot, a + start * es, es);
+        size_t left = lo, right = start;
+        while (left < right) {
+            size_t mid = left + (right - left) / 2;
+            if (ts->cmp(pivot, a + mid * es) < 0) {
+                right = mid;
+            } else {
+                left = mid + 1;
+            }
+        }
+        memmove(a + (left + 1) * es, a + left * es, (start - left) * es);
+        memcpy(a + left * es, pivot, es);
+    }
+}
+
+// Leftmost position in base[0, len) at which key can be inserted, searching outwards from hint.
+static size_t gallop_left(const struct timsort_state *ts, const char *key, const char *base, size_t len,
+                          size_t hint) {
+    const size_t es = ts->element_size;
+    ptrdiff_t last_ofs = 0, ofs = 1;
+    if (ts->cmp(key, base + hint * es) > 0) {
+        const ptrdiff_t max_ofs = (ptrdiff_t) (len - hint);
+        while (ofs < max_ofs && ts->cmp(key, base + (hint + ofs) * es) > 0) {
+            last_ofs = ofs;
+            ofs = (ofs << 1) + 1;
+        }
+        if (ofs > max_ofs) ofs = max_ofs;
+        last_ofs += hint;
+        ofs += hint;
+    } else {
+        const ptrdiff_t max_ofs = (ptrdiff_t) hint + 1;
+        while (ofs < max_ofs && ts->cmp(key, base + (hint - ofs) * es) <= 0) {
+            last_ofs = ofs;
+            ofs = (ofs << 1) + 1;
+        }
+        if (ofs > max_ofs) ofs = max_ofs;
+        ptrdiff_t tp = last_ofs;
+        last_ofs = (ptrdiff_t) hint - ofs;
+        ofs = (ptrdiff_t) hint - tp;
+    }
+    // base[last_ofs] < key <= base[ofs]
+    last_ofs++;
+    while (last_ofs < ofs) {
+        ptrdiff_t mid = last_ofs + ((ofs - last_ofs) >> 1);
+        if (ts->cmp(key, base + mid * es) > 0) {
+            last_ofs = mid + 1;
+        } else {
+            ofs = mid;
+        }
+    }
+    return (size_t) ofs;
+}
+
+// Rightmost position in base[0, len) at which key can be inserted, searching outwards from hint.
+static size_t gallop_right(const struct timsort_state *ts, const char *key, const char *base, size_t len,
+                           size_t hint) {
+    const size_t es = ts->element_size;
+    ptrdiff_t last_ofs = 0, ofs = 1;
+    if (ts->cmp(key, base + hint * es) < 0) {
+        const ptrdiff_t max_ofs = (ptrdiff_t) hint + 1;
+        while (ofs < max_ofs && ts->cmp(key, base + (hint - ofs) * es) < 0) {
+            last_ofs = ofs;
+            ofs = (ofs << 1) + 1;
+        }
+        if (ofs > max_ofs) ofs = max_ofs;
+        ptrdiff_t tp = last_ofs;
+        last_ofs = (ptrdiff_t) hint - ofs;
+        ofs = (ptrdiff_t) hint - tp;
+    } else {
+        const ptrdiff_t max_ofs = (ptrdiff_t) (len - hint);
+        while (ofs < max_ofs && ts->cmp(key, base + (hint + ofs) * es) >= 0) {
+            last_ofs = ofs;
+            ofs = (ofs << 1) + 1;
+        }
+        if (ofs > max_ofs) ofs = max_ofs;
+        last_ofs += hint;
+        ofs += hint;
+    }
+    // base[last_ofs] <= key < base[ofs]
+    last_ofs++;
+    while (last_ofs < ofs) {
+        ptrdiff_t mid = last_ofs + ((ofs - last_ofs) >> 1);
+        if (ts->cmp(key, base + mid * es) < 0) {
+            ofs = mid;
+        } else {
+            last_ofs = mid + 1;
+        }
+    }
+    return (size_t) ofs;
+}
+
+// Merges the adjacent runs [base1, base1 + len1) and [base2, base2 + len2) with len1 <= len2, by
+// copying the first run into tmp and filling from the left. The first element of run 2 sorts before
+// run 1 and the last element of run 1 sorts after run 2.
+static void merge_lo(struct timsort_state *ts, size_t base1, size_t len1, size_t base2, size_t len2) {
+    const size_t es = ts->element_size;
+    char *a = ts->data, *tmp = ts->tmp;
+    memcpy(tmp, a + base1 * es, len1 * es);
+    char *cursor1 = tmp, *cursor2 = a + base2 * es, *dest = a + base1 * es;
+
+    memcpy(dest, cursor2, es);
+    dest += es;
+    cursor2 += es;
+    if (--len2 == 0) {
+        memcpy(dest, cursor1, len1 * es);
+        return;
+    }
+    if (len1 == 1) {
+        memmove(dest, cursor2, len2 * es);
+        memcpy(dest + len2 * es, cursor1, es);
+        return;
+    }
+
+    size_t min_gallop = ts->min_gallop;
+    for (;;) {
+        size_t count1 = 0, count2 = 0;
+        do {
+            if (ts->cmp(cursor2, cursor1) < 0) {
+                memcpy(dest, cursor2, es);
+                dest += es;
+                cursor2 += es;
+                count2++;
+                count1 = 0;
+                if (--len2 == 0) goto done;
+            } else {
+                memcpy(dest, cursor1, es);
+                dest += es;
+                cursor1 += es;
+                count1++;
+                count2 = 0;
+                if (--len1 == 1) goto done;
+            }
+        } while ((count1 | count2) < min_gallop);
+
+        do {
+            count1 = gallop_right(ts, cursor2, cursor1, len1, 0);
+            if (count1 != 0) {
+                memcpy(dest, cursor1, count1 * es);
+                dest += count1 * es;
+                cursor1 += count1 * es;
+                len1 -= count1;
+                if (len1 <= 1) goto done;
+            }
+            memcpy(dest, cursor2, es);
+            dest += es;
+            cursor2 += es;
+            if (--len2 == 0) goto done;
+
+            count2 = gallop_left(ts, cursor1, cursor2, len2, 0);
+            if (count2 != 0) {
+                memmove(dest, cursor2, count2 * es);
+                dest += count2 * es;
+                cursor2 += count2 * es;
+                len2 -= count2;
+                if (len2 == 0) goto done;
+            }
+            memcpy(dest, cursor1, es);
+            dest += es;
+            cursor1 += es;
+            if (--len1 == 1) goto done;
+            if (min_gallop > 0) min_gallop--;
+        } while (count1 >= TIMSORT_MIN_GALLOP || count2 >= TIMSORT_MIN_GALLOP);
+        min_gallop += 2;  // penalize leaving gallop mode
+    }
+
+done:
+    ts->min_gallop = min_gallop < 1 ? 1 : min_gallop;
+    if (len1 == 1) {
+        memmove(dest, cursor2, len2 * es);
+        memcpy(dest + len2 * es, cursor1, es);
+    } else if (len1 > 1) {
+        memcpy(dest, cursor1, len1 * es);
+    }
+    // len1 == 0 only happens with an inconsistent comparison function; every element is still placed.
+}
+
+// Mirror image of merge_lo for len1 >= len2: copies the second run into tmp and fills from the right.
+static void merge_hi(struct timsort_state *ts, size_t base1, size_t len1, size_t base2, size_t len2) {
+    const size_t es = ts->element_size;
+    char *a = ts->data, *tmp = ts->tmp;
+    memcpy(tmp, a + base2 * es, len2 * es);
+    // Cursors point at the last unmerged element of each run; dest at the last unfilled slot.
+    char *cursor1 = a + (base1 + len1 - 1) * es, *cursor2 = tmp + (len2 - 1) * es;
+    char *dest = a + (base2 + len2 - 1) * es;
+
+    memcpy(dest, cursor1, es);
+    dest -= es;
+    cursor1 -= es;
+    if (--len1 == 0) {
+        memcpy(dest - (len2 - 1) * es, tmp, len2 * es);
+        return;
+    }
+    if (len2 == 1) {
+        dest -= len1 * es;
+        cursor1 -= len1 * es;
+        memmove(dest + es, cursor1 + es, len1 * es);
+        memcpy(dest, cursor2, es);
+        return;
+    }
+
+    size_t min_gallop = ts->min_gallop;
+    for (;;) {
+        size_t count1 = 0, count2 = 0;
+        do {
+            if (ts->cmp(cursor2, cursor1) < 0) {
+                memcpy(dest, cursor1, es);
+                dest -= es;
+                cursor1 -= es;
+                count1++;
+                count2 = 0;
+                if (--len1 == 0) goto done;
+            } else {
+                memcpy(dest, cursor2, es);
+                dest -= es;
+                cursor2 -= es;
+                count2++;
+                count1 = 0;
+                if (--len2 == 1) goto done;
+            }
+        } while ((count1 | count2) < min_gallop);
+
+        do {
+            count1 = len1 - gallop_right(ts, cursor2, a + base1 * es, len1, len1 - 1);
+            if (count1 != 0) {
+                dest -= count1 * es;
+                cursor1 -= count1 * es;
+                len1 -= count1;
+                memmove(dest + es, cursor1 + es, count1 * es);
+                if (len1 == 0) goto done;
+            }
+            memcpy(dest, cursor2, es);
+            dest -= es;
+            cursor2 -= es;
+            if (--len2 == 1) goto done;
+
+            count2 = len2 - gallop_left(ts, cursor1, tmp, len2, len2 - 1);
+            if (count2 != 0) {
+                dest -= count2 * es;
+                cursor2 -= count2 * es;
+                len2 -= count2;
+                memcpy(dest + es, cursor2 + es, count2 * es);
+                if (len2 <= 1) goto done;
+            }
+            memcpy(dest, cursor1, es);
+            dest -= es;
+            cursor1 -= es;
+            if (--len1 == 0) goto done;
+            if (min_gallop > 0) min_gallop--;
+        } while (count1 >= TIMSORT_MIN_GALLOP || count2 >= TIMSORT_MIN_GALLOP);
+        min_gallop += 2;
+    }
+
+done:
+    ts->min_gallop = min_gallop < 1 ? 1 : min_gallop;
+    if (len2 == 1) {
+        dest -= len1 * es;
+        cursor1 -= len1 * es;
+        memmove(dest + es, cursor1 + es, len1 * es);
+        memcpy(dest, cursor2, es);
+    } else if (len2 > 1) {
+        memcpy(dest - (len2 - 1) * es, tmp, len2 * es);
+    }
+}
+
+static void merge_at(struct timsort_state *ts, size_t i) {
+    const size_t es = ts->element_size;
+    char *a = ts->data;
+    size_t base1 = ts->runs[i].base, len1 = ts->runs[i].len;
+    size_t base2 = ts->runs[i + 1].base, len2 = ts->runs[i + 1].len;
+
+    ts->runs[i].len = len1 + len2;
+    if (i == ts->run_count - 3) {
+        ts->runs[i + 1] = ts->runs[i + 2];
+    }
+    ts->run_count--;
+
+    // Elements of run 1 already before run 2's head, and of run 2 already after run 1's tail, stay put.
+    size_t k = gallop_right(ts, a + base2 * es, a + base1 * es, len1, 0);
+    base1 += k;
+    len1 -= k;
+    if (len1 == 0) return;
+    len2 = gallop_left(ts, a + (base1 + len1 - 1) * es, a + base2 * es, len2, len2 - 1);
+    if (len2 == 0) return;
+
+    if (len1 <= len2) {
+        merge_lo(ts, base1, len1, base2, len2);
+    } else {
+        merge_hi(ts, base1, len1, base2, len2);
+    }
+}
+
+// Restores the run stack invariants: len[i - 2] > len[i - 1] + len[i] and len[i - 1] > len[i].
+static void merge_collapse(struct timsort_state *ts) {
+    while (ts->run_count > 1) {
+        size_t n = ts->run_count - 2;
+        const struct timsort_run *r = ts->runs;
+        if ((n > 0 && r[n - 1].len <= r[n].len + r[n + 1].len) ||
+            (n > 1 && r[n - 2].len <= r[n - 1].len + r[n].len)) {
+            if (r[n - 1].len < r[n + 1].len) n--;
+        } else if (r[n].len > r[n + 1].len) {
+            break;
+        }
+        merge_at(ts, n);
+    }
+}
+
+static void merge_force_collapse(struct timsort_state *ts) {
+    while (ts->run_count > 1) {
+        size_t n = ts->run_count - 2;
+        if (n > 0 && ts->runs[n - 1].len < ts->runs[n + 1].len) n--;
+        merge_at(ts, n);
+    }
+}
+
+int cds_array_sort_stable(struct cds_array *array, cds_cmp_func cmp) {
+    if (!array || !cmp) return -1;
+    if (array->size < 2) return 0;
+
+    struct timsort_state ts = {
+        .data = array->data,
+        .size = array->size,
+        .element_size = array->element_size,
+        .cmp = cmp,
+        .tmp = NULL,
+        .min_gallop = TIMSORT_MIN_GALLOP,
+        .run_count = 0};
+
+    const size_t n = array->size, min_run = min_run_length(n);
+    size_t lo = 0;
+    while (lo < n) {
+        const size_t remaining = n - lo;
+        size_t run_len = count_run(&ts, lo, n);
+        if (run_len < min_run) {
+            const size_t forced = remaining < min_run ? remaining : min_run;
+            if (timsort_tmp(&ts) != 0) return -1;
+            binary_insertion_sort(&ts, lo, lo + forced, lo + run_len);
+            run_len = forced;
+        }
+
+        ts.runs[ts.run_count++] = (struct timsort_run) {lo, run_len};
+        if (ts.run_count > 1 && timsort_tmp(&ts) != 0) return -1;
+        merge_collapse(&ts);
+        lo += run_len;
+    }
+    merge_force_collapse(&ts);
+
+    free(ts.tmp);
+    return 0;
+}
@@ -5,16 +5,24 @@
 #include "cds/stack.h"
 
 struct cds_stack cds_stack_new(const size_t element_size) {
+  return cds_stack_new_with_allocator(element_size, &cds_default_allocator);
+}
+
+struct cds_stack cds_stack_new_with_allocator(const size_t element_size,
+                                              const struct cds_allocator *allocator) {
   struct cds_stack new_stack = {
-    .data = (char*) malloc(element_size),
+    .data = (char*) cds_allocator_alloc(allocator, element_size),
     .size = 0,
     .capacity = 1,
-    .element_size = element_size};
+    .element_size = element_size,
+    .allocator = allocator};
   return new_stack;
 }
 
 void cds_stack_delete(struct cds_stack *stack) {
-  if (stack->data != NULL) free(stack->data);
+  if (stack->data != NULL) {
+    cds_allocator_free(stack->allocator, stack->data, stack->capacity * stack->element_size);
+  }
   stack->data = NULL;
   stack->size = stack->capacity = 0;
   stack->element_size = 0;
@@ -22,11 +30,13 @@ void cds_stack_delete(struct cds_stack *stack) {
 
 int cds_stack_push(struct cds_stack *stack, const void *new_element) {
   if (stack->size == stack->capacity) {
-    stack->capacity <<= 1;  // cap * 2
-    stack->data = (char*) realloc(stack->data, stack->capacity * stack->element_size);
-    if (stack->data == NULL) {
+    char *new_data = (char*) cds_allocator_realloc(stack->allocator, stack->data,
+      stack->capacity * stack->element_size, (stack->capacity << 1) * stack->element_size);
+    if (new_data == NULL) {
       return -1;
     }
+    stack->data = new_data;
+    stack->capacity <<= 1;  // cap * 2
   }
   memcpy(stack->data + stack->size * stack->element_size, new_element, stack->element_size);
   stack->size++;
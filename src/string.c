@@ -6,19 +6,30 @@
 #include "cds/array.h"
 
 struct cds_string cds_string_new() {
+  return cds_string_new_with_allocator(&cds_default_allocator);
+}
+
+struct cds_string cds_string_new_with_allocator(const struct cds_allocator *allocator) {
   struct cds_string new_string = {
     .opt_data = {0},
     .data = NULL,
     .size = 0,
-    .capacity = CDS_STRING_OPT_CAPACITY
+    .capacity = CDS_STRING_OPT_CAPACITY,
+    .allocator = allocator
   };
   return new_string;
 }
 
 struct cds_string cds_string_from(const char *data, size_t length) {
+  return cds_string_from_with_allocator(data, length, &cds_default_allocator);
+}
+
+struct cds_string cds_string_from_with_allocator(const char *data, size_t length,
+                                                 const struct cds_allocator *allocator) {
   struct cds_string new_string = {0};
+  new_string.allocator = allocator;
   if (length + 1 > CDS_STRING_OPT_CAPACITY) {
-    new_string.data = malloc(length + 1);
+    new_string.data = cds_allocator_alloc(allocator, length + 1);
     memcpy(new_string.data, data, length);
     new_string.data[length] = '\0';
     new_string.size = length;
@@ -34,9 +45,10 @@ struct cds_string cds_string_from(const char *data, size_t length) {
 
 void cds_string_move(struct cds_string *first,  struct cds_string *second) {
   if (first->data != NULL) {
-    free(first->data);
+    cds_allocator_free(first->allocator, first->data, first->capacity);
   }
   first->data = second->data;
+  first->allocator = second->allocator;
   memcpy(first->opt_data, second->opt_data, CDS_STRING_OPT_CAPACITY);
   first->size = second->size;
   first->capacity = second->capacity;
@@ -44,7 +56,7 @@ void cds_string_move(struct cds_string *first,  struct cds_string *second) {
 
 void cds_string_delete(struct cds_string *string) {
   if (string->data != NULL) {
-    free(string->data);
+    cds_allocator_free(string->allocator, string->data, string->capacity);
   }
   memset(string->opt_data, 0, CDS_STRING_OPT_CAPACITY);
   string->size = string->capacity = 0;
@@ -66,7 +78,8 @@ bool cds_string_empty(const struct cds_string *string) {
 }
 
 struct cds_array cds_string_split(const struct cds_string *string, char delimiters[]) {
-  struct cds_array result_strings = cds_array_new(sizeof(struct cds_string));
+  struct cds_array result_strings = cds_array_new_with_allocator(sizeof(struct cds_string),
+                                                                 string->allocator);
   size_t del_len = 0;
   while (delimiters[del_len] != '\0') ++del_len;
   size_t current_start = 0, current_len = 0;
@@ -79,7 +92,8 @@ struct cds_array cds_string_split(const struct cds_string *string, char delimite
       }
     }
     if (is_del) {
-      struct cds_string tp_string = cds_string_from(cds_string_get(string) + current_start, current_len);
+      struct cds_string tp_string = cds_string_from_with_allocator(
+        cds_string_get(string) + current_start, current_len, string->allocator);
       cds_array_push_back(&result_strings, (void*) &tp_string);
       current_start = i + 1;
       current_len = 0;
@@ -88,7 +102,8 @@ struct cds_array cds_string_split(const struct cds_string *string, char delimite
     }
   }
   if (current_len > 0) {
-    struct cds_string tp_string = cds_string_from(cds_string_get(string) + current_start, current_len);
+    struct cds_string tp_string = cds_string_from_with_allocator(
+      cds_string_get(string) + current_start, current_len, string->allocator);
     cds_array_push_back(&result_strings, (void*) &tp_string);
   }
   return result_strings;
@@ -103,7 +118,7 @@ int cds_string_concat(struct cds_string *first, const struct cds_string *second)
       first->size += second->size;
       first->opt_data[first->size] = '\0';
     } else {
-      first->data = malloc(final_capacity);
+      first->data = cds_allocator_alloc(first->allocator, final_capacity);
       if (first->data == NULL) {
         return -1;
       }
@@ -119,7 +134,8 @@ int cds_string_concat(struct cds_string *first, const struct cds_string *second)
       return -1;
     }
     if (final_capacity != first->capacity) {
-      first->data = realloc(first->data, final_capacity);
+      first->data = cds_allocator_realloc(first->allocator, first->data, first->capacity,
+                                          final_capacity);
       if (first->data == NULL) {
         return -1;
       }
@@ -136,14 +152,15 @@ int cds_string_push(struct cds_string *string, char chr) {
   if (string->size + 1 == string->capacity) {
     if (string->capacity == CDS_STRING_OPT_CAPACITY) {
       string->capacity = CDS_STRING_OPT_CAPACITY << 1;
-      string->data = malloc(string->capacity);
+      string->data = cds_allocator_alloc(string->allocator, string->capacity);
       if (string->data == NULL) {
         return -1;
       }
       memmove(string->data, string->opt_data, CDS_STRING_OPT_CAPACITY);
     } else {
+      string->data = cds_allocator_realloc(string->allocator, string->data, string->capacity,
+                                           string->capacity << 1);
       string->capacity <<= 1;
-      string->data = realloc(string->data, string->capacity);
       if (string->data == NULL) {
         return -1;
       }
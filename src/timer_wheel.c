@@ -0,0 +1,200 @@
+#include <string.h>
+
+#include "cds/timer_wheel.h"
+
+#define CDS_TIMER_WHEEL_NIL UINT32_MAX
+#define CDS_TIMER_WHEEL_FREE UINT16_MAX
+
+struct cds_timer_wheel_node {
+  uint64_t expires;           // in ticks
+  uint64_t deadline;
+  void *data;
+  uint32_t next, prev;
+  uint32_t generation;
+  uint16_t slot;              // level * CDS_TIMER_WHEEL_SLOTS + slot, or CDS_TIMER_WHEEL_FREE
+};
+
+static inline struct cds_timer_wheel_node* cds_timer_wheel_node(const struct cds_timer_wheel *wheel,
+                                                                 uint32_t index) {
+  return (struct cds_timer_wheel_node*) wheel->nodes.data + index;
+}
+
+struct cds_timer_wheel cds_timer_wheel_new(uint64_t tick, uint64_t now) {
+  return cds_timer_wheel_new_with_allocator(tick, now, &cds_default_allocator);
+}
+
+struct cds_timer_wheel cds_timer_wheel_new_with_allocator(uint64_t tick, uint64_t now,
+                                                          const struct cds_allocator *allocator) {
+  struct cds_timer_wheel new_wheel = {.tick = tick, .free_head = CDS_TIMER_WHEEL_NIL};
+  if (tick == 0) {
+    return new_wheel;
+  }
+  new_wheel.nodes = cds_array_new_with_allocator(sizeof(struct cds_timer_wheel_node), allocator);
+  memset(new_wheel.slots, 0xFF, sizeof(new_wheel.slots));
+  new_wheel.current = now / tick;
+  return new_wheel;
+}
+
+void cds_timer_wheel_delete(struct cds_timer_wheel *wheel) {
+  cds_array_delete(&wheel->nodes);
+  memset(wheel->occupied, 0, sizeof(wheel->occupied));
+  wheel->free_head = CDS_TIMER_WHEEL_NIL;
+  wheel->size = 0;
+}
+
+// Puts a node into the slot for its expiry relative to current, which it must be later than.
+static void cds_timer_wheel_link(struct cds_timer_wheel *wheel, uint32_t index) {
+  struct cds_timer_wheel_node *node = cds_timer_wheel_node(wheel, index);
+  const unsigned level = (63 - (unsigned) __builtin_clzll(node->expires ^ wheel->current)) / 6;
+  const unsigned digit = (unsigned) (node->expires >> (6 * level)) & (CDS_TIMER_WHEEL_SLOTS - 1);
+  const unsigned slot = level * CDS_TIMER_WHEEL_SLOTS + digit;
+  node->slot = (uint16_t) slot;
+  node->prev = CDS_TIMER_WHEEL_NIL;
+  node->next = wheel->slots[slot];
+  if (node->next != CDS_TIMER_WHEEL_NIL) {
+    cds_timer_wheel_node(wheel, node->next)->prev = index;
+  }
+  wheel->slots[slot] = index;
+  wheel->occupied[level] |= (uint64_t) 1 << digit;
+}
+
+static void cds_timer_wheel_unlink(struct cds_timer_wheel *wheel, uint32_t index) {
+  const struct cds_timer_wheel_node *node = cds_timer_wheel_node(wheel, index);
+  if (node->prev != CDS_TIMER_WHEEL_NIL) {
+    cds_timer_wheel_node(wheel, node->prev)->next = node->next;
+  } else {
+    wheel->slots[node->slot] = node->next;
+    if (node->next == CDS_TIMER_WHEEL_NIL) {
+      wheel->occupied[node->slot / CDS_TIMER_WHEEL_SLOTS] &=
+        ~((uint64_t) 1 << (node->slot % CDS_TIMER_WHEEL_SLOTS));
+    }
+  }
+  if (node->next != CDS_TIMER_WHEEL_NIL) {
+    cds_timer_wheel_node(wheel, node->next)->prev = node->prev;
+  }
+}
+
+// Returns an unlinked node to the free list; the new generation invalidates its old id.
+static void cds_timer_wheel_release(struct cds_timer_wheel *wheel, uint32_t index) {
+  struct cds_timer_wheel_node *node = cds_timer_wheel_node(wheel, index);
+  node->generation++;
+  node->slot = CDS_TIMER_WHEEL_FREE;
+  node->next = wheel->free_head;
+  wheel->free_head = index;
+  wheel->size--;
+}
+
+cds_timer_id cds_timer_wheel_arm(struct cds_timer_wheel *wheel, uint64_t deadline, void *data) {
+  // A wheel whose creation failed, or that was deleted, has no node array and may have no tick.
+  if (wheel->tick == 0 || wheel->nodes.data == NULL) {
+    return CDS_TIMER_NONE;
+  }
+  uint32_t index = wheel->free_head;
+  if (index != CDS_TIMER_WHEEL_NIL) {
+    wheel->free_head = cds_timer_wheel_node(wheel, index)->next;
+  } else {
+    struct cds_timer_wheel_node *node;
+    if (wheel->nodes.size >= CDS_TIMER_WHEEL_NIL || (node = cds_array_emplace_back(&wheel->nodes)) == NULL) {
+      return CDS_TIMER_NONE;
+    }
+    node->generation = 0;
+    index = (uint32_t) (wheel->nodes.size - 1);
+  }
+  struct cds_timer_wheel_node *node = cds_timer_wheel_node(wheel, index);
+  const uint64_t expires = deadline / wheel->tick + (deadline % wheel->tick != 0);
+  node->expires = expires > wheel->current ? expires : wheel->current + 1;
+  node->deadline = deadline;
+  node->data = data;
+  cds_timer_wheel_link(wheel, index);
+  wheel->size++;
+  return (uint64_t) node->generation << 32 | index;
+}
+
+int cds_timer_wheel_cancel(struct cds_timer_wheel *wheel, cds_timer_id id) {
+  const uint32_t index = (uint32_t) id;
+  if (index >= wheel->nodes.size) {
+    return -1;
+  }
+  const struct cds_timer_wheel_node *node = cds_timer_wheel_node(wheel, index);
+  if (node->slot == CDS_TIMER_WHEEL_FREE || node->generation != (uint32_t) (id >> 32)) {
+    return -1;
+  }
+  cds_timer_wheel_unlink(wheel, index);
+  cds_timer_wheel_release(wheel, index);
+  return 0;
+}
+
+/*
+ * Every occupied slot's digit is above current's digit for its level, so the next slot to process is
+ * the lowest occupied one in the lowest nonempty level, reached when current enters its range. Ticks
+ * before that need no work and are skipped. A slot in level 0 fires; a slot in a higher level fires
+ * the timers due at its first tick and moves the rest to lower levels.
+ */
+static int cds_timer_wheel_run(struct cds_timer_wheel *wheel, uint64_t now, cds_timer_func callback,
+                               void *context, struct cds_array *expired, size_t *fired) {
+  if (wheel->tick == 0) {
+    return -1;
+  }
+  const uint64_t target = now / wheel->tick;
+  for (;;) {
+    unsigned level = 0;
+    while (level < CDS_TIMER_WHEEL_LEVELS && wheel->occupied[level] == 0) {
+      level++;
+    }
+    if (level == CDS_TIMER_WHEEL_LEVELS) {
+      break;
+    }
+    const unsigned shift = 6 * level, digit = (unsigned) __builtin_ctzll(wheel->occupied[level]);
+    const uint64_t prefix = shift + 6 < 64 ? wheel->current >> (shift + 6) << (shift + 6) : 0;
+    const uint64_t at = prefix | (uint64_t) digit << shift;
+    if (at > target) {
+      break;
+    }
+    wheel->current = at;
+    const unsigned slot = level * CDS_TIMER_WHEEL_SLOTS + digit;
+    // Callbacks may cancel the timers still in the slot, so it is re-read after each one.
+    while (wheel->slots[slot] != CDS_TIMER_WHEEL_NIL) {
+      const uint32_t index = wheel->slots[slot];
+      const struct cds_timer_wheel_node *node = cds_timer_wheel_node(wheel, index);
+      if (node->expires != at) {
+        cds_timer_wheel_unlink(wheel, index);
+        cds_timer_wheel_link(wheel, index);
+        continue;
+      }
+      const struct cds_timer timer = {(uint64_t) node->generation << 32 | index, node->deadline, node->data};
+      if (expired != NULL && cds_array_push_back(expired, &timer) != 0) {
+        return -1;
+      }
+      cds_timer_wheel_unlink(wheel, index);
+      cds_timer_wheel_release(wheel, index);
+      ++*fired;
+      if (callback != NULL) {
+        callback(&timer, context);
+      }
+    }
+  }
+  if (target > wheel->current) {
+    wheel->current = target;
+  }
+  return 0;
+}
+
+size_t cds_timer_wheel_advance(struct cds_timer_wheel *wheel, uint64_t now, cds_timer_func callback,
+                               void *context) {
+  size_t fired = 0;
+  cds_timer_wheel_run(wheel, now, callback, context, NULL, &fired);
+  return fired;
+}
+
+int cds_timer_wheel_advance_into(struct cds_timer_wheel *wheel, uint64_t now, struct cds_array *expired) {
+  size_t fired = 0;
+  return cds_timer_wheel_run(wheel, now, NULL, NULL, expired, &fired);
+}
+
+size_t cds_timer_wheel_size(const struct cds_timer_wheel *wheel) {
+  return wheel->size;
+}
+
+bool cds_timer_wheel_empty(const struct cds_timer_wheel *wheel) {
+  return wheel->size == 0;
+}
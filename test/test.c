@@ -1,29 +1,47 @@
 #include <stdio.h>
 
+#include "test_allocator.h"
 #include "test_array.h"
 #include "test_avl_tree.h"
 #include "test_hashtable.h"
+#include "test_learned_index.h"
 #include "test_heap.h"
+#include "test_indexed_heap.h"
+#include "test_radix_heap.h"
+#include "test_pairing_heap.h"
+#include "test_timer_wheel.h"
 #include "test_list.h"
 #include "test_queue.h"
 #include "test_rb_tree.h"
 #include "test_graph.h"
+#include "test_search_layout.h"
+#include "test_segarray.h"
 #include "test_sort.h"
 #include "test_stack.h"
 #include "test_string.h"
+#include "test_template.h"
 
 int main(void) {
   printf("**************************************************\n");
   printf("*                  TEST STARTS                   *\n");
   printf("**************************************************\n\n");
   test_sort();
+  test_search_layout();
+  test_learned_index();
   test_stack();
   test_array();
+  test_segarray();
   test_queue();
   test_list_node();
   test_list();
   test_string();
   test_heap();
+  test_indexed_heap();
+  test_radix_heap();
+  test_pairing_heap();
+  test_timer_wheel();
+  test_allocator();
+  test_template();
 
   // AVL Tree Tests
   printf("\n--- Starting AVL Tree Tests ---\n");
@@ -0,0 +1,158 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <cds/allocator.h>
+#include <cds/array.h>
+#include <cds/avl_tree.h>
+#include <cds/hashtable.h>
+#include <cds/list.h>
+#include <cds/queue.h>
+#include <cds/rb_tree.h>
+#include <cds/stack.h>
+#include <cds/string.h>
+#include <cds/util.h>
+#include "test_allocator.h"
+
+struct counting_context {
+  size_t live_blocks, live_bytes, total_allocs;
+};
+
+static void* counting_alloc(void *context, size_t size) {
+  struct counting_context *ctx = context;
+  ctx->live_blocks++;
+  ctx->live_bytes += size;
+  ctx->total_allocs++;
+  return malloc(size);
+}
+
+static void* counting_realloc(void *context, void *ptr, size_t old_size, size_t new_size) {
+  struct counting_context *ctx = context;
+  if (ptr == NULL) {
+    return counting_alloc(context, new_size);
+  }
+  ctx->live_bytes += new_size;
+  ctx->live_bytes -= old_size;
+  return realloc(ptr, new_size);
+}
+
+static void counting_free(void *context, void *ptr, size_t size) {
+  struct counting_context *ctx = context;
+  ctx->live_blocks--;
+  ctx->live_bytes -= size;
+  free(ptr);
+}
+
+static int int_cmp(const void *a, const void *b) {
+  return (*(const int32_t *)a > *(const int32_t *)b) - (*(const int32_t *)a < *(const int32_t *)b);
+}
+
+static void test_aligned_allocator() {
+  struct cds_aligned_allocator aligned;
+  assert(cds_aligned_allocator_init(&aligned, 48, 0) == -1);
+  assert(cds_aligned_allocator_init(&aligned, 64, 0) == 0);
+  struct cds_array array = cds_array_new_with_allocator(sizeof(int32_t), &aligned.allocator);
+  struct cds_stack stack = cds_stack_new_with_allocator(sizeof(int32_t), &aligned.allocator);
+  struct cds_queue queue = cds_queue_new_with_allocator(sizeof(int32_t), &aligned.allocator);
+  for (int32_t i = 0; i < 1000; ++i) {
+    assert(cds_array_push_back(&array, &i) == 0);
+    assert(cds_stack_push(&stack, &i) == 0);
+    assert(cds_queue_push(&queue, &i) == 0);
+    assert((uintptr_t) array.data % 64 == 0);
+    assert((uintptr_t) stack.data % 64 == 0);
+    assert((uintptr_t) queue.data % 64 == 0);
+  }
+  assert(CONV(int32_t) cds_array_get(&array, 999) == 999);
+  assert(CONV(int32_t) cds_queue_front(&queue) == 0);
+  cds_array_delete(&array);
+  cds_stack_delete(&stack);
+  cds_queue_delete(&queue);
+
+  struct cds_aligned_allocator huge;
+  assert(cds_aligned_allocator_init(&huge, 64, CDS_ALLOCATOR_HUGE_PAGES | CDS_ALLOCATOR_HUGETLB) == 0);
+  struct cds_array big = cds_array_new_with_allocator(sizeof(int64_t), &huge.allocator);
+  assert(cds_array_reserve(&big, CDS_HUGE_PAGE_SIZE / sizeof(int64_t)) == 0);
+  assert((uintptr_t) big.data % CDS_HUGE_PAGE_SIZE == 0);
+  for (int64_t i = 0; i < (int64_t) (3 * CDS_HUGE_PAGE_SIZE / sizeof(int64_t)); ++i) {
+    assert(cds_array_push_back(&big, &i) == 0);
+  }
+  assert(CONV(int64_t) cds_array_get(&big, 12345) == 12345);
+  assert(cds_array_shrink_to_fit(&big) == 0);
+  assert(cds_array_resize(&big, 10) == 0);
+  assert(cds_array_shrink_to_fit(&big) == 0);
+  assert(CONV(int64_t) cds_array_get(&big, 9) == 9);
+  cds_array_delete(&big);
+}
+
+void test_allocator() {
+  struct counting_context ctx = {0};
+  const struct cds_allocator allocator = {
+    .alloc = counting_alloc,
+    .realloc = counting_realloc,
+    .free = counting_free,
+    .context = &ctx};
+
+  struct cds_array array = cds_array_new_with_allocator(sizeof(int32_t), &allocator);
+  struct cds_stack stack = cds_stack_new_with_allocator(sizeof(int32_t), &allocator);
+  struct cds_queue queue = cds_queue_new_with_allocator(sizeof(int32_t), &allocator);
+  struct cds_list list = cds_list_new_with_allocator(sizeof(int32_t), &allocator);
+  struct cds_avl_tree avl = cds_avl_tree_new_with_allocator(sizeof(int32_t), sizeof(int32_t), int_cmp,
+                                                            &allocator);
+  struct cds_rb_tree rb = cds_rb_tree_new_with_allocator(sizeof(int32_t), sizeof(int32_t), int_cmp,
+                                                         &allocator);
+  for (int32_t i = 0; i < 100; ++i) {
+    assert(cds_array_push_back(&array, &i) == 0);
+    assert(cds_stack_push(&stack, &i) == 0);
+    assert(cds_queue_push(&queue, &i) == 0);
+    assert(cds_list_push_back(&list, &i) == 0);
+    assert(cds_avl_tree_insert(&avl, &i, &i) == 0);
+    assert(cds_rb_tree_insert(&rb, &i, &i) == 0);
+  }
+  for (int32_t i = 0; i < 100; i += 2) {
+    assert(cds_avl_tree_remove(&avl, &i) == 0);
+    assert(cds_rb_tree_remove(&rb, &i) == 0);
+    assert(cds_list_pop_front(&list) == 0);
+  }
+  assert(CONV(int32_t) cds_avl_tree_find(&avl, &(int32_t){51}) == 51);
+  assert(CONV(int32_t) cds_rb_tree_find(&rb, &(int32_t){51}) == 51);
+  assert(CONV(int32_t) cds_list_get_head(&list) == 50);
+  assert(ctx.live_blocks > 0);
+
+  cds_array_delete(&array);
+  cds_stack_delete(&stack);
+  cds_queue_delete(&queue);
+  cds_list_delete(&list);
+  cds_avl_tree_delete(&avl);
+  cds_rb_tree_delete(&rb);
+  assert(ctx.live_blocks == 0);
+  assert(ctx.live_bytes == 0);
+
+  cds_hashtable_chaining_t *table = cds_hashtable_chaining_create_with_allocator(16, &allocator);
+  cds_hashtable_lp_t *lp = cds_hashtable_lp_create_with_allocator(16, &allocator);
+  int value = 42;
+  assert(cds_hashtable_chaining_insert(table, "alpha", &value) == 0);
+  assert(cds_hashtable_chaining_insert(table, "beta", &value) == 0);
+  assert(cds_hashtable_lp_insert(lp, "alpha", &value) == 0);
+  assert(cds_hashtable_chaining_delete(table, "alpha") == 0);
+  assert(cds_hashtable_chaining_search(table, "beta") == &value);
+  assert(cds_hashtable_lp_search(lp, "alpha") == &value);
+  cds_hashtable_chaining_destroy(table);
+  cds_hashtable_lp_destroy(lp);
+  assert(ctx.live_blocks == 0);
+  assert(ctx.live_bytes == 0);
+
+  struct cds_string string = cds_string_from_with_allocator("hello allocator", 15, &allocator);
+  struct cds_array words = cds_string_split(&string, " ");
+  assert(cds_array_size(&words) == 2);
+  assert(words.allocator == &allocator);
+  for (size_t i = 0; i < cds_array_size(&words); ++i) {
+    cds_string_delete(cds_array_get(&words, i));
+  }
+  cds_array_delete(&words);
+  cds_string_delete(&string);
+  assert(ctx.live_blocks == 0);
+  assert(ctx.live_bytes == 0);
+  assert(ctx.total_allocs > 0);
+
+  test_aligned_allocator();
+}
@@ -0,0 +1,6 @@
+#ifndef CDS_TEST_ALLOCATOR_H
+#define CDS_TEST_ALLOCATOR_H
+
+void test_allocator();
+
+#endif
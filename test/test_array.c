@@ -1,10 +1,119 @@
 #include <assert.h>
 #include <stdint.h>
+#include <stdio.h>
 
 #include <cds/array.h>
+#include <cds/sort.h>
 #include <cds/util.h>
 #include "test_array.h"
 
+static void test_array_bulk() {
+  struct cds_array array = cds_array_new(sizeof(int32_t));
+  assert(cds_array_reserve(&array, 100) == 0);
+  assert(array.capacity == 100);
+  assert(cds_array_size(&array) == 0);
+
+  int32_t block[64];
+  for (int32_t i = 0; i < 64; ++i) {
+    block[i] = i;
+  }
+  assert(cds_array_push_back_n(&array, block, 64) == 0);
+  assert(cds_array_push_back_n(&array, block, 64) == 0);
+  assert(cds_array_size(&array) == 128);
+  assert(array.capacity >= 128);
+  for (int32_t i = 0; i < 128; ++i) {
+    assert(CONV(int32_t) cds_array_at(&array, i) == i % 64);
+  }
+
+  int32_t *slot = cds_array_emplace_back(&array);
+  assert(slot != NULL);
+  *slot = 1000;
+  assert(cds_array_size(&array) == 129);
+  assert(CONV(int32_t) cds_array_at(&array, 128) == 1000);
+
+  assert(cds_array_resize(&array, 10) == 0);
+  assert(cds_array_size(&array) == 10);
+  assert(cds_array_resize(&array, 20) == 0);
+  for (int32_t i = 10; i < 20; ++i) {
+    assert(CONV(int32_t) cds_array_at(&array, i) == 0);
+  }
+
+  assert(cds_array_shrink_to_fit(&array) == 0);
+  assert(array.capacity == 20);
+  assert(CONV(int32_t) cds_array_at(&array, 9) == 9);
+  cds_array_resize(&array, 0);
+  assert(cds_array_shrink_to_fit(&array) == 0);
+  assert(array.capacity == 1);
+  assert(cds_array_push_back(&array, &block[5]) == 0);
+  assert(CONV(int32_t) cds_array_at(&array, 0) == 5);
+  cds_array_delete(&array);
+
+  // Capacities whose size in bytes overflows are rejected and leave the array as it was.
+  struct cds_array wide = cds_array_new(sizeof(uint64_t));
+  assert(cds_array_push_back_n(&wide, block, 1) == 0);
+  const size_t capacity = wide.capacity;
+  assert(cds_array_reserve(&wide, SIZE_MAX / 4 + 2) == -1);
+  assert(cds_array_resize(&wide, SIZE_MAX / 4 + 2) == -1);
+  assert(cds_array_push_back_n(&wide, block, SIZE_MAX) == -1);
+  assert(cds_array_push_back_n(&wide, block, SIZE_MAX / 2 + 1) == -1);
+  assert(wide.capacity == capacity && cds_array_size(&wide) == 1);
+  assert(cds_array_resize(&wide, 64) == 0);
+  assert(CONV(uint64_t) cds_array_at(&wide, 63) == 0);
+  cds_array_delete(&wide);
+}
+
+static int int32_cmp(const void *a, const void *b) {
+  return (*(const int32_t *)a > *(const int32_t *)b) - (*(const int32_t *)a < *(const int32_t *)b);
+}
+
+static void test_array_mapped() {
+  const char *path = "test_array_mapped.bin";
+  struct cds_array array = cds_array_open_mapped(path, sizeof(int32_t),
+                                                 CDS_ARRAY_MAP_CREATE | CDS_ARRAY_MAP_TRUNCATE);
+  assert(array.data != NULL);
+  assert(cds_array_empty(&array));
+  assert(cds_array_advise_mapped(&array, CDS_ARRAY_MAP_ADVICE_SEQUENTIAL) == 0);
+  for (int32_t i = 5000; i > 0; --i) {
+    assert(cds_array_push_back(&array, &i) == 0);
+  }
+  cds_array_sort(&array, int32_cmp);
+  assert(cds_array_flush_mapped(&array, true) == 0);
+  assert(cds_array_close_mapped(&array) == 0);
+  assert(array.data == NULL);
+
+  array = cds_array_open_mapped(path, sizeof(int32_t), CDS_ARRAY_MAP_READONLY);
+  assert(array.data != NULL);
+  assert(cds_array_size(&array) == 5000);
+  for (int32_t i = 0; i < 5000; ++i) {
+    assert(CONV(int32_t) cds_array_get(&array, i) == i + 1);
+  }
+  const int32_t key = 1234;
+  assert(CONV(int32_t) cds_array_search_binary(&array, &key, int32_cmp) == 1234);
+  assert(cds_array_push_back(&array, &key) == -1);
+  assert(cds_array_close_mapped(&array) == 0);
+
+  struct cds_array mismatched = cds_array_open_mapped(path, sizeof(int64_t), 0);
+  assert(mismatched.data == NULL);
+  struct cds_array plain = cds_array_new(sizeof(int32_t));
+  assert(cds_array_flush_mapped(&plain, false) == -1);
+  cds_array_delete(&plain);
+
+  // A header whose size would overflow when scaled to bytes is rejected rather than trusted.
+  array = cds_array_open_mapped(path, sizeof(uint64_t), CDS_ARRAY_MAP_CREATE | CDS_ARRAY_MAP_TRUNCATE);
+  const uint64_t value = 7, corrupt_size = (uint64_t) 1 << 61;
+  assert(cds_array_push_back(&array, &value) == 0);
+  assert(cds_array_flush_mapped(&array, true) == 0);
+  assert(cds_array_close_mapped(&array) == 0);
+  FILE *file = fopen(path, "r+b");
+  assert(file != NULL);
+  assert(fseek(file, 16, SEEK_SET) == 0);  // the size field follows the magic and the element size
+  assert(fwrite(&corrupt_size, sizeof(corrupt_size), 1, file) == 1);
+  assert(fclose(file) == 0);
+  struct cds_array corrupt = cds_array_open_mapped(path, sizeof(uint64_t), 0);
+  assert(corrupt.data == NULL);
+  remove(path);
+}
+
 void test_array() {
   struct cds_array array = cds_array_new(sizeof(int32_t));
   for (int32_t i = 0; i < 10; ++i) {
@@ -27,4 +136,7 @@ void test_array() {
   assert(array.size == 0);
   assert(array.capacity == 0);
   assert(array.element_size == 0);
+
+  test_array_bulk();
+  test_array_mapped();
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "test_graph.h"
 #include "cds/graph.h"
 #include "cds/list.h"
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <assert.h>
@@ -171,8 +172,66 @@ void test_cycle() {
     printf("Cycle Test Passed\n");
 }
 
+// Edge weights for Dijkstra; INFINITY means no edge.
+double weight_matrix[MAX_NODES][MAX_NODES];
+
+void get_edges_weighted(size_t node, struct cds_array *edges) {
+    for (size_t v = 0; v < MAX_NODES; ++v) {
+        if (!isinf(weight_matrix[node][v])) {
+            struct cds_graph_edge edge = {v, weight_matrix[node][v]};
+            cds_array_push_back(edges, &edge);
+        }
+    }
+}
+
+void test_dijkstra() {
+    printf("Testing Dijkstra...\n");
+    double dist[MAX_NODES];
+    size_t prev[MAX_NODES];
+    srand(3);
+    for (int round = 0; round < 200; ++round) {
+        for (int u = 0; u < MAX_NODES; ++u) {
+            for (int v = 0; v < MAX_NODES; ++v) {
+                weight_matrix[u][v] = rand() % 3 == 0 ? (double)(rand() % 20) : INFINITY;
+            }
+        }
+        const size_t source = (size_t)(round % MAX_NODES);
+        assert(cds_graph_dijkstra(MAX_NODES, source, get_edges_weighted, dist, prev) == 0);
+
+        // Bellman-Ford as the reference.
+        double expected[MAX_NODES];
+        for (int v = 0; v < MAX_NODES; ++v) {
+            expected[v] = INFINITY;
+        }
+        expected[source] = 0.0;
+        for (int pass = 0; pass < MAX_NODES; ++pass) {
+            for (int u = 0; u < MAX_NODES; ++u) {
+                for (int v = 0; v < MAX_NODES; ++v) {
+                    if (expected[u] + weight_matrix[u][v] < expected[v]) {
+                        expected[v] = expected[u] + weight_matrix[u][v];
+                    }
+                }
+            }
+        }
+        for (size_t v = 0; v < MAX_NODES; ++v) {
+            assert(dist[v] == expected[v]);
+            if (v == source || isinf(dist[v])) {
+                assert(prev[v] == CDS_GRAPH_NO_NODE);
+            } else {
+                assert(dist[prev[v]] + weight_matrix[prev[v]][v] == dist[v]);
+            }
+        }
+    }
+
+    weight_matrix[0][1] = -2.0;
+    assert(cds_graph_dijkstra(MAX_NODES, 0, get_edges_weighted, dist, NULL) == -1);
+    assert(cds_graph_dijkstra(MAX_NODES, MAX_NODES, get_edges_weighted, dist, NULL) == -1);
+    printf("Dijkstra Passed\n");
+}
+
 void test_graph(void) {
     test_bfs();
     test_dfs();
     test_cycle();
+    test_dijkstra();
 }
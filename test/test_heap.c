@@ -1,6 +1,8 @@
 #include <assert.h>
+#include <pthread.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 
 #include <cds/heap.h>
 #include <cds/util.h>
@@ -10,6 +12,154 @@ int int_cmp(const void *a, const void *b) {
   return (*(int *)a - *(int *)b);
 }
 
+struct big_element {
+  uint64_t key;
+  char payload[2040];
+};
+
+static int big_cmp(const void *a, const void *b) {
+  const uint64_t x = ((const struct big_element *)a)->key, y = ((const struct big_element *)b)->key;
+  return (x > y) - (x < y);
+}
+
+static int u64_cmp(const void *a, const void *b) {
+  const uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+  return (x > y) - (x < y);
+}
+
+// Pushes and pops n pseudo-random keys in an interleaved order and checks they come out sorted.
+static void check_heap_order(struct cds_heap *heap, size_t n, uint64_t seed) {
+  uint64_t state = seed, last = 0;
+  size_t pushed = 0, popped = 0;
+  while (popped < n) {
+    if (pushed < n && (cds_heap_empty(heap) || (state >> 61) != 0)) {
+      state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+      const uint64_t key = last + (state >> 40);  // never below the last key popped
+      assert(cds_heap_push(heap, &key) == 0);
+      pushed++;
+    } else {
+      const uint64_t top = *(uint64_t *)cds_heap_top(heap);
+      assert(top >= last);
+      last = top;
+      assert(cds_heap_pop(heap) == 0);
+      popped++;
+    }
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+  }
+  assert(cds_heap_empty(heap) && cds_heap_top(heap) == NULL && cds_heap_pop(heap) == -1);
+}
+
+static void *heap_thread(void *arg) {
+  struct cds_heap heap = cds_heap_new_dary(sizeof(uint64_t), u64_cmp, 4);
+  check_heap_order(&heap, 20000, (uint64_t)(uintptr_t)arg);
+  cds_heap_delete(&heap);
+  return NULL;
+}
+
+static void test_heap_dary() {
+  const size_t arities[] = {2, 4, 8};
+  for (size_t a = 0; a < 3; a++) {
+    struct cds_heap heap = cds_heap_new_dary(sizeof(uint64_t), u64_cmp, arities[a]);
+    assert(heap.data.data != NULL && cds_heap_empty(&heap));
+    assert((uintptr_t)heap.data.data % 64 == 0);
+    for (uint64_t i = 0; i < 1000; i++) {
+      const uint64_t key = (i * 7919) % 1000;
+      assert(cds_heap_push(&heap, &key) == 0);
+    }
+    assert(cds_heap_size(&heap) == 1000);
+    for (uint64_t i = 0; i < 1000; i++) {
+      assert(*(uint64_t *)cds_heap_top(&heap) == i);
+      assert(cds_heap_pop(&heap) == 0);
+    }
+    check_heap_order(&heap, 50000, arities[a]);
+    cds_heap_delete(&heap);
+  }
+
+  struct cds_heap invalid = cds_heap_new_dary(sizeof(uint64_t), u64_cmp, 3);
+  assert(invalid.data.data == NULL);
+  uint64_t keys[4] = {4, 3, 2, 1};
+  assert(cds_heap_size(&invalid) == 0 && cds_heap_empty(&invalid));
+  assert(cds_heap_top(&invalid) == NULL);
+  assert(cds_heap_pop(&invalid) == -1);
+  assert(cds_heap_push(&invalid, &keys[0]) == -1);
+  assert(cds_heap_push_n(&invalid, keys, 4) == -1);
+  assert(cds_heap_pop_n(&invalid, keys, 4) == 0);
+  assert(cds_heap_size(&invalid) == 0);
+  cds_heap_delete(&invalid);
+
+  // Elements larger than any fixed swap buffer.
+  struct cds_heap big = cds_heap_new_dary(sizeof(struct big_element), big_cmp, 4);
+  struct big_element element;
+  for (uint64_t i = 0; i < 200; i++) {
+    element.key = (i * 37) % 200;
+    memset(element.payload, (int)element.key, sizeof(element.payload));
+    assert(cds_heap_push(&big, &element) == 0);
+  }
+  for (uint64_t i = 0; i < 200; i++) {
+    const struct big_element *top = cds_heap_top(&big);
+    assert(top->key == i && top->payload[sizeof(top->payload) - 1] == (char)i);
+    assert(cds_heap_pop(&big) == 0);
+  }
+  cds_heap_delete(&big);
+
+  // Independent heaps on several threads at once.
+  pthread_t threads[4];
+  for (uintptr_t t = 0; t < 4; t++) {
+    assert(pthread_create(&threads[t], NULL, heap_thread, (void *)(t + 1)) == 0);
+  }
+  for (size_t t = 0; t < 4; t++) {
+    pthread_join(threads[t], NULL);
+  }
+}
+
+static void test_heap_bulk() {
+  const size_t arities[] = {2, 4, 8};
+  const size_t sizes[] = {0, 1, 2, 5, 7, 8, 9, 1000, 4097};
+  uint64_t keys[4097], out[4097];
+  for (size_t a = 0; a < 3; a++) {
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+      const size_t n = sizes[s];
+      struct cds_array array = cds_array_new(sizeof(uint64_t));
+      for (uint64_t i = 0; i < n; i++) {
+        keys[i] = (i * 7919) % n;
+        assert(cds_array_push_back(&array, &keys[i]) == 0);
+      }
+      struct cds_heap heap = cds_heap_from_array(&array, u64_cmp, arities[a]);
+      assert(heap.data.data != NULL && array.data == NULL && array.size == 0);
+      assert(cds_heap_size(&heap) == n);
+
+      // Popping in chunks, some larger than what is left.
+      size_t total = 0, popped;
+      while ((popped = cds_heap_pop_n(&heap, out + total, 3 + total % 5)) > 0) {
+        total += popped;
+      }
+      assert(total == n && cds_heap_empty(&heap) && cds_heap_pop_n(&heap, out, 4) == 0);
+      for (uint64_t i = 0; i < n; i++) {
+        assert(out[i] == i);
+      }
+
+      // A batch larger than the heap is heapified; smaller ones are sifted up.
+      assert(cds_heap_push_n(&heap, keys, n) == 0);
+      assert(cds_heap_push_n(&heap, keys, n / 3) == 0);
+      assert(cds_heap_push_n(&heap, keys, 0) == 0);
+      assert(cds_heap_size(&heap) == n + n / 3);
+      uint64_t last = 0;
+      while (!cds_heap_empty(&heap)) {
+        const uint64_t top = *(uint64_t *)cds_heap_top(&heap);
+        assert(top >= last);
+        last = top;
+        assert(cds_heap_pop(&heap) == 0);
+      }
+      check_heap_order(&heap, 2000, n + 1);
+      cds_heap_delete(&heap);
+    }
+  }
+
+  struct cds_array array = cds_array_new(sizeof(uint64_t));
+  assert(cds_heap_from_array(&array, u64_cmp, 3).data.data == NULL && array.data != NULL);
+  cds_array_delete(&array);
+}
+
 void test_heap() {
   struct cds_heap heap = cds_heap_new(sizeof(int), int_cmp);
 
@@ -43,4 +193,7 @@ void test_heap() {
 
   // Clean up
   cds_heap_delete(&heap);
-}
\ No newline at end of file
+
+  test_heap_dary();
+  test_heap_bulk();
+}
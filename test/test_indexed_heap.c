@@ -0,0 +1,132 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cds/indexed_heap.h>
+#include "test_indexed_heap.h"
+
+#define REFERENCE_IDS 300
+
+static int cmp_i64(const void *a, const void *b) {
+  const int64_t x = *(const int64_t*) a, y = *(const int64_t*) b;
+  return (x > y) - (x < y);
+}
+
+// The id with the smallest priority in the reference, or CDS_INDEXED_HEAP_ABSENT.
+static size_t reference_top(const int64_t *priorities, const bool *present) {
+  size_t best = CDS_INDEXED_HEAP_ABSENT;
+  for (size_t id = 0; id < REFERENCE_IDS; id++) {
+    if (present[id] && (best == CDS_INDEXED_HEAP_ABSENT || priorities[id] < priorities[best])) {
+      best = id;
+    }
+  }
+  return best;
+}
+
+static void check_heap_property(const struct cds_indexed_heap *heap) {
+  const int64_t *keys = (const int64_t*) heap->keys;
+  for (size_t i = 1; i < heap->size; i++) {
+    assert(keys[(i - 1) / CDS_INDEXED_HEAP_ARITY] <= keys[i]);
+  }
+  for (size_t i = 0; i < heap->size; i++) {
+    assert(heap->positions[heap->ids[i]] == i);
+  }
+}
+
+void test_indexed_heap() {
+  // Starts small so that pushing larger ids grows it.
+  struct cds_indexed_heap heap = cds_indexed_heap_new(4, sizeof(int64_t), cmp_i64);
+  assert(heap.keys != NULL && cds_indexed_heap_empty(&heap));
+  assert(cds_indexed_heap_top(&heap) == NULL && cds_indexed_heap_top_id(&heap) == CDS_INDEXED_HEAP_ABSENT);
+  assert(cds_indexed_heap_pop(&heap) == -1);
+
+  int64_t priorities[REFERENCE_IDS];
+  bool present[REFERENCE_IDS] = {false};
+  size_t count = 0;
+  srand(11);
+  for (int step = 0; step < 200000; step++) {
+    const size_t id = (size_t) rand() % REFERENCE_IDS;
+    int64_t priority = rand() % 1000 - 500;
+    switch (rand() % 6) {
+      case 0:
+      case 1:
+        assert(cds_indexed_heap_push(&heap, id, &priority) == (present[id] ? -1 : 0));
+        if (!present[id]) {
+          present[id] = true;
+          priorities[id] = priority;
+          count++;
+        }
+        break;
+      case 2:
+        if (present[id]) {
+          priority = priorities[id] - rand() % 100;
+          assert(cds_indexed_heap_decrease_key(&heap, id, &priority) == 0);
+          priorities[id] = priority;
+          priority += 1;
+          assert(cds_indexed_heap_decrease_key(&heap, id, &priority) == -1);
+        } else {
+          assert(cds_indexed_heap_decrease_key(&heap, id, &priority) == -1);
+        }
+        break;
+      case 3:
+        if (present[id]) {
+          priority = priorities[id] + rand() % 100;
+          assert(cds_indexed_heap_increase_key(&heap, id, &priority) == 0);
+          priorities[id] = priority;
+          priority -= 1;
+          assert(cds_indexed_heap_increase_key(&heap, id, &priority) == -1);
+        } else {
+          assert(cds_indexed_heap_increase_key(&heap, id, &priority) == -1);
+        }
+        break;
+      case 4:
+        assert(cds_indexed_heap_remove(&heap, id) == (present[id] ? 0 : -1));
+        count -= present[id];
+        present[id] = false;
+        break;
+      default:
+        if (count > 0) {
+          const size_t top = cds_indexed_heap_top_id(&heap);
+          assert(present[top] && priorities[top] == priorities[reference_top(priorities, present)]);
+          assert(*(int64_t*) cds_indexed_heap_top(&heap) == priorities[top]);
+          assert(cds_indexed_heap_pop(&heap) == 0);
+          present[top] = false;
+          count--;
+        }
+        break;
+    }
+    assert(cds_indexed_heap_size(&heap) == count);
+    assert(cds_indexed_heap_contains(&heap, id) == present[id]);
+    if (present[id]) {
+      assert(*(int64_t*) cds_indexed_heap_priority(&heap, id) == priorities[id]);
+    } else {
+      assert(cds_indexed_heap_priority(&heap, id) == NULL);
+    }
+    if (step % 1000 == 0) {
+      check_heap_property(&heap);
+    }
+  }
+  assert(heap.capacity >= REFERENCE_IDS);
+  assert(!cds_indexed_heap_contains(&heap, heap.capacity + 100));
+  assert(cds_indexed_heap_remove(&heap, heap.capacity + 100) == -1);
+
+  // Ids whose storage would not fit in size_t are rejected and leave the heap as it was.
+  const size_t capacity = heap.capacity, size = cds_indexed_heap_size(&heap);
+  int64_t priority = 0;
+  assert(cds_indexed_heap_push(&heap, (size_t) 1 << 61, &priority) == -1);
+  assert(cds_indexed_heap_push(&heap, SIZE_MAX - 1, &priority) == -1);
+  assert(heap.capacity == capacity && cds_indexed_heap_size(&heap) == size);
+
+  // Draining yields the priorities in order.
+  int64_t last = INT64_MIN;
+  while (!cds_indexed_heap_empty(&heap)) {
+    const int64_t top = *(int64_t*) cds_indexed_heap_top(&heap);
+    assert(top >= last);
+    last = top;
+    assert(cds_indexed_heap_pop(&heap) == 0);
+  }
+  cds_indexed_heap_delete(&heap);
+  printf("Indexed Heap Passed\n");
+}
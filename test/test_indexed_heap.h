@@ -0,0 +1,6 @@
+#ifndef CDS_TEST_INDEXED_HEAP_H
+#define CDS_TEST_INDEXED_HEAP_H
+
+void test_indexed_heap();
+
+#endif
@@ -0,0 +1,85 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cds/learned_index.h>
+#include "test_learned_index.h"
+
+static size_t expected_lower_bound(const struct cds_array *sorted, uint64_t key) {
+  const uint64_t *keys = (const uint64_t*) sorted->data;
+  size_t lo = 0, hi = sorted->size;
+  while (lo < hi) {
+    const size_t mid = lo + (hi - lo) / 2;
+    if (keys[mid] < key) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+static void check_index(const struct cds_array *sorted, size_t epsilon) {
+  struct cds_learned_index index = cds_learned_index_new(sorted, epsilon);
+  assert(index.segments != NULL);
+  assert(cds_learned_index_size(&index) == sorted->size);
+  const uint64_t *keys = (const uint64_t*) sorted->data;
+  for (size_t i = 0; i < sorted->size; i++) {
+    // Every key, its neighbours, and a point in the gap to the next key.
+    const uint64_t probes[] = {keys[i] - 1, keys[i], keys[i] + 1,
+                               i + 1 < sorted->size ? keys[i] + (keys[i + 1] - keys[i]) / 2 : UINT64_MAX};
+    for (size_t p = 0; p < sizeof(probes) / sizeof(probes[0]); p++) {
+      const size_t lower = expected_lower_bound(sorted, probes[p]);
+      assert(cds_learned_index_lower_bound(&index, probes[p]) == lower);
+      const uint64_t *found = cds_learned_index_lookup(&index, probes[p]);
+      assert(found == (lower < sorted->size && keys[lower] == probes[p] ? &keys[lower] : NULL));
+    }
+  }
+  assert(cds_learned_index_lower_bound(&index, 0) == 0);
+  assert(cds_learned_index_lower_bound(&index, UINT64_MAX) == expected_lower_bound(sorted, UINT64_MAX));
+  cds_learned_index_delete(&index);
+  assert(index.segments == NULL);
+}
+
+void test_learned_index() {
+  struct cds_array sorted = cds_array_new(sizeof(uint64_t));
+  srand(17);
+  // Uniform gaps, skewed gaps spanning the whole 64-bit range, and long runs of equal keys.
+  for (int shape = 0; shape < 3; shape++) {
+    const size_t sizes[] = {0, 1, 2, 3, 100, 5000, 40000};
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+      cds_array_resize(&sorted, 0);
+      uint64_t key = 1;
+      while (sorted.size < sizes[s]) {
+        if (shape == 0) {
+          key += 1 + (uint64_t) (rand() % 100);
+        } else if (shape == 1) {
+          key += (uint64_t) 1 << (rand() % 50);
+        } else {
+          key += rand() % 64 == 0 ? 1 + (uint64_t) (rand() % 1000) : 0;
+        }
+        cds_array_push_back(&sorted, &key);
+      }
+      check_index(&sorted, 0);
+      check_index(&sorted, 1);
+      check_index(&sorted, 8);
+    }
+  }
+  assert(cds_learned_index_empty(&(struct cds_learned_index) {0}));
+
+  uint64_t descending[] = {3, 2, 1};
+  cds_array_resize(&sorted, 0);
+  for (size_t i = 0; i < 3; i++) {
+    cds_array_push_back(&sorted, &descending[i]);
+  }
+  struct cds_learned_index invalid = cds_learned_index_new(&sorted, 0);
+  assert(invalid.segments == NULL);
+  assert(cds_learned_index_lookup(&invalid, 2) == NULL);
+  struct cds_array narrow = cds_array_new(sizeof(uint32_t));
+  invalid = cds_learned_index_new(&narrow, 0);
+  assert(invalid.segments == NULL);
+  cds_array_delete(&narrow);
+  cds_array_delete(&sorted);
+  printf("Learned Index Passed\n");
+}
@@ -0,0 +1,6 @@
+#ifndef CDS_TEST_LEARNED_INDEX_H
+#define CDS_TEST_LEARNED_INDEX_H
+
+void test_learned_index();
+
+#endif
@@ -0,0 +1,169 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cds/heap.h>
+#include <cds/pairing_heap.h>
+#include "test_pairing_heap.h"
+
+#define SHARDS 4
+#define TRACKED 512
+
+static int cmp_i64(const void *a, const void *b) {
+  const int64_t x = *(const int64_t*) a, y = *(const int64_t*) b;
+  return (x > y) - (x < y);
+}
+
+static int cmp_i64_reversed(const void *a, const void *b) {
+  return cmp_i64(b, a);
+}
+
+static size_t chunk_allocations = 0;
+
+static void* counting_alloc(void *context, size_t size) {
+  (void) context;
+  chunk_allocations++;
+  return malloc(size);
+}
+
+static void* counting_realloc(void *context, void *ptr, size_t old_size, size_t new_size) {
+  (void) context;
+  (void) old_size;
+  return realloc(ptr, new_size);
+}
+
+static void counting_free(void *context, void *ptr, size_t size) {
+  (void) context;
+  (void) size;
+  free(ptr);
+}
+
+static const struct cds_allocator counting_allocator = {
+  counting_alloc, counting_realloc, counting_free, NULL};
+
+// Pops everything and checks that it comes out sorted and that the count matches.
+static void drain(struct cds_pairing_heap *heap, size_t expected) {
+  int64_t last = INT64_MIN;
+  size_t popped = 0;
+  while (!cds_pairing_heap_empty(heap)) {
+    const int64_t top = *(int64_t*) cds_pairing_heap_top(heap);
+    assert(top >= last);
+    last = top;
+    assert(cds_pairing_heap_pop(heap) == 0);
+    popped++;
+  }
+  assert(popped == expected && cds_pairing_heap_top(heap) == NULL && cds_pairing_heap_pop(heap) == -1);
+}
+
+void test_pairing_heap() {
+  struct cds_pairing_heap heap = cds_pairing_heap_new_with_allocator(sizeof(int64_t), cmp_i64,
+                                                                     &counting_allocator);
+  assert(cds_pairing_heap_empty(&heap) && chunk_allocations == 0);
+  assert(cds_pairing_heap_top(&heap) == NULL && cds_pairing_heap_pop(&heap) == -1);
+
+  // Interleaved push, pop and decrease_key against cds_heap. Decreased values are pushed into the
+  // reference as well; the stale ones are marked by keeping a count of values to skip.
+  struct cds_heap reference = cds_heap_new(sizeof(int64_t), cmp_i64);
+  struct cds_pairing_heap_node *handles[TRACKED] = {NULL};
+  int64_t values[TRACKED];
+  srand(17);
+  for (int step = 0; step < 100000; step++) {
+    const int op = rand() % 8;
+    const size_t slot = (size_t) rand() % TRACKED;
+    if (op < 3) {
+      int64_t value = rand() % 100000;
+      struct cds_pairing_heap_node *node = cds_pairing_heap_push(&heap, &value);
+      assert(node != NULL && *(int64_t*) node->element == value);
+      assert(cds_heap_push(&reference, &value) == 0);
+      if (handles[slot] == NULL) {
+        handles[slot] = node;
+        values[slot] = value;
+      }
+    } else if (op < 6 && handles[slot] != NULL) {
+      int64_t value = values[slot] - rand() % 1000;
+      assert(cds_pairing_heap_decrease_key(&heap, handles[slot], &value) == 0);
+      value += 1001;
+      assert(cds_pairing_heap_decrease_key(&heap, handles[slot], &value) == -1);
+      value -= 1001;
+      assert(*(int64_t*) handles[slot]->element == value);
+      // Replace the old value in the reference: pop it out and push the rest back.
+      struct cds_heap kept = cds_heap_new(sizeof(int64_t), cmp_i64);
+      while (*(int64_t*) cds_heap_top(&reference) != values[slot]) {
+        assert(cds_heap_push(&kept, cds_heap_top(&reference)) == 0);
+        assert(cds_heap_pop(&reference) == 0);
+      }
+      assert(cds_heap_pop(&reference) == 0 && cds_heap_push(&reference, &value) == 0);
+      while (!cds_heap_empty(&kept)) {
+        assert(cds_heap_push(&reference, cds_heap_top(&kept)) == 0);
+        assert(cds_heap_pop(&kept) == 0);
+      }
+      cds_heap_delete(&kept);
+      values[slot] = value;
+    } else if (!cds_pairing_heap_empty(&heap)) {
+      const int64_t top = *(int64_t*) cds_pairing_heap_top(&heap);
+      assert(top == *(int64_t*) cds_heap_top(&reference));
+      // The popped node's handle becomes invalid.
+      for (size_t i = 0; i < TRACKED; i++) {
+        if (handles[i] == heap.root) {
+          handles[i] = NULL;
+        }
+      }
+      assert(cds_pairing_heap_pop(&heap) == 0 && cds_heap_pop(&reference) == 0);
+    }
+    assert(cds_pairing_heap_size(&heap) == cds_heap_size(&reference));
+  }
+
+  // Popped nodes are reused, so refilling to the same size allocates no new chunk.
+  const size_t size = cds_pairing_heap_size(&heap), chunks = chunk_allocations;
+  assert(chunks > 0);
+  drain(&heap, size);
+  for (size_t i = 0; i < size; i++) {
+    const int64_t value = (int64_t) i;
+    assert(cds_pairing_heap_push(&heap, &value) != NULL);
+  }
+  assert(chunk_allocations == chunks);
+  drain(&heap, size);
+  cds_heap_delete(&reference);
+
+  // Melding shards, with handles into a shard still usable afterwards.
+  struct cds_pairing_heap shards[SHARDS];
+  struct cds_pairing_heap_node *handle = NULL;
+  size_t total = 0;
+  for (size_t s = 0; s < SHARDS; s++) {
+    shards[s] = cds_pairing_heap_new_with_allocator(sizeof(int64_t), cmp_i64, &counting_allocator);
+    for (size_t i = 0; i < 3000 * s; i++) {
+      const int64_t value = rand() % 100000 + 10;
+      struct cds_pairing_heap_node *node = cds_pairing_heap_push(&shards[s], &value);
+      handle = s == 2 && i == 1234 ? node : handle;
+      total++;
+    }
+  }
+  for (size_t s = 0; s < SHARDS; s++) {
+    assert(cds_pairing_heap_meld(&heap, &shards[s]) == 0);
+    assert(cds_pairing_heap_empty(&shards[s]) && shards[s].chunks == NULL);
+  }
+  assert(cds_pairing_heap_size(&heap) == total);
+  const int64_t lowest = -5;
+  assert(cds_pairing_heap_decrease_key(&heap, handle, &lowest) == 0);
+  assert(heap.root == handle && *(int64_t*) cds_pairing_heap_top(&heap) == -5);
+
+  // A melded shard can be reused, and its new nodes melded again.
+  const int64_t one = 1;
+  assert(cds_pairing_heap_push(&shards[0], &one) != NULL);
+  assert(cds_pairing_heap_meld(&heap, &shards[0]) == 0);
+  drain(&heap, total + 1);
+
+  struct cds_pairing_heap reversed = cds_pairing_heap_new_with_allocator(sizeof(int64_t), cmp_i64_reversed,
+                                                                         &counting_allocator);
+  struct cds_pairing_heap plain = cds_pairing_heap_new(sizeof(int64_t), cmp_i64);
+  assert(cds_pairing_heap_meld(&heap, &reversed) == -1 && cds_pairing_heap_meld(&heap, &heap) == -1);
+  assert(cds_pairing_heap_meld(&heap, &plain) == -1);
+  cds_pairing_heap_delete(&plain);
+  for (size_t s = 0; s < SHARDS; s++) {
+    cds_pairing_heap_delete(&shards[s]);
+  }
+  cds_pairing_heap_delete(&reversed);
+  cds_pairing_heap_delete(&heap);
+  printf("Pairing Heap Passed\n");
+}
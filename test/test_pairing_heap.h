@@ -0,0 +1,6 @@
+#ifndef CDS_TEST_PAIRING_HEAP_H
+#define CDS_TEST_PAIRING_HEAP_H
+
+void test_pairing_heap();
+
+#endif
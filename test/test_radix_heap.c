@@ -0,0 +1,126 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <cds/heap.h>
+#include <cds/radix_heap.h>
+#include "test_radix_heap.h"
+
+struct event {
+  uint32_t time;
+  uint32_t id;
+  char payload[13];
+};
+
+static uint64_t event_key(const void *element) {
+  return ((const struct event*) element)->time;
+}
+
+static int event_cmp(const void *a, const void *b) {
+  const uint32_t x = ((const struct event*) a)->time, y = ((const struct event*) b)->time;
+  return (x > y) - (x < y);
+}
+
+static uint64_t u64_key(const void *element) {
+  uint64_t key;
+  memcpy(&key, element, sizeof(key));
+  return key;
+}
+
+static void* failing_alloc(void *context, size_t size) {
+  (void) context;
+  (void) size;
+  return NULL;
+}
+
+static void* failing_realloc(void *context, void *ptr, size_t old_size, size_t new_size) {
+  (void) context;
+  (void) ptr;
+  (void) old_size;
+  (void) new_size;
+  return NULL;
+}
+
+static void failing_free(void *context, void *ptr, size_t size) {
+  (void) context;
+  (void) ptr;
+  (void) size;
+}
+
+void test_radix_heap() {
+  struct cds_radix_heap heap = cds_radix_heap_new(sizeof(struct event), event_key);
+  assert(heap.buckets[0].data != NULL && cds_radix_heap_empty(&heap));
+  assert(cds_radix_heap_top(&heap) == NULL && cds_radix_heap_pop(&heap) == -1);
+
+  // Interleaved pushes and pops, checked against cds_heap; payloads must come through intact.
+  struct cds_heap reference = cds_heap_new(sizeof(struct event), event_cmp);
+  struct event event = {0};
+  uint32_t now = 0;
+  srand(5);
+  for (int step = 0; step < 300000; step++) {
+    if (cds_heap_empty(&reference) || rand() % 5 < 3) {
+      event.time = now + (uint32_t) (rand() % 4 == 0 ? rand() % 4 : rand() % 1000000);
+      event.id = (uint32_t) step;
+      memset(event.payload, (char) step, sizeof(event.payload));
+      assert(cds_radix_heap_push(&heap, &event) == 0);
+      assert(cds_heap_push(&reference, &event) == 0);
+    } else {
+      const struct event *top = cds_radix_heap_top(&heap);
+      assert(top != NULL && top->time == ((const struct event*) cds_heap_top(&reference))->time);
+      assert(heap.last == top->time && top->payload[12] == (char) top->id);
+      now = top->time;
+      assert(cds_radix_heap_pop(&heap) == 0 && cds_heap_pop(&reference) == 0);
+      if (now > 0) {
+        event.time = now - 1;
+        assert(cds_radix_heap_push(&heap, &event) == -1);
+      }
+    }
+    assert(cds_radix_heap_size(&heap) == cds_heap_size(&reference));
+  }
+
+  // Keys below the top are accepted down to the last one popped, until the top is looked at.
+  while (!cds_radix_heap_empty(&heap)) {
+    assert(cds_radix_heap_pop(&heap) == 0);
+  }
+  now = (uint32_t) heap.last;
+  event.time = now + 100;
+  assert(cds_radix_heap_push(&heap, &event) == 0);
+  assert(((struct event*) cds_radix_heap_top(&heap))->time == now + 100);
+  event.time = now + 10;
+  assert(cds_radix_heap_push(&heap, &event) == -1);
+  assert(cds_radix_heap_pop(&heap) == 0);
+  event.time = now + 200;
+  assert(cds_radix_heap_push(&heap, &event) == 0);
+  event.time = now + 150;
+  assert(cds_radix_heap_push(&heap, &event) == 0);
+  assert(((struct event*) cds_radix_heap_top(&heap))->time == now + 150);
+  cds_heap_delete(&reference);
+  cds_radix_heap_delete(&heap);
+
+  // Full 64-bit keys, including the extremes.
+  struct cds_radix_heap wide = cds_radix_heap_new(sizeof(uint64_t), u64_key);
+  const uint64_t keys[] = {UINT64_MAX, 0, 1ULL << 63, 12345, UINT64_MAX - 1, (1ULL << 63) - 1, 0};
+  const uint64_t sorted[] = {0, 0, 12345, (1ULL << 63) - 1, 1ULL << 63, UINT64_MAX - 1, UINT64_MAX};
+  for (size_t i = 0; i < 7; i++) {
+    assert(cds_radix_heap_push(&wide, &keys[i]) == 0);
+  }
+  for (size_t i = 0; i < 7; i++) {
+    assert(*(uint64_t*) cds_radix_heap_top(&wide) == sorted[i]);
+    assert(cds_radix_heap_pop(&wide) == 0);
+  }
+  assert(cds_radix_heap_empty(&wide));
+  cds_radix_heap_delete(&wide);
+  assert(cds_radix_heap_push(&wide, &keys[0]) == -1);
+
+  // A heap whose creation failed rejects every push.
+  const struct cds_allocator failing = {failing_alloc, failing_realloc, failing_free, NULL};
+  struct cds_radix_heap failed = cds_radix_heap_new_with_allocator(sizeof(uint64_t), u64_key, &failing);
+  assert(failed.buckets[0].data == NULL);
+  assert(cds_radix_heap_push(&failed, &keys[0]) == -1);
+  assert(cds_radix_heap_empty(&failed) && cds_radix_heap_top(&failed) == NULL);
+  assert(cds_radix_heap_pop(&failed) == -1);
+  cds_radix_heap_delete(&failed);
+  printf("Radix Heap Passed\n");
+}
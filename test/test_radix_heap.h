@@ -0,0 +1,6 @@
+#ifndef CDS_TEST_RADIX_HEAP_H
+#define CDS_TEST_RADIX_HEAP_H
+
+void test_radix_heap();
+
+#endif
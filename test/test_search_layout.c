@@ -0,0 +1,56 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cds/search_layout.h>
+#include <cds/sort.h>
+#include "test_search_layout.h"
+
+static int cmp_int32(const void *a, const void *b) {
+  int32_t x = *(const int32_t*) a, y = *(const int32_t*) b;
+  return (x > y) - (x < y);
+}
+
+static void check_layout(const struct cds_array *sorted, enum cds_search_layout_type type,
+                         cds_cmp_func cmp) {
+  struct cds_search_layout layout = cds_search_layout_new(sorted, type, cmp);
+  assert(layout.data != NULL);
+  assert(cds_search_layout_size(&layout) == sorted->size);
+  const int32_t *values = (const int32_t*) sorted->data;
+  for (int32_t key = -3; key <= 3 * (int32_t) sorted->size + 3; key++) {
+    size_t lower = 0;
+    while (lower < sorted->size && values[lower] < key) lower++;
+    size_t upper = lower;
+    while (upper < sorted->size && values[upper] == key) upper++;
+    assert(cds_search_layout_lower_bound(&layout, &key) == lower);
+    assert(cds_search_layout_upper_bound(&layout, &key) == upper);
+  }
+  cds_search_layout_delete(&layout);
+  assert(layout.data == NULL);
+}
+
+void test_search_layout() {
+  struct cds_array sorted = cds_array_new(sizeof(int32_t));
+  // Sizes around full Eytzinger levels and B-tree nodes; every value appears 0 to 3 times.
+  const size_t sizes[] = {0, 1, 2, 15, 16, 17, 31, 255, 256, 257, 289, 1000, 5000};
+  srand(11);
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    cds_array_resize(&sorted, 0);
+    int32_t value = 0;
+    while (sorted.size < sizes[s]) {
+      value += rand() % 2;
+      cds_array_push_back(&sorted, &value);
+    }
+    for (int type = CDS_SEARCH_LAYOUT_EYTZINGER; type <= CDS_SEARCH_LAYOUT_BTREE; type++) {
+      check_layout(&sorted, type, cmp_int32);
+      check_layout(&sorted, type, cds_cmp_i32);
+    }
+  }
+  assert(cds_search_layout_empty(&(struct cds_search_layout) {0}));
+
+  struct cds_search_layout invalid = cds_search_layout_new(NULL, CDS_SEARCH_LAYOUT_BTREE, cmp_int32);
+  assert(invalid.data == NULL);
+  cds_array_delete(&sorted);
+  printf("Search Layout Passed\n");
+}
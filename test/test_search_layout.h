@@ -0,0 +1,6 @@
+#ifndef CDS_TEST_SEARCH_LAYOUT_H
+#define CDS_TEST_SEARCH_LAYOUT_H
+
+void test_search_layout();
+
+#endif
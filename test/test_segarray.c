@@ -0,0 +1,64 @@
+#include <assert.h>
+#include <stdint.h>
+
+#include <cds/segarray.h>
+#include <cds/util.h>
+#include "test_segarray.h"
+
+struct big_record {
+  int32_t id;
+  char payload[CDS_SEGARRAY_CHUNK_BYTES / 4 - sizeof(int32_t)];
+};
+
+static void test_segarray_stable_addresses() {
+  struct cds_segarray array = cds_segarray_new(sizeof(int32_t));
+  assert(cds_segarray_empty(&array));
+  int32_t zero = 0;
+  assert(cds_segarray_push_back(&array, &zero) == 0);
+  int32_t *first = cds_segarray_at(&array, 0);
+  for (int32_t i = 1; i < 100000; ++i) {
+    assert(cds_segarray_push_back(&array, &i) == 0);
+  }
+  assert(cds_segarray_at(&array, 0) == first);
+  assert(cds_segarray_size(&array) == 100000);
+  for (int32_t i = 0; i < 100000; ++i) {
+    assert(CONV(int32_t) cds_segarray_get(&array, i) == i);
+  }
+  assert(cds_segarray_at(&array, 100000) == NULL);
+  cds_segarray_delete(&array);
+  assert(array.chunks == NULL);
+  assert(array.size == 0);
+}
+
+static void test_segarray_chunk_release() {
+  struct cds_segarray array = cds_segarray_new(sizeof(struct big_record));
+  assert(array.chunk_mask + 1 == 4);
+  for (int32_t i = 0; i < 20; ++i) {
+    struct big_record *slot = cds_segarray_emplace_back(&array);
+    assert(slot != NULL);
+    slot->id = i;
+  }
+  assert(array.chunk_count == 5);
+  assert(((struct big_record*) cds_segarray_get(&array, 13))->id == 13);
+
+  // Dropping below a chunk boundary keeps one spare chunk, the next one is released.
+  for (int i = 0; i < 4; ++i) {
+    assert(cds_segarray_pop_back(&array) == 0);
+  }
+  assert(array.chunk_count == 5);
+  for (int i = 0; i < 4; ++i) {
+    assert(cds_segarray_pop_back(&array) == 0);
+  }
+  assert(array.chunk_count == 4);
+  while (!cds_segarray_empty(&array)) {
+    assert(cds_segarray_pop_back(&array) == 0);
+  }
+  assert(array.chunk_count == 1);
+  assert(cds_segarray_pop_back(&array) == -1);
+  cds_segarray_delete(&array);
+}
+
+void test_segarray() {
+  test_segarray_stable_addresses();
+  test_segarray_chunk_release();
+}
@@ -0,0 +1,6 @@
+#ifndef CDS_TEST_SEGARRAY_H
+#define CDS_TEST_SEGARRAY_H
+
+void test_segarray();
+
+#endif
@@ -1,6 +1,8 @@
 #include <assert.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <stddef.h>
 #include <string.h>
 
 #include "cds/array.h"
@@ -69,6 +71,175 @@ void test_search_int() {
     printf("Search Int Passed\n");
 }
 
+void test_search_bounds() {
+    struct cds_array array = cds_array_new(sizeof(int));
+    int nums[] = {1, 2, 5, 5, 5, 6, 9};
+    cds_array_push_back_n(&array, nums, 7);
+
+    int key = 5;
+    size_t first, last;
+    assert(cds_array_lower_bound(&array, &key, cmp_int) == 2);
+    assert(cds_array_upper_bound(&array, &key, cmp_int) == 5);
+    assert(cds_array_equal_range(&array, &key, cmp_int, &first, &last) == 0 && first == 2 && last == 5);
+    assert(*(int *)cds_array_search_binary(&array, &key, cmp_int) == 5);
+    assert(cds_array_search_binary(&array, &key, cmp_int) == cds_array_get(&array, 2));
+    key = 4;
+    assert(cds_array_equal_range(&array, &key, cmp_int, &first, &last) == 0 && first == 2 && last == 2);
+    key = 0;
+    assert(cds_array_lower_bound(&array, &key, cmp_int) == 0);
+    key = 10;
+    assert(cds_array_lower_bound(&array, &key, cmp_int) == 7);
+    assert(cds_array_upper_bound(&array, &key, cmp_int) == 7);
+
+    for (key = 0; key <= 10; key++) {
+        const size_t expected = cds_array_lower_bound(&array, &key, cmp_int);
+        for (size_t hint = 0; hint < 9; hint++) {
+            assert(cds_array_search_exponential(&array, hint, &key, cmp_int) == expected);
+        }
+        assert(cds_array_search_interpolation(&array, 0, sizeof(int), CDS_SORT_RADIX_SIGNED, &key) == expected);
+    }
+
+    // Uniform and heavily skewed keys, both larger than the interpolation cut-off.
+    struct cds_array keys = cds_array_new(sizeof(uint64_t));
+    for (uint64_t i = 0; i < 10000; i++) {
+        uint64_t value = i < 9000 ? i * 1000 : UINT64_MAX - (10000 - i);
+        cds_array_push_back(&keys, &value);
+    }
+    for (uint64_t probe = 0; probe < 10000; probe++) {
+        uint64_t value = probe * 997;
+        size_t expected = value / 1000 + (value % 1000 != 0);
+        if (expected > 9000) expected = 9000;
+        assert(cds_array_search_interpolation(&keys, 0, sizeof(uint64_t), CDS_SORT_RADIX_UNSIGNED, &value) ==
+               expected);
+    }
+    uint64_t value = UINT64_MAX - 5;
+    assert(cds_array_search_interpolation(&keys, 0, sizeof(uint64_t), CDS_SORT_RADIX_UNSIGNED, &value) == 9995);
+    assert(cds_array_search_interpolation(&keys, 0, 3, CDS_SORT_RADIX_UNSIGNED, &value) == 0);
+
+    cds_array_delete(&keys);
+    cds_array_delete(&array);
+    printf("Search Bounds Passed\n");
+}
+
+void test_search_batch() {
+    struct cds_array array = cds_array_new(sizeof(int32_t));
+    for (int32_t i = 0; i < 5000; i++) {
+        int32_t value = i / 3 * 2;  // even values, each three times
+        cds_array_push_back(&array, &value);
+    }
+    const size_t n = 4000;
+    int32_t *keys = malloc(n * sizeof(int32_t));
+    void **results = malloc(n * sizeof(void *));
+    for (size_t i = 0; i < n; i++) {
+        keys[i] = (int32_t) i - 5;
+    }
+    cds_cmp_func cmps[] = {cmp_int, cds_cmp_i32};
+    for (size_t c = 0; c < 2; c++) {
+        assert(cds_array_search_binary_batch(&array, keys, n, results, cmps[c]) == 0);
+        for (size_t i = 0; i < n; i++) {
+            const int32_t key = keys[i];
+            if (key < 0 || key % 2 != 0 || key >= 3334) {
+                assert(results[i] == NULL);
+            } else {
+                assert(results[i] == cds_array_get(&array, (size_t) key / 2 * 3));
+            }
+        }
+    }
+
+    struct cds_array empty = cds_array_new(sizeof(int32_t));
+    assert(cds_array_search_binary_batch(&empty, keys, n, results, cmp_int) == 0);
+    assert(results[0] == NULL && results[n - 1] == NULL);
+    assert(cds_array_search_binary_batch(&array, NULL, 0, NULL, cmp_int) == 0);
+    assert(cds_array_search_binary_batch(&array, keys, n, NULL, cmp_int) == -1);
+    cds_array_delete(&empty);
+    cds_array_delete(&array);
+    free(keys);
+    free(results);
+    printf("Search Batch Passed\n");
+}
+
+static int cmp_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+typedef int (*set_op_func)(const struct cds_array *, const struct cds_array *, cds_cmp_func, struct cds_array *);
+
+static void check_set_ops(const struct cds_array *a, const struct cds_array *b, cds_cmp_func typed,
+                          cds_cmp_func generic) {
+    const set_op_func ops[] = {cds_array_set_merge, cds_array_set_union, cds_array_set_intersect,
+                               cds_array_set_difference};
+    struct cds_array expected = cds_array_new(a->element_size), out = cds_array_new(a->element_size);
+    for (size_t op = 0; op < 4; op++) {
+        assert(ops[op](a, b, generic, &expected) == 0);
+        assert(ops[op](a, b, typed, &out) == 0);
+        assert(out.size == expected.size);
+        assert(memcmp(out.data, expected.data, out.size * out.element_size) == 0);
+    }
+    cds_array_delete(&expected);
+    cds_array_delete(&out);
+}
+
+void test_set_operations() {
+    struct cds_array a = cds_array_new(sizeof(int)), b = cds_array_new(sizeof(int));
+    struct cds_array out = cds_array_new(sizeof(int));
+    int as[] = {1, 3, 3, 5, 7, 9}, bs[] = {2, 3, 4, 7, 7, 10};
+    cds_array_push_back_n(&a, as, 6);
+    cds_array_push_back_n(&b, bs, 6);
+
+    int merged[] = {1, 2, 3, 3, 3, 4, 5, 7, 7, 7, 9, 10};
+    assert(cds_array_set_merge(&a, &b, cmp_int, &out) == 0);
+    assert(out.size == 12 && memcmp(out.data, merged, sizeof(merged)) == 0);
+    int united[] = {1, 2, 3, 3, 4, 5, 7, 9, 10};
+    assert(cds_array_set_union(&a, &b, cmp_int, &out) == 0);
+    assert(out.size == 9 && memcmp(out.data, united, sizeof(united)) == 0);
+    int common[] = {3, 3, 7};
+    assert(cds_array_set_intersect(&a, &b, cmp_int, &out) == 0);
+    assert(out.size == 3 && memcmp(out.data, common, sizeof(common)) == 0);
+    int only_a[] = {1, 5, 9};
+    assert(cds_array_set_difference(&a, &b, cmp_int, &out) == 0);
+    assert(out.size == 3 && memcmp(out.data, only_a, sizeof(only_a)) == 0);
+
+    assert(cds_array_set_merge(&a, &b, cmp_int, &a) == -1);
+    struct cds_array wide = cds_array_new(sizeof(int64_t));
+    assert(cds_array_set_intersect(&a, &wide, cmp_int, &out) == -1);
+
+    // Typed paths (SIMD where available) against the generic one, at lengths around the vector widths
+    // and with one input long enough to be galloped through.
+    struct cds_array a32 = cds_array_new(sizeof(int32_t)), b32 = cds_array_new(sizeof(int32_t));
+    struct cds_array a64 = cds_array_new(sizeof(uint64_t)), b64 = cds_array_new(sizeof(uint64_t));
+    srand(23);
+    for (int round = 0; round < 300; round++) {
+        const size_t na = (size_t) rand() % 70, nb = round % 10 == 0 ? 3000 : (size_t) rand() % 70;
+        const int range = 1 + rand() % 150;
+        cds_array_resize(&a32, na);
+        cds_array_resize(&b32, nb);
+        cds_array_resize(&a64, na);
+        cds_array_resize(&b64, nb);
+        for (size_t i = 0; i < na; i++) ((int32_t *)a32.data)[i] = rand() % range - range / 2;
+        for (size_t i = 0; i < nb; i++) ((int32_t *)b32.data)[i] = rand() % range - range / 2;
+        cds_array_sort(&a32, cmp_int);
+        cds_array_sort(&b32, cmp_int);
+        check_set_ops(&a32, &b32, cds_cmp_i32, cmp_int);
+        check_set_ops(&b32, &a32, cds_cmp_i32, cmp_int);
+        // Values on both sides of the sign bit, which only the unsigned comparator orders correctly.
+        for (size_t i = 0; i < na; i++) ((uint64_t *)a64.data)[i] = (uint64_t)((int32_t *)a32.data)[i] + (1ULL << 63);
+        for (size_t i = 0; i < nb; i++) ((uint64_t *)b64.data)[i] = (uint64_t)((int32_t *)b32.data)[i] + (1ULL << 63);
+        check_set_ops(&a64, &b64, cds_cmp_u64, cmp_u64);
+        check_set_ops(&b64, &a64, cds_cmp_u64, cmp_u64);
+    }
+
+    cds_array_delete(&a32);
+    cds_array_delete(&b32);
+    cds_array_delete(&a64);
+    cds_array_delete(&b64);
+    cds_array_delete(&wide);
+    cds_array_delete(&out);
+    cds_array_delete(&a);
+    cds_array_delete(&b);
+    printf("Set Operations Passed\n");
+}
+
 void test_large_array() {
     printf("Testing Large Array...\n");
     struct cds_array array = cds_array_new(sizeof(int));
@@ -86,8 +257,485 @@ void test_large_array() {
     printf("Large Array Passed\n");
 }
 
+void test_sort_patterns() {
+    printf("Testing Sort Patterns...\n");
+    srand(1234);
+    const int n = 50000;
+    int *expected = malloc(n * sizeof(int));
+    // Random, sorted, reversed, organ-pipe, few-unique and all-equal, plus a 40-byte element that
+    // does not take the register swap path.
+    for (int pattern = 0; pattern < 6; pattern++) {
+        struct cds_array array = cds_array_new(sizeof(int));
+        for (int i = 0; i < n; i++) {
+            int value;
+            switch (pattern) {
+                case 0: value = rand(); break;
+                case 1: value = i; break;
+                case 2: value = n - i; break;
+                case 3: value = i < n / 2 ? i : n - i; break;
+                case 4: value = rand() % 8; break;
+                default: value = 42; break;
+            }
+            expected[i] = value;
+            cds_array_push_back(&array, &value);
+        }
+        qsort(expected, n, sizeof(int), cmp_int);
+        cds_array_sort(&array, cmp_int);
+        assert(memcmp(array.data, expected, n * sizeof(int)) == 0);
+        cds_array_delete(&array);
+    }
+
+    struct wide { int key; char payload[36]; };
+    struct cds_array wide = cds_array_new(sizeof(struct wide));
+    for (int i = 0; i < 5000; i++) {
+        struct wide w = {rand() % 1000, {0}};
+        w.payload[0] = (char) w.key;
+        cds_array_push_back(&wide, &w);
+    }
+    cds_array_sort(&wide, cmp_int);
+    for (size_t i = 1; i < wide.size; i++) {
+        const struct wide *prev = cds_array_get(&wide, i - 1), *cur = cds_array_get(&wide, i);
+        assert(prev->key <= cur->key && cur->payload[0] == (char) cur->key);
+    }
+    cds_array_delete(&wide);
+    free(expected);
+    printf("Sort Patterns Passed\n");
+}
+
+struct radix_record {
+    char tag;
+    int32_t key;
+    uint32_t seq;
+};
+
+static int cmp_record(const void *a, const void *b) {
+    const struct radix_record *ra = a, *rb = b;
+    if (ra->key != rb->key) return ra->key < rb->key ? -1 : 1;
+    return ra->seq < rb->seq ? -1 : (ra->seq > rb->seq);
+}
+
+static int cmp_float(const void *a, const void *b) {
+    float arg1 = *(const float *)a;
+    float arg2 = *(const float *)b;
+    return (arg1 > arg2) - (arg1 < arg2);
+}
+
+static int cmp_u64_desc(const void *a, const void *b) {
+    uint64_t arg1 = *(const uint64_t *)a;
+    uint64_t arg2 = *(const uint64_t *)b;
+    return (arg1 < arg2) - (arg1 > arg2);
+}
+
+void test_sort_radix() {
+    printf("Testing Radix Sort...\n");
+    srand(42);
+
+    // Signed keys inside records: must match a stable sort by (key, insertion order).
+    struct cds_array records = cds_array_new(sizeof(struct radix_record));
+    for (uint32_t i = 0; i < 5000; i++) {
+        struct radix_record r = {'x', (rand() % 2001) - 1000, i};
+        cds_array_push_back(&records, &r);
+    }
+    assert(cds_array_sort_radix(&records, offsetof(struct radix_record, key), sizeof(int32_t),
+                                CDS_SORT_RADIX_SIGNED) == 0);
+    for (size_t i = 1; i < records.size; i++) {
+        assert(cmp_record(cds_array_get(&records, i - 1), cds_array_get(&records, i)) < 0);
+    }
+    cds_array_delete(&records);
+
+    // Floats with negatives.
+    struct cds_array floats = cds_array_new(sizeof(float));
+    float expected[3000];
+    for (int i = 0; i < 3000; i++) {
+        expected[i] = (float) (rand() % 10000 - 5000) / 7.0f;
+        cds_array_push_back(&floats, &expected[i]);
+    }
+    qsort(expected, 3000, sizeof(float), cmp_float);
+    assert(cds_array_sort_radix(&floats, 0, sizeof(float), CDS_SORT_RADIX_FLOAT) == 0);
+    for (int i = 0; i < 3000; i++) {
+        assert(*(float *)cds_array_get(&floats, i) == expected[i]);
+    }
+    cds_array_delete(&floats);
+
+    // Unsigned 64-bit descending, with the high bytes shared so their passes are skipped.
+    struct cds_array wide = cds_array_new(sizeof(uint64_t));
+    uint64_t wide_expected[2000];
+    for (int i = 0; i < 2000; i++) {
+        wide_expected[i] = 0xABCD000000000000ULL | (uint64_t) rand();
+        cds_array_push_back(&wide, &wide_expected[i]);
+    }
+    qsort(wide_expected, 2000, sizeof(uint64_t), cmp_u64_desc);
+    assert(cds_array_sort_radix(&wide, 0, sizeof(uint64_t), CDS_SORT_RADIX_DESCENDING) == 0);
+    assert(memcmp(wide.data, wide_expected, sizeof(wide_expected)) == 0);
+
+    assert(cds_array_sort_radix(&wide, 0, 3, 0) == -1);
+    assert(cds_array_sort_radix(&wide, 4, 8, 0) == -1);
+    cds_array_delete(&wide);
+    printf("Radix Sort Passed\n");
+}
+
+struct wide_record {
+    int32_t key;
+    uint32_t seq;
+    char payload[312];  // larger than the stack scratch of cds_array_sort_by_key
+};
+
+static uint64_t key_record(const void *element) {
+    return (uint64_t) (uint32_t) ((const struct radix_record *) element)->key ^ UINT64_C(0x80000000);
+}
+
+static uint64_t key_wide_record(const void *element) {
+    return (uint64_t) (uint32_t) ((const struct wide_record *) element)->key ^ UINT64_C(0x80000000);
+}
+
+void test_sort_by_key() {
+    printf("Testing Sort By Key...\n");
+    srand(7);
+    struct cds_array records = cds_array_new(sizeof(struct radix_record));
+    struct cds_array permutation = cds_array_new(sizeof(size_t));
+
+    // Sizes on both sides of the insertion sort cutoff; keys span the sign bit and repeat.
+    const size_t sizes[] = {0, 1, 2, 17, 64, 65, 3000};
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        cds_array_resize(&records, 0);
+        for (uint32_t i = 0; i < sizes[s]; i++) {
+            struct radix_record r = {'k', (rand() % 401) - 200, i};
+            cds_array_push_back(&records, &r);
+        }
+        if (s == sizeof(sizes) / sizeof(sizes[0]) - 1) {
+            ((struct radix_record *) cds_array_get(&records, 5))->key = INT32_MIN;
+            ((struct radix_record *) cds_array_get(&records, 6))->key = INT32_MAX;
+        }
+        assert(cds_array_argsort(&records, key_record, &permutation) == 0);
+        assert(permutation.size == records.size);
+        for (size_t i = 1; i < permutation.size; i++) {
+            assert(cmp_record(cds_array_get(&records, *(size_t *) cds_array_get(&permutation, i - 1)),
+                              cds_array_get(&records, *(size_t *) cds_array_get(&permutation, i))) < 0);
+        }
+        assert(cds_array_sort_by_key(&records, key_record) == 0);
+        for (size_t i = 0; i < records.size; i++) {
+            const struct radix_record *r = cds_array_get(&records, i);
+            assert(r->seq == *(size_t *) cds_array_get(&permutation, i));
+        }
+    }
+
+    // Elements larger than the stack scratch, carrying a payload that must move with the key.
+    struct cds_array wide = cds_array_new(sizeof(struct wide_record));
+    for (uint32_t i = 0; i < 500; i++) {
+        struct wide_record r = {(rand() % 50) - 25, i, {0}};
+        memset(r.payload, (int) (i & 0xff), sizeof(r.payload));
+        cds_array_push_back(&wide, &r);
+    }
+    assert(cds_array_sort_by_key(&wide, key_wide_record) == 0);
+    for (size_t i = 0; i < wide.size; i++) {
+        const struct wide_record *r = cds_array_get(&wide, i);
+        assert(r->payload[0] == (char) (r->seq & 0xff));
+        assert(r->payload[sizeof(r->payload) - 1] == r->payload[0]);
+        if (i > 0) {
+            const struct wide_record *prev = cds_array_get(&wide, i - 1);
+            assert(prev->key < r->key || (prev->key == r->key && prev->seq < r->seq));
+        }
+    }
+    cds_array_delete(&wide);
+
+    struct cds_array bad = cds_array_new(sizeof(uint32_t));
+    assert(cds_array_argsort(&records, key_record, &bad) == -1);
+    assert(cds_array_argsort(&records, NULL, &permutation) == -1);
+    assert(cds_array_sort_by_key(NULL, key_record) == -1);
+    assert(cds_array_sort_by_key(&records, NULL) == -1);
+    cds_array_delete(&bad);
+    cds_array_delete(&records);
+    cds_array_delete(&permutation);
+    printf("Sort By Key Passed\n");
+}
+
+struct stable_record {
+    int key;
+    size_t seq;
+};
+
+static size_t stable_compares;
+
+static int cmp_stable_record(const void *a, const void *b) {
+    stable_compares++;
+    return cmp_int(&((const struct stable_record *)a)->key, &((const struct stable_record *)b)->key);
+}
+
+static void check_stable(struct cds_array *records) {
+    assert(cds_array_sort_stable(records, cmp_stable_record) == 0);
+    for (size_t i = 1; i < records->size; i++) {
+        const struct stable_record *prev = cds_array_get(records, i - 1);
+        const struct stable_record *cur = cds_array_get(records, i);
+        assert(prev->key < cur->key || (prev->key == cur->key && prev->seq < cur->seq));
+    }
+}
+
+void test_sort_stable() {
+    printf("Testing Stable Sort...\n");
+    srand(99);
+    const size_t n = 20000;
+    struct cds_array records = cds_array_new(sizeof(struct stable_record));
+
+    // Random keys with many duplicates.
+    for (size_t i = 0; i < n; i++) {
+        struct stable_record r = {rand() % 500, i};
+        cds_array_push_back(&records, &r);
+    }
+    check_stable(&records);
+
+    // Already sorted: a single run, n - 1 comparisons.
+    stable_compares = 0;
+    check_stable(&records);
+    assert(stable_compares == n - 1);
+
+    // Strictly descending: reversed in place, n - 1 comparisons.
+    for (size_t i = 0; i < n; i++) {
+        struct stable_record *r = cds_array_get(&records, i);
+        r->key = (int) (n - i);
+        r->seq = i;
+    }
+    stable_compares = 0;
+    check_stable(&records);
+    assert(stable_compares == n - 1);
+
+    // Append-mostly: a long sorted prefix followed by a few out-of-order records, then long runs
+    // interleaved with descending stretches to exercise galloping in both merge directions.
+    for (size_t i = 0; i < n; i++) {
+        struct stable_record *r = cds_array_get(&records, i);
+        if (i < n - 200) {
+            r->key = (int) i / 3;
+        } else if (i % 1000 < 500) {
+            r->key = rand() % (int) n;
+        } else {
+            r->key = (int) (n - i);
+        }
+        r->seq = i;
+    }
+    check_stable(&records);
+
+    for (size_t i = 0; i < n; i++) {
+        struct stable_record *r = cds_array_get(&records, i);
+        r->key = (i / 2000) % 2 == 0 ? (int) (i % 2000) : (int) (3000 - i % 2000);
+        r->seq = i;
+    }
+    check_stable(&records);
+
+    records.size = 1;
+    assert(cds_array_sort_stable(&records, cmp_stable_record) == 0);
+    assert(cds_array_sort_stable(NULL, cmp_stable_record) == -1);
+    cds_array_delete(&records);
+    printf("Stable Sort Passed\n");
+}
+
+void test_sort_small() {
+    printf("Testing Small Sort...\n");
+    srand(2024);
+    for (int round = 0; round < 2000; round++) {
+        const size_t n = (size_t) round % (CDS_SORT_SMALL_MAX + 1);
+        int32_t i32[CDS_SORT_SMALL_MAX], i32_expected[CDS_SORT_SMALL_MAX];
+        int64_t i64[CDS_SORT_SMALL_MAX], i64_expected[CDS_SORT_SMALL_MAX];
+        float f32[CDS_SORT_SMALL_MAX], f32_expected[CDS_SORT_SMALL_MAX];
+        double f64[CDS_SORT_SMALL_MAX], f64_expected[CDS_SORT_SMALL_MAX];
+        for (size_t i = 0; i < n; i++) {
+            i32[i] = rand() % 3 == 0 ? INT32_MAX - rand() % 2 : rand() - RAND_MAX / 2;
+            i64[i] = (int64_t) i32[i] * (rand() % 2 ? 4294967296LL : -3);
+            f32[i] = (float) (rand() % 200 - 100) / 8.0f;
+            f64[i] = rand() % 5 == 0 ? -0.0 : (double) (rand() % 200 - 100) / 3.0;
+        }
+        memcpy(i32_expected, i32, sizeof(i32));
+        memcpy(i64_expected, i64, sizeof(i64));
+        memcpy(f32_expected, f32, sizeof(f32));
+        memcpy(f64_expected, f64, sizeof(f64));
+        qsort(i32_expected, n, sizeof(int32_t), cds_cmp_i32);
+        qsort(i64_expected, n, sizeof(int64_t), cds_cmp_i64);
+        qsort(f32_expected, n, sizeof(float), cds_cmp_f32);
+        qsort(f64_expected, n, sizeof(double), cds_cmp_f64);
+
+        assert(cds_sort_small_i32(i32, n) == 0);
+        assert(cds_sort_small_i64(i64, n) == 0);
+        assert(cds_sort_small_f32(f32, n) == 0);
+        assert(cds_sort_small_f64(f64, n) == 0);
+        assert(memcmp(i32, i32_expected, n * sizeof(int32_t)) == 0);
+        assert(memcmp(i64, i64_expected, n * sizeof(int64_t)) == 0);
+        assert(memcmp(f32, f32_expected, n * sizeof(float)) == 0);
+        assert(memcmp(f64, f64_expected, n * sizeof(double)) == 0);
+    }
+    int32_t too_many[CDS_SORT_SMALL_MAX + 1] = {0};
+    assert(cds_sort_small_i32(too_many, CDS_SORT_SMALL_MAX + 1) == -1);
+
+    // The networks are also the base case of cds_array_sort for the cds_cmp_* comparators.
+    struct cds_array array = cds_array_new(sizeof(int64_t));
+    for (int i = 0; i < 10000; i++) {
+        int64_t value = (int64_t) rand() * (i % 2 ? 1 : -1);
+        cds_array_push_back(&array, &value);
+    }
+    cds_array_sort(&array, cds_cmp_i64);
+    for (size_t i = 1; i < array.size; i++) {
+        assert(*(int64_t *)cds_array_get(&array, i - 1) <= *(int64_t *)cds_array_get(&array, i));
+    }
+    cds_array_delete(&array);
+    printf("Small Sort Passed\n");
+}
+
+void test_sort_parallel() {
+    printf("Testing Parallel Sort...\n");
+    srand(7);
+    const size_t n = CDS_SORT_PARALLEL_THRESHOLD * 5 + 123;
+    struct cds_array array = cds_array_new(sizeof(int));
+    struct cds_array expected = cds_array_new(sizeof(int));
+    for (size_t i = 0; i < n; i++) {
+        int value = rand() % 100000;  // plenty of duplicates across runs
+        cds_array_push_back(&array, &value);
+    }
+    cds_array_push_back_n(&expected, array.data, n);
+    cds_array_sort(&expected, cmp_int);
+
+    // 3 threads leaves an odd run to carry through a merge round, 4 splits every merge.
+    size_t thread_counts[] = {1, 3, 4, 0};
+    for (size_t t = 0; t < sizeof(thread_counts) / sizeof(thread_counts[0]); t++) {
+        struct cds_array copy = cds_array_new(sizeof(int));
+        cds_array_push_back_n(&copy, array.data, n);
+        assert(cds_array_sort_parallel(&copy, cmp_int, thread_counts[t]) == 0);
+        assert(memcmp(copy.data, expected.data, n * sizeof(int)) == 0);
+        cds_array_delete(&copy);
+    }
+
+    // Below the threshold it sorts serially.
+    array.size = 100;
+    assert(cds_array_sort_parallel(&array, cmp_int, 8) == 0);
+    for (size_t i = 1; i < array.size; i++) {
+        assert(*(int *)cds_array_get(&array, i - 1) <= *(int *)cds_array_get(&array, i));
+    }
+    assert(cds_array_sort_parallel(NULL, cmp_int, 2) == -1);
+    cds_array_delete(&array);
+    cds_array_delete(&expected);
+    printf("Parallel Sort Passed\n");
+}
+
+void test_sort_select() {
+    const size_t n = 10000;
+    struct cds_array array = cds_array_new(sizeof(int));
+    struct cds_array expected = cds_array_new(sizeof(int));
+    struct cds_array top = cds_array_new(sizeof(int));
+    for (int kind = 0; kind < 3; kind++) {
+        cds_array_resize(&array, 0);
+        srand(7);
+        for (size_t i = 0; i < n; i++) {
+            int value = kind == 0 ? rand() : kind == 1 ? (int) i : rand() % 8;
+            cds_array_push_back(&array, &value);
+        }
+        cds_array_resize(&expected, 0);
+        cds_array_push_back_n(&expected, array.data, n);
+        cds_array_sort(&expected, cmp_int);
+        const int *sorted = (const int *) expected.data;
+
+        // top_k leaves the input untouched, so run it first.
+        assert(cds_array_top_k(&array, 100, cmp_int, &top) == 0);
+        assert(top.size == 100);
+        for (size_t i = 0; i < top.size; i++) {
+            assert(*(int *)cds_array_get(&top, i) == sorted[n - 1 - i]);
+        }
+
+        const size_t nth[] = {0, n / 2, n - 1};
+        for (size_t t = 0; t < 3; t++) {
+            assert(cds_array_nth_element(&array, nth[t], cmp_int) == 0);
+            const int value = *(int *)cds_array_get(&array, nth[t]);
+            assert(value == sorted[nth[t]]);
+            for (size_t i = 0; i < n; i++) {
+                const int other = *(int *)cds_array_get(&array, i);
+                assert(i < nth[t] ? other <= value : i > nth[t] ? other >= value : 1);
+            }
+        }
+
+        assert(cds_array_partial_sort(&array, 250, cmp_int) == 0);
+        assert(memcmp(array.data, sorted, 250 * sizeof(int)) == 0);
+    }
+
+    assert(cds_array_nth_element(&array, n, cmp_int) == -1);
+    assert(cds_array_partial_sort(&array, n + 1, cmp_int) == 0);
+    assert(memcmp(array.data, expected.data, n * sizeof(int)) == 0);
+    assert(cds_array_top_k(&array, n + 1, cmp_int, &top) == 0 && top.size == n);
+    assert(cds_array_top_k(&array, 0, cmp_int, &top) == 0 && top.size == 0);
+    struct cds_array wrong = cds_array_new(sizeof(int64_t));
+    assert(cds_array_top_k(&array, 10, cmp_int, &wrong) == -1);
+    cds_array_delete(&wrong);
+    cds_array_delete(&array);
+    cds_array_delete(&expected);
+    cds_array_delete(&top);
+    printf("Selection Passed\n");
+}
+
+static void write_file(const char *path, const void *data, size_t bytes) {
+    FILE *file = fopen(path, "wb");
+    assert(file);
+    assert(fwrite(data, 1, bytes, file) == bytes);
+    fclose(file);
+}
+
+static void check_file(const char *path, const int64_t *expected, size_t n) {
+    int64_t *data = malloc(n * sizeof(int64_t) + 1);
+    FILE *file = fopen(path, "rb");
+    assert(file && data);
+    assert(fread(data, 1, n * sizeof(int64_t) + 1, file) == n * sizeof(int64_t));
+    fclose(file);
+    assert(memcmp(data, expected, n * sizeof(int64_t)) == 0);
+    free(data);
+}
+
+void test_sort_external() {
+    const char *in = "test_sort_external.bin";
+    const char *out = "test_sort_external.out";
+    const size_t n = 100000;
+    int64_t *values = malloc(n * sizeof(int64_t));
+    int64_t *expected = malloc(n * sizeof(int64_t));
+    assert(values && expected);
+    uint64_t state = 42;
+    for (size_t i = 0; i < n; i++) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        values[i] = (int64_t) (state >> 20) % 5000 - 2500;
+    }
+    memcpy(expected, values, n * sizeof(int64_t));
+    qsort(expected, n, sizeof(int64_t), cds_cmp_i64);
+    write_file(in, values, n * sizeof(int64_t));
+
+    // 25 runs merged two at a time, then a single in-memory run, then in place.
+    assert(cds_external_sort_with_tmp_dir(in, out, sizeof(int64_t), cds_cmp_i64, 32 * 1024, ".") == 0);
+    check_file(out, expected, n);
+    assert(cds_external_sort(in, out, sizeof(int64_t), cds_cmp_i64, 2 * 1024 * 1024) == 0);
+    check_file(out, expected, n);
+    assert(cds_external_sort(in, in, sizeof(int64_t), cds_cmp_i64, 64 * 1024) == 0);
+    check_file(in, expected, n);
+
+    write_file(in, values, 0);
+    assert(cds_external_sort(in, out, sizeof(int64_t), cds_cmp_i64, 0) == 0);
+    check_file(out, expected, 0);
+    write_file(in, values, 12);
+    assert(cds_external_sort(in, out, sizeof(int64_t), cds_cmp_i64, 0) == -1);
+    write_file(in, values, n * sizeof(int64_t));
+    assert(cds_external_sort_with_tmp_dir(in, out, sizeof(int64_t), cds_cmp_i64, 1024,
+                                          "test_sort_external_missing_dir") == -1);
+    assert(cds_external_sort("test_sort_external_missing.bin", out, sizeof(int64_t), cds_cmp_i64, 0) == -1);
+
+    remove(in);
+    remove(out);
+    free(values);
+    free(expected);
+    printf("External Sort Passed\n");
+}
+
 void test_sort(void) {
     test_sort_int();
     test_search_int();
+    test_search_bounds();
+    test_search_batch();
+    test_set_operations();
     test_large_array();
+    test_sort_patterns();
+    test_sort_radix();
+    test_sort_by_key();
+    test_sort_stable();
+    test_sort_select();
+    test_sort_small();
+    test_sort_parallel();
+    test_sort_external();
 }
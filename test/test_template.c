@@ -0,0 +1,102 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <cds/template.h>
+#include "test_template.h"
+
+CDS_ARRAY_DEFINE(int32_t, test_intvec)
+CDS_STACK_DEFINE(int32_t, test_intstack)
+CDS_QUEUE_DEFINE(int32_t, test_intqueue)
+CDS_HEAP_DEFINE(int32_t, test_minheap, a < b)
+CDS_HEAP_DEFINE(double, test_maxheap, a > b)
+
+static void test_template_array() {
+  test_intvec array = test_intvec_new();
+  assert(test_intvec_empty(&array));
+  for (int32_t i = 0; i < 100; ++i) {
+    assert(test_intvec_push_back(&array, i) == 0);
+  }
+  const int32_t block[3] = {7, 8, 9};
+  assert(test_intvec_push_back_n(&array, block, 3) == 0);
+  assert(test_intvec_size(&array) == 103);
+  for (int32_t i = 0; i < 100; ++i) {
+    assert(test_intvec_get(&array, i) == i);
+  }
+  assert(*test_intvec_at(&array, 102) == 9);
+  assert(test_intvec_at(&array, 103) == NULL);
+  assert(test_intvec_pop_back(&array) == 0);
+  assert(test_intvec_size(&array) == 102);
+  const size_t capacity = array.capacity;
+  assert(test_intvec_reserve(&array, SIZE_MAX / 2 + 2) == -1);
+  assert(test_intvec_push_back_n(&array, block, SIZE_MAX) == -1);
+  assert(test_intvec_push_back_n(&array, block, SIZE_MAX / 2 + 1) == -1);
+  assert(array.capacity == capacity && test_intvec_size(&array) == 102);
+  test_intvec_delete(&array);
+  assert(array.data == NULL);
+  assert(test_intvec_pop_back(&array) == -1);
+}
+
+static void test_template_stack_queue() {
+  test_intstack stack = test_intstack_new();
+  test_intqueue queue = test_intqueue_new();
+  assert(test_intstack_top(&stack) == NULL);
+  assert(test_intqueue_front(&queue) == NULL);
+  for (int32_t i = 0; i < 10; ++i) {
+    assert(test_intstack_push(&stack, i) == 0);
+    assert(test_intqueue_push(&queue, i) == 0);
+  }
+  // Wrap the ring buffer around before growing it again.
+  for (int32_t i = 0; i < 5; ++i) {
+    assert(test_intqueue_pop(&queue) == 0);
+    assert(test_intqueue_push(&queue, 10 + i) == 0);
+  }
+  for (int32_t i = 15; i < 40; ++i) {
+    assert(test_intqueue_push(&queue, i) == 0);
+  }
+  for (int32_t i = 9; i >= 0; --i) {
+    assert(*test_intstack_top(&stack) == i);
+    assert(test_intstack_pop(&stack) == 0);
+  }
+  for (int32_t i = 5; i < 40; ++i) {
+    assert(*test_intqueue_front(&queue) == i);
+    assert(test_intqueue_pop(&queue) == 0);
+  }
+  assert(test_intstack_empty(&stack));
+  assert(test_intqueue_empty(&queue));
+  test_intstack_delete(&stack);
+  test_intqueue_delete(&queue);
+}
+
+static void test_template_heap() {
+  test_minheap heap = test_minheap_new();
+  srand(7);
+  for (int32_t i = 0; i < 1000; ++i) {
+    assert(test_minheap_push(&heap, rand() % 500) == 0);
+  }
+  assert(test_minheap_size(&heap) == 1000);
+  int32_t previous = *test_minheap_top(&heap);
+  while (!test_minheap_empty(&heap)) {
+    assert(*test_minheap_top(&heap) >= previous);
+    previous = *test_minheap_top(&heap);
+    assert(test_minheap_pop(&heap) == 0);
+  }
+  assert(test_minheap_pop(&heap) == -1);
+  test_minheap_delete(&heap);
+
+  test_maxheap max_heap = test_maxheap_new();
+  const double values[] = {0.5, 3.25, -1.0, 2.0};
+  for (int i = 0; i < 4; ++i) {
+    assert(test_maxheap_push(&max_heap, values[i]) == 0);
+  }
+  assert(*test_maxheap_top(&max_heap) == 3.25);
+  test_maxheap_pop(&max_heap);
+  assert(*test_maxheap_top(&max_heap) == 2.0);
+  test_maxheap_delete(&max_heap);
+}
+
+void test_template() {
+  test_template_array();
+  test_template_stack_queue();
+  test_template_heap();
+}
@@ -0,0 +1,6 @@
+#ifndef CDS_TEST_TEMPLATE_H
+#define CDS_TEST_TEMPLATE_H
+
+void test_template();
+
+#endif
@@ -0,0 +1,161 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cds/timer_wheel.h>
+#include "test_timer_wheel.h"
+
+#define REFERENCE_TIMERS 4000
+#define TICK 10
+
+// The reference: every timer armed, with the tick it must fire in.
+struct reference {
+  cds_timer_id id;
+  uint64_t expires;
+  bool armed;
+};
+
+static struct reference timers[REFERENCE_TIMERS];
+static size_t timer_count;
+
+struct firing {
+  struct cds_timer_wheel *wheel;
+  uint64_t now, last_expires;
+  size_t fired;
+  bool rearm;
+};
+
+static uint64_t rand64() {
+  return (uint64_t) rand() << 40 ^ (uint64_t) rand() << 20 ^ (uint64_t) rand();
+}
+
+static void check_fired(const struct cds_timer *timer, void *context) {
+  struct firing *firing = context;
+  struct reference *reference = timer->data;
+  assert(reference->armed && reference->id == timer->id);
+  assert(reference->expires <= firing->now / TICK);
+  assert(timer->deadline <= firing->now && reference->expires >= firing->last_expires);
+  firing->last_expires = reference->expires;
+  reference->armed = false;
+  firing->fired++;
+  // Cancel another timer from inside the callback, and sometimes arm a new one already due.
+  struct reference *other = &timers[(size_t) rand() % timer_count];
+  if (other->armed && rand() % 4 == 0) {
+    assert(cds_timer_wheel_cancel(firing->wheel, other->id) == 0);
+    other->armed = false;
+  }
+  if (firing->rearm && timer_count < REFERENCE_TIMERS && rand() % 8 == 0) {
+    struct reference *new_timer = &timers[timer_count++];
+    new_timer->id = cds_timer_wheel_arm(firing->wheel, timer->deadline, new_timer);
+    new_timer->expires = firing->wheel->current + 1;
+    new_timer->armed = new_timer->id != CDS_TIMER_NONE;
+  }
+}
+
+static void check_unfired(uint64_t now) {
+  for (size_t i = 0; i < timer_count; i++) {
+    assert(!timers[i].armed || timers[i].expires > now / TICK);
+  }
+}
+
+static void arm_random(struct cds_timer_wheel *wheel, uint64_t now) {
+  struct reference *timer = &timers[timer_count++];
+  const int spread = rand() % 4;
+  const uint64_t delay = spread == 0 ? (uint64_t) rand() % 100 : spread == 1 ? (uint64_t) rand() % 100000 :
+                         spread == 2 ? rand64() % (UINT64_MAX - now) : 0;
+  const uint64_t deadline = now + delay - (spread == 3 ? (uint64_t) rand() % (now + 1) : 0);
+  timer->id = cds_timer_wheel_arm(wheel, deadline, timer);
+  assert(timer->id != CDS_TIMER_NONE);
+  const uint64_t expires = deadline / TICK + (deadline % TICK != 0);
+  timer->expires = expires > now / TICK ? expires : now / TICK + 1;
+  timer->armed = true;
+}
+
+void test_timer_wheel() {
+  struct cds_timer_wheel invalid = cds_timer_wheel_new(0, 0);
+  assert(invalid.nodes.data == NULL);
+  struct cds_array none = cds_array_new(sizeof(struct cds_timer));
+  assert(cds_timer_wheel_arm(&invalid, 10, NULL) == CDS_TIMER_NONE);
+  assert(cds_timer_wheel_cancel(&invalid, 0) == -1);
+  assert(cds_timer_wheel_advance(&invalid, 100, NULL, NULL) == 0);
+  assert(cds_timer_wheel_advance_into(&invalid, 100, &none) == -1 && cds_array_empty(&none));
+  assert(cds_timer_wheel_size(&invalid) == 0 && cds_timer_wheel_empty(&invalid));
+  cds_timer_wheel_delete(&invalid);
+  cds_array_delete(&none);
+
+  const uint64_t start = 1000003;
+  struct cds_timer_wheel wheel = cds_timer_wheel_new(TICK, start);
+  assert(wheel.nodes.data != NULL && cds_timer_wheel_empty(&wheel));
+  assert(cds_timer_wheel_cancel(&wheel, 0) == -1 && cds_timer_wheel_cancel(&wheel, CDS_TIMER_NONE) == -1);
+
+  // Random arms, cancels and advances by small steps and by large jumps, against the reference.
+  srand(23);
+  uint64_t now = start;
+  size_t armed = 0;
+  struct firing firing = {.wheel = &wheel, .rearm = true};
+  while (timer_count < REFERENCE_TIMERS - 200) {
+    const int op = rand() % 10;
+    if (op < 5) {
+      arm_random(&wheel, now);
+    } else if (op < 7) {
+      struct reference *timer = &timers[(size_t) rand() % timer_count];
+      assert(cds_timer_wheel_cancel(&wheel, timer->id) == (timer->armed ? 0 : -1));
+      timer->armed = false;
+    } else {
+      const int jump = rand() % 10;
+      now += jump < 7 ? (uint64_t) rand() % 30 :
+             jump < 9 ? (uint64_t) rand() % 1000000 : rand64() % 10000000000ULL;
+      firing.now = now;
+      firing.last_expires = 0;
+      cds_timer_wheel_advance(&wheel, now, check_fired, &firing);
+      check_unfired(now);
+    }
+    armed = 0;
+    for (size_t i = 0; i < timer_count; i++) {
+      armed += timers[i].armed;
+    }
+    assert(cds_timer_wheel_size(&wheel) == armed);
+  }
+
+  // Expiry into an array, up to the end of time.
+  struct cds_array expired = cds_array_new(sizeof(struct cds_timer));
+  assert(cds_timer_wheel_advance_into(&wheel, UINT64_MAX, &expired) == 0);
+  assert(cds_array_size(&expired) == armed && cds_timer_wheel_empty(&wheel));
+  uint64_t last_expires = 0;
+  for (size_t i = 0; i < cds_array_size(&expired); i++) {
+    const struct cds_timer *timer = cds_array_at(&expired, i);
+    struct reference *reference = timer->data;
+    assert(reference->armed && reference->id == timer->id);
+    assert(reference->expires >= last_expires);
+    last_expires = reference->expires;
+    reference->armed = false;
+    // Ids of fired timers are stale, even once their nodes are reused.
+    assert(cds_timer_wheel_cancel(&wheel, timer->id) == -1);
+  }
+  cds_array_delete(&expired);
+  cds_timer_wheel_delete(&wheel);
+
+  // Timers in the same tick, including one re-armed from the callback for a time already passed.
+  timer_count = 0;
+  wheel = cds_timer_wheel_new(TICK, 0);
+  for (int i = 0; i < 100; i++) {
+    struct reference *timer = &timers[timer_count++];
+    timer->id = cds_timer_wheel_arm(&wheel, 95, timer);
+    timer->expires = 10;
+    timer->armed = true;
+  }
+  firing = (struct firing) {.wheel = &wheel, .now = 99, .rearm = true};
+  assert(cds_timer_wheel_advance(&wheel, 99, check_fired, &firing) == 0);
+  firing.now = 100;
+  assert(cds_timer_wheel_advance(&wheel, 100, check_fired, &firing) == firing.fired && firing.fired > 0);
+  check_unfired(100);
+  assert(timer_count > 100 && cds_timer_wheel_size(&wheel) > 0);
+  firing.now = 110;
+  firing.fired = 0;
+  assert(cds_timer_wheel_advance(&wheel, 110, check_fired, &firing) == firing.fired && firing.fired > 0);
+  check_unfired(110);
+  cds_timer_wheel_delete(&wheel);
+  printf("Timer Wheel Passed\n");
+}
@@ -0,0 +1,6 @@
+#ifndef CDS_TEST_TIMER_WHEEL_H
+#define CDS_TEST_TIMER_WHEEL_H
+
+void test_timer_wheel();
+
+#endif